@@ -11,6 +11,7 @@
 #include "llvh/Support/MathExtras.h"
 
 #include <array>
+#include <atomic>
 #include <bitset>
 
 #pragma GCC diagnostic push
@@ -142,6 +143,20 @@ class BitArray {
       allBits_[wordIdx] &= ~mask;
   }
 
+  /// Set the bit at \p idx to 1 with an atomic read-modify-write, so that
+  /// concurrent calls on bits sharing a word are not lost.
+  /// \return true if the bit was previously 0.
+  inline bool setAtomic(size_t idx) {
+    static_assert(
+        sizeof(std::atomic<uintptr_t>) == sizeof(uintptr_t) &&
+            std::atomic<uintptr_t>::is_always_lock_free,
+        "Words must be usable as atomics");
+    const uintptr_t mask = 1ULL << (idx % kBitsPerWord);
+    const size_t wordIdx = idx / kBitsPerWord;
+    auto *word = reinterpret_cast<std::atomic<uintptr_t> *>(&allBits_[wordIdx]);
+    return !(word->fetch_or(mask, std::memory_order_relaxed) & mask);
+  }
+
   /// Set all bits to 0.
   inline void reset() {
     std::fill_n(allBits_.begin(), kNumWords, 0);
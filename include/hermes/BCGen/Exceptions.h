@@ -84,11 +84,18 @@ llvh::Optional<llvh::SmallPtrSet<BasicBlock *, 4>> constructCatchMap(
     uint32_t maxRecursionDepth);
 
 /// Note: Returns an empty list if generation fails due to excessive recursion.
+/// The returned entries are flattened (see flattenExceptionHandlers).
 ExceptionEntryList generateExceptionHandlers(
     CatchInfoMap &catchInfoMap,
     BasicBlockInfoMap &bbMap,
     Function *F);
 
+/// Convert \p entries, sorted by decreasing depth so that inner handlers
+/// precede the handlers enclosing them, into a list of disjoint ranges sorted
+/// by start offset, each mapping to the innermost handler covering it.
+/// This allows handler lookup by binary search at runtime.
+ExceptionEntryList flattenExceptionHandlers(const ExceptionEntryList &entries);
+
 } // namespace hermes
 
 #endif
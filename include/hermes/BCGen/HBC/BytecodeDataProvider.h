@@ -309,6 +309,8 @@ class BCProviderBase {
   /// Given the functionID and offset of the instruction where exception
   /// happened, \returns the offset of the exception handler to jump to.
   /// \returns -1 if a handler is not found.
+  /// The exception table is sorted by start offset with disjoint ranges, so
+  /// this is a binary search.
   int32_t findCatchTargetOffset(uint32_t functionID, uint32_t exceptionOffset)
       const;
 
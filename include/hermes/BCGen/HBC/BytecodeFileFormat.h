@@ -367,6 +367,9 @@ struct ExceptionHandlerTableHeader {
 
 /// We need HBCExceptionHandlerInfo other than using ExceptionHandlerInfo
 /// directly because we don't need depth in HBC.
+/// The entries of a function's exception table are sorted by start offset and
+/// cover disjoint ranges, each mapping to its innermost handler, so that the
+/// handler for an offset can be found by binary search.
 struct HBCExceptionHandlerInfo {
   uint32_t start;
   uint32_t end;
@@ -19,8 +19,8 @@ namespace hermes {
 namespace hbc {
 
 // Bytecode version generated by this version of the compiler.
-// Updated: Sep 19, 2022
-const static uint32_t BYTECODE_VERSION = 90;
+// Updated: Oct 19, 2026
+const static uint32_t BYTECODE_VERSION = 93;
 
 } // namespace hbc
 } // namespace hermes
@@ -89,6 +89,60 @@ static opt<double> OccupancyTarget(
     cat(GCCategory),
     init(GCConfig::getDefaultOccupancyTarget()));
 
+static opt<unsigned> GCYoungGenThreads(
+    "gc-yg-threads",
+    desc("Number of threads used to scan for old-to-young pointers in young "
+         "generation collections."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultYoungGenThreads()));
+
+static opt<unsigned> GCOldGenThreads(
+    "gc-og-threads",
+    desc("Number of threads used to mark and sweep the old generation in "
+         "concurrent collections."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultOldGenThreads()));
+
+static opt<bool> GCPretenure(
+    "gc-pretenure",
+    desc("Allocate array backing stores directly in the old generation while "
+         "most of them survive young generation collections."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultPretenure()));
+
+static opt<bool> GCHugePages(
+    "gc-huge-pages",
+    desc("Back heap segments with transparent huge pages."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultHugePages()));
+
+static opt<bool> GCNUMALocalSegments(
+    "gc-numa-local",
+    desc("Place heap segments on the NUMA node of the thread that creates "
+         "them."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultNUMALocalSegments()));
+
+static opt<unsigned> GCSegmentPoolSize(
+    "gc-segment-pool-size",
+    desc("Maximum number of free heap segments kept for reuse by other "
+         "runtimes in the process."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultSegmentPoolSize()));
+
+static opt<unsigned> GCYoungGenPauseTargetMs(
+    "gc-yg-pause-target-ms",
+    desc("Size the young generation so that its collections take about this "
+         "many milliseconds. 0 uses the default sizing."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultYoungGenPauseTargetMs()));
+
+static opt<bool> GCConcurrentFinalization(
+    "gc-concurrent-finalization",
+    desc("Release the native memory of dead objects on a background thread."),
+    cat(GCCategory),
+    init(GCConfig::getDefaultConcurrentFinalization()));
+
 static opt<bool> SampleProfiling(
     "sample-profiling",
     init(false),
@@ -144,6 +198,12 @@ static opt<bool> StableInstructionCount(
     desc("For CPU instructions debugging: fix random seed, silence logging"),
     cat(RuntimeCategory));
 
+static opt<uint32_t> ErrorStackTraceLimit(
+    "Xerror-stack-trace-limit",
+    desc("Maximum number of frames recorded in Error stack traces"),
+    init(RuntimeConfig::getDefaultErrorStackTraceLimit()),
+    cat(RuntimeCategory));
+
 static opt<uint32_t> VMExperimentFlags(
     "Xvm-experiment-flags",
     llvh::cl::desc("VM experiment flags."),
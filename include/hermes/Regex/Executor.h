@@ -35,6 +35,12 @@ constexpr uint32_t kNotMatched = UINT32_MAX;
 /// The maximum number of times we will backtrack.
 constexpr uint32_t kBacktrackLimit = 1u << 30;
 
+/// For regexes that the Pike VM can run, the number of times we will backtrack
+/// per code unit of input, plus kPikeFallbackMinBacktracks, before abandoning
+/// the backtracking executor for the Pike VM.
+constexpr uint32_t kPikeFallbackBacktracksPerUnit = 32;
+constexpr uint32_t kPikeFallbackMinBacktracks = 1024;
+
 /// A CapturedRange represents a range of the input string captured by a capture
 /// group. A CaptureGroup may also not have matched, in which case its start is
 /// set to kNotMatched. Note that an unmatched capture group is different than a
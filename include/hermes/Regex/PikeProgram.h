@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_REGEX_PIKEPROGRAM_H
+#define HERMES_REGEX_PIKEPROGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace hermes {
+namespace regex {
+
+/// The largest Pike VM program we will produce, in bytes. Counted loops are
+/// unrolled, so /a{1000}/ needs 1000 copies of its body.
+constexpr uint32_t kMaxPikeProgramSize = 1u << 14;
+
+/// The deepest nesting of loops we will unroll for the Pike VM.
+constexpr uint32_t kMaxPikeLoopDepth = 32;
+
+/// Given \p bytecode, a regex compiled for the backtracking executor, append a
+/// program for the Pike VM and record its offset in the header, if the regex
+/// can use it. That is the case if the regex has no backreferences or
+/// lookarounds, every loop that may execute a variable number of times has a
+/// body that can't match the empty string, and the regex may backtrack at all.
+///
+/// The Pike VM program is a bytecode stream with its own header, using the same
+/// instructions except for loops: counted loops are unrolled and every loop is
+/// expressed with Alternation and Jump32 instructions, so that the position in
+/// the program is all the state a thread needs besides its captures.
+void appendPikeProgram(std::vector<uint8_t> &bytecode);
+
+} // namespace regex
+} // namespace hermes
+
+#endif // HERMES_REGEX_PIKEPROGRAM_H
@@ -22,6 +22,7 @@
 #include "hermes/Support/Compiler.h"
 #include "hermes/Support/RegExpSupport.h"
 
+#include "hermes/Regex/PikeProgram.h"
 #include "hermes/Regex/RegexBytecode.h"
 #include "hermes/Regex/RegexNode.h"
 #include "hermes/Regex/RegexTypes.h"
@@ -146,9 +147,12 @@ class Regex {
         static_cast<uint16_t>(loopCount_),
         flags_.toByte(),
         matchConstraints_};
+    Node::computePrefilter(nodes_, &header);
     RegexBytecodeStream bcs(header);
     Node::compile(nodes_, bcs);
-    return bcs.acquireBytecode();
+    std::vector<uint8_t> bytecode = bcs.acquireBytecode();
+    appendPikeProgram(bytecode);
+    return bytecode;
   }
 
   // Constructors
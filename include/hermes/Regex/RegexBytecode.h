@@ -8,6 +8,7 @@
 #ifndef HERMES_REGEX_REGEXBYTECODE_H
 #define HERMES_REGEX_REGEXBYTECODE_H
 
+#include "llvh/ADT/ArrayRef.h"
 #include "llvh/ADT/DenseMap.h"
 #include "llvh/Support/Casting.h"
 
@@ -260,6 +261,39 @@ struct Width1LoopInsn : public Insn {
   JumpTarget32 notTakenTarget;
 };
 
+/// How the prefilter units in the bytecode header are used to skip start
+/// positions that cannot match.
+enum class PrefilterKind : uint8_t {
+  /// There is no prefilter.
+  None,
+
+  /// Every match starts with the prefilter units.
+  LiteralPrefix,
+
+  /// Every match starts with one of the prefilter units.
+  FirstUnits,
+
+  /// Every match contains the prefilter units, but not necessarily at its
+  /// start.
+  RequiredSubstring,
+};
+
+/// The maximum number of code units stored in a prefilter.
+constexpr uint8_t kMaxPrefilterLength = 16;
+
+/// The maximum number of distinct first code units stored in a FirstUnits
+/// prefilter.
+constexpr uint8_t kMaxPrefilterFirstUnits = 4;
+
+/// An instruction that resets a range of capture groups to unmatched, used by
+/// the Pike VM at the start of every loop iteration. The backtracking executor
+/// restores capture groups as part of BeginLoopInsn instead.
+struct ClearCapturesInsn : public Insn {
+  /// Range of marked subexpressions to clear, as [begin, end).
+  uint16_t mexpBegin;
+  uint16_t mexpEnd;
+};
+
 /// A header that appears at the beginning of a bytecode stream.
 struct RegexBytecodeHeader {
   /// Number of capture groups.
@@ -273,6 +307,21 @@ struct RegexBytecodeHeader {
 
   /// Constraints on what strings can match this regex.
   MatchConstraintSet constraints;
+
+  /// The kind of prefilter, a PrefilterKind.
+  uint8_t prefilterKind;
+
+  /// Number of code units in prefilter.
+  uint8_t prefilterLength;
+
+  /// Code units used to find the positions at which a match may start, as
+  /// described by prefilterKind.
+  char16_t prefilter[kMaxPrefilterLength];
+
+  /// Offset from the start of the bytecode of a second bytecode stream, with
+  /// its own header, for the Pike VM. 0 if the regex must be run by the
+  /// backtracking executor.
+  uint32_t pikeProgramOffset;
 };
 
 LLVM_PACKED_END;
@@ -338,6 +387,17 @@ class RegexBytecodeStream {
     bytes_.push_back((uint8_t)c);
   }
 
+  /// Emit a copy of the instruction \p insn from another stream, including any
+  /// data following it.
+  void emitCopy(llvh::ArrayRef<uint8_t> insn) {
+    bytes_.insert(bytes_.end(), insn.begin(), insn.end());
+  }
+
+  /// \return the size of the stream including the header.
+  size_t size() const {
+    return bytes_.size();
+  }
+
   /// \return the current offset in the stream, which is where the next
   /// instruction will be emitted. Note the header is omitted.
   uint32_t currentOffset() const {
@@ -55,6 +55,21 @@ class Node {
 
   using CodePoint = uint32_t;
   using CodePointList = llvh::SmallVector<CodePoint, 5>;
+  using CodeUnitList = llvh::SmallVector<char16_t, kMaxPrefilterLength>;
+
+  /// How a node constrains the first code unit of its matches.
+  enum class FirstUnits : uint8_t {
+    /// The node never consumes anything, so the following nodes constrain the
+    /// first code unit.
+    Transparent,
+
+    /// Every match of the node starts with one of the code units that were
+    /// added.
+    Added,
+
+    /// The first code unit is not known.
+    Unknown,
+  };
 
   /// Default constructor and destructor.
   Node() = default;
@@ -82,6 +97,39 @@ class Node {
     return result;
   }
 
+  /// Append to \p output the code units that every match of the list of nodes
+  /// \p nodes starts with, stopping at kMaxPrefilterLength units. \return true
+  /// if the list matches exactly those code units.
+  static bool literalPrefixForList(
+      llvh::ArrayRef<Node *> nodes,
+      CodeUnitList *output) {
+    for (const auto &node : nodes) {
+      if (!node->appendLiteralPrefix(output) ||
+          output->size() >= kMaxPrefilterLength)
+        return false;
+    }
+    return true;
+  }
+
+  /// Add to \p output the code units that a match of the list of nodes \p
+  /// nodes may start with. \return how they constrain the matches.
+  static FirstUnits firstUnitsForList(
+      const NodeList &nodes,
+      CodeUnitList *output) {
+    for (const auto &node : nodes) {
+      FirstUnits result = node->addFirstUnits(output);
+      if (result != FirstUnits::Transparent)
+        return result;
+    }
+    return FirstUnits::Transparent;
+  }
+
+  /// Compute the prefilter for the regex with the list of nodes \p nodes and
+  /// store it in \p header.
+  inline static void computePrefilter(
+      const NodeList &nodes,
+      RegexBytecodeHeader *header);
+
   /// Reverse the order of the node list \p nodes, and recursively ask each node
   /// to reverse the order of its children.
   inline static void reverseNodeList(NodeList &nodes);
@@ -103,6 +151,20 @@ class Node {
     return false;
   }
 
+  /// Append to \p output the code units that every match of this node starts
+  /// with. \return true if the node matches exactly those code units, so that
+  /// the prefix continues with the following node. Node itself matches the
+  /// empty string, as do assertions that don't override this.
+  virtual bool appendLiteralPrefix(CodeUnitList *output) const {
+    return true;
+  }
+
+  /// Add to \p output the code units that a match of this node may start with.
+  /// \return how they constrain the matches.
+  virtual FirstUnits addFirstUnits(CodeUnitList *output) const {
+    return FirstUnits::Transparent;
+  }
+
  protected:
   /// \return the match constraints for this node.
   /// This should be overridden by subclasses to report the constraints for that
@@ -116,6 +178,12 @@ class Node {
     return false;
   }
 
+  /// \return whether the code point \p cp can be used in a prefilter, which
+  /// holds single code units that are not surrogates.
+  static bool isPrefilterUnit(CodePoint cp) {
+    return isMemberOfBMP(cp) && !isHighSurrogate(cp) && !isLowSurrogate(cp);
+  }
+
   /// \return pointers to the NodeLists contained in this node.
   virtual llvh::SmallVector<NodeList *, 1> getChildren() {
     return {};
@@ -152,6 +220,14 @@ class GoalNode final : public Node {
   bool isGoal() const override {
     return true;
   }
+
+  bool appendLiteralPrefix(CodeUnitList *output) const override {
+    return false;
+  }
+
+  FirstUnits addFirstUnits(CodeUnitList *output) const override {
+    return FirstUnits::Unknown;
+  }
 };
 
 class LoopNode final : public Node {
@@ -226,6 +302,19 @@ class LoopNode final : public Node {
     return {&loopee_};
   }
 
+  /// A loop that executes at least once starts like its loopee.
+  bool appendLiteralPrefix(CodeUnitList *output) const override {
+    if (min_ > 0)
+      literalPrefixForList(loopee_, output);
+    return false;
+  }
+
+  FirstUnits addFirstUnits(CodeUnitList *output) const override {
+    if (min_ == 0)
+      return FirstUnits::Unknown;
+    return firstUnitsForList(loopee_, output);
+  }
+
  protected:
   void reverseChildren() override {
     reverseNodeList(loopee_);
@@ -353,6 +442,19 @@ class AlternationNode final : public Node {
     return restConstraints_.front() | Super::matchConstraints();
   }
 
+  bool appendLiteralPrefix(CodeUnitList *output) const override {
+    return false;
+  }
+
+  /// A match starts with the first unit of one of the alternatives.
+  FirstUnits addFirstUnits(CodeUnitList *output) const override {
+    for (const NodeList &alternative : alternatives_) {
+      if (firstUnitsForList(alternative, output) != FirstUnits::Added)
+        return FirstUnits::Unknown;
+    }
+    return FirstUnits::Added;
+  }
+
   virtual llvh::SmallVector<NodeList *, 1> getChildren() override {
     llvh::SmallVector<NodeList *, 1> ret;
     ret.reserve(alternatives_.size());
@@ -448,6 +550,14 @@ class MarkedSubexpressionNode final : public Node {
     return contentsConstraints_ | Super::matchConstraints();
   }
 
+  bool appendLiteralPrefix(CodeUnitList *output) const override {
+    return literalPrefixForList(contents_, output);
+  }
+
+  FirstUnits addFirstUnits(CodeUnitList *output) const override {
+    return firstUnitsForList(contents_, output);
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (!emitEnd_) {
@@ -473,6 +583,14 @@ class BackRefNode final : public Node {
     mexp_ = mexp;
   }
 
+  bool appendLiteralPrefix(CodeUnitList *output) const override {
+    return false;
+  }
+
+  FirstUnits addFirstUnits(CodeUnitList *output) const override {
+    return FirstUnits::Unknown;
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     bcs.emit<BackRefInsn>()->mexp = mexp_;
@@ -561,6 +679,14 @@ class MatchAnyNode final : public Node {
     return !unicode_;
   }
 
+  bool appendLiteralPrefix(CodeUnitList *output) const override {
+    return false;
+  }
+
+  FirstUnits addFirstUnits(CodeUnitList *output) const override {
+    return FirstUnits::Unknown;
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (unicode_) {
@@ -626,6 +752,38 @@ class MatchCharNode final : public Node {
     return true;
   }
 
+  bool appendLiteralPrefix(CodeUnitList *output) const override {
+    if (icase_)
+      return false;
+    for (CodePoint c : chars_) {
+      if (!isPrefilterUnit(c))
+        return false;
+      output->push_back(c);
+    }
+    return true;
+  }
+
+  FirstUnits addFirstUnits(CodeUnitList *output) const override {
+    if (chars_.empty())
+      return FirstUnits::Transparent;
+    CodePoint c = chars_.front();
+    if (!isPrefilterUnit(c))
+      return FirstUnits::Unknown;
+    if (icase_) {
+      // Without the unicode flag, only ASCII characters canonicalize to ASCII
+      // characters, so an ASCII letter matches exactly its two cases. With
+      // it, some non-ASCII characters fold to ASCII letters.
+      if (unicode_ || !isASCII(c))
+        return FirstUnits::Unknown;
+      if ('a' <= (c | 0x20) && (c | 0x20) <= 'z') {
+        output->push_back(c | 0x20);
+        c &= ~0x20;
+      }
+    }
+    output->push_back(c);
+    return FirstUnits::Added;
+  }
+
   /// \return whether matching the code point \p cp may require
   /// decoding a surrogate pair from the input string.
   bool mayRequireDecodingSurrogatePair(uint32_t cp) const {
@@ -843,6 +1001,33 @@ class BracketNode : public Node {
     return !unicode_;
   }
 
+  bool appendLiteralPrefix(CodeUnitList *output) const override {
+    // A bracket containing a single character matches it literally.
+    CodeUnitList units;
+    if (addFirstUnits(&units) == FirstUnits::Added && units.size() == 1) {
+      output->push_back(units.front());
+      return true;
+    }
+    return false;
+  }
+
+  FirstUnits addFirstUnits(CodeUnitList *output) const override {
+    if (negate_ || icase_ || !classes_.empty())
+      return FirstUnits::Unknown;
+    for (const CodePointRange &range : codePointSet_.ranges()) {
+      if (range.length > kMaxPrefilterFirstUnits)
+        return FirstUnits::Unknown;
+      for (CodePoint c = range.first; c < range.end(); ++c) {
+        if (!isPrefilterUnit(c))
+          return FirstUnits::Unknown;
+        output->push_back(c);
+      }
+      if (output->size() > kMaxPrefilterFirstUnits)
+        return FirstUnits::Unknown;
+    }
+    return FirstUnits::Added;
+  }
+
  private:
   virtual NodeList *emitStep(RegexBytecodeStream &bcs) override {
     if (unicode_) {
@@ -1000,6 +1185,52 @@ void Node::optimizeNodeList(
   }
 }
 
+void Node::computePrefilter(
+    const NodeList &nodes,
+    RegexBytecodeHeader *header) {
+  auto setPrefilter = [header](
+                          PrefilterKind kind, llvh::ArrayRef<char16_t> units) {
+    assert(!units.empty() && "Prefilter should not be empty");
+    size_t length = std::min(units.size(), (size_t)kMaxPrefilterLength);
+    header->prefilterKind = static_cast<uint8_t>(kind);
+    header->prefilterLength = static_cast<uint8_t>(length);
+    std::copy_n(units.begin(), length, header->prefilter);
+  };
+
+  // A literal prefix rules out the most start positions.
+  CodeUnitList units;
+  literalPrefixForList(nodes, &units);
+  if (!units.empty()) {
+    setPrefilter(PrefilterKind::LiteralPrefix, units);
+    return;
+  }
+
+  // Otherwise use the set of units that a match may start with, if it is
+  // small.
+  if (firstUnitsForList(nodes, &units) == FirstUnits::Added) {
+    std::sort(units.begin(), units.end());
+    units.erase(std::unique(units.begin(), units.end()), units.end());
+    if (!units.empty() && units.size() <= kMaxPrefilterFirstUnits) {
+      setPrefilter(PrefilterKind::FirstUnits, units);
+      return;
+    }
+  }
+
+  // Otherwise use the longest literal that every match contains. The nodes are
+  // matched in sequence, so every match contains the literal prefix of every
+  // suffix of the list.
+  CodeUnitList longest;
+  for (llvh::ArrayRef<Node *> rest = nodes; !rest.empty();
+       rest = rest.drop_front()) {
+    units.clear();
+    literalPrefixForList(rest, &units);
+    if (units.size() > longest.size())
+      longest = units;
+  }
+  if (!longest.empty())
+    setPrefilter(PrefilterKind::RequiredSubstring, longest);
+}
+
 } // namespace regex
 } // namespace hermes
 #endif // HERMES_REGEX_NODE_H
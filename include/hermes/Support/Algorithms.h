@@ -14,9 +14,12 @@
 #define HERMES_SUPPORT_ALGORITHMS_H
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace hermes {
 
@@ -42,6 +45,328 @@ ForwardIt uninitializedCopyN(InputIt src, Size count, ForwardIt dst) {
   return std::uninitialized_copy_n(src, count, dst);
 }
 
+namespace pdq {
+
+/// Ranges shorter than this are sorted with an insertion sort.
+constexpr std::ptrdiff_t kInsertionSortThreshold = 24;
+
+/// Ranges longer than this pick their pivot with Tukey's ninther.
+constexpr std::ptrdiff_t kNintherThreshold = 128;
+
+/// Maximum number of moves a partial insertion sort may do before giving up.
+constexpr std::size_t kPartialInsertionSortLimit = 8;
+
+/// Number of elements classified at a time by the branchless partition.
+constexpr std::size_t kBlockSize = 64;
+
+/// Sort [begin, end). If \p Guarded is false, *(begin - 1) must not be
+/// greater than any element of the range, and is used as a sentinel.
+template <bool Guarded, class Iter, class Compare>
+void insertionSort(Iter begin, Iter end, Compare comp) {
+  using T = typename std::iterator_traits<Iter>::value_type;
+  if (begin == end)
+    return;
+  for (Iter cur = begin + 1; cur != end; ++cur) {
+    Iter sift = cur;
+    Iter siftPrev = cur - 1;
+    if (comp(*sift, *siftPrev)) {
+      T tmp = std::move(*sift);
+      do {
+        *sift-- = std::move(*siftPrev);
+      } while ((!Guarded || sift != begin) && comp(tmp, *--siftPrev));
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+/// Insertion sort [begin, end), giving up if that takes too many moves.
+/// \return true if the range was sorted.
+template <class Iter, class Compare>
+bool partialInsertionSort(Iter begin, Iter end, Compare comp) {
+  using T = typename std::iterator_traits<Iter>::value_type;
+  if (begin == end)
+    return true;
+  std::size_t moves = 0;
+  for (Iter cur = begin + 1; cur != end; ++cur) {
+    Iter sift = cur;
+    Iter siftPrev = cur - 1;
+    if (comp(*sift, *siftPrev)) {
+      T tmp = std::move(*sift);
+      do {
+        *sift-- = std::move(*siftPrev);
+      } while (sift != begin && comp(tmp, *--siftPrev));
+      *sift = std::move(tmp);
+      moves += cur - sift;
+    }
+    if (moves > kPartialInsertionSortLimit)
+      return false;
+  }
+  return true;
+}
+
+/// Sort the elements at \p a, \p b and \p c.
+template <class Iter, class Compare>
+void sort3(Iter a, Iter b, Iter c, Compare comp) {
+  if (comp(*b, *a))
+    std::iter_swap(a, b);
+  if (comp(*c, *b))
+    std::iter_swap(b, c);
+  if (comp(*b, *a))
+    std::iter_swap(a, b);
+}
+
+/// Partition [begin, end) around the pivot *begin, putting the elements equal
+/// to the pivot to its right. \return the position of the pivot, and whether
+/// the range was already partitioned. If \p Branchless, the elements are
+/// classified in blocks without branching on the comparison, in the manner
+/// of BlockQuicksort, which is much faster for cheap comparisons of values
+/// in random order.
+template <bool Branchless, class Iter, class Compare>
+std::pair<Iter, bool> partitionRight(Iter begin, Iter end, Compare comp) {
+  using T = typename std::iterator_traits<Iter>::value_type;
+  T pivot(std::move(*begin));
+  Iter first = begin;
+  Iter last = end;
+
+  // Find the first element not less than the pivot, and the last element
+  // less than the pivot. The median-of-3 guarantees there is such an element
+  // on the right; there may be none on the left.
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+
+  bool alreadyPartitioned = first >= last;
+  if (!Branchless) {
+    while (first < last) {
+      std::iter_swap(first, last);
+      while (comp(*++first, pivot)) {
+      }
+      while (!comp(*--last, pivot)) {
+      }
+    }
+  } else if (!alreadyPartitioned) {
+    std::iter_swap(first, last);
+    ++first;
+
+    // Offsets of the misplaced elements in the current left block, from
+    // leftBase, and in the current right block, back from rightBase.
+    alignas(64) unsigned char offsetsL[kBlockSize];
+    alignas(64) unsigned char offsetsR[kBlockSize];
+    Iter leftBase = first;
+    Iter rightBase = last;
+    std::size_t numL = 0, numR = 0, startL = 0, startR = 0;
+    while (first < last) {
+      // Fill the blocks that are empty, splitting what is left if needed.
+      std::size_t numUnknown = last - first;
+      std::size_t leftSplit =
+          numL == 0 ? (numR == 0 ? numUnknown / 2 : numUnknown) : 0;
+      std::size_t rightSplit = numR == 0 ? (numUnknown - leftSplit) : 0;
+      leftSplit = std::min(leftSplit, kBlockSize);
+      rightSplit = std::min(rightSplit, kBlockSize);
+      for (std::size_t i = 0; i < leftSplit; ++i) {
+        offsetsL[numL] = i;
+        numL += !comp(*first, pivot);
+        ++first;
+      }
+      for (std::size_t i = 0; i < rightSplit;) {
+        offsetsR[numR] = ++i;
+        numR += comp(*--last, pivot);
+      }
+
+      // Swap as many misplaced elements as possible.
+      std::size_t num = std::min(numL, numR);
+      for (std::size_t i = 0; i < num; ++i) {
+        std::iter_swap(
+            leftBase + offsetsL[startL + i], rightBase - offsetsR[startR + i]);
+      }
+      numL -= num;
+      numR -= num;
+      startL += num;
+      startR += num;
+      if (numL == 0) {
+        startL = 0;
+        leftBase = first;
+      }
+      if (numR == 0) {
+        startR = 0;
+        rightBase = last;
+      }
+    }
+
+    // Move the misplaced elements left in a block to the boundary.
+    if (numL) {
+      while (numL--)
+        std::iter_swap(leftBase + offsetsL[startL + numL], --last);
+      first = last;
+    }
+    if (numR) {
+      while (numR--) {
+        std::iter_swap(rightBase - offsetsR[startR + numR], first);
+        ++first;
+      }
+    }
+  }
+
+  Iter pivotPos = first - 1;
+  *begin = std::move(*pivotPos);
+  *pivotPos = std::move(pivot);
+  return {pivotPos, alreadyPartitioned};
+}
+
+/// Partition [begin, end) around the pivot *begin, putting the elements equal
+/// to the pivot to its left. Used when there are many equal elements, since
+/// the left partition then needs no more sorting. \return the position of the
+/// pivot.
+template <class Iter, class Compare>
+Iter partitionLeft(Iter begin, Iter end, Compare comp) {
+  using T = typename std::iterator_traits<Iter>::value_type;
+  T pivot(std::move(*begin));
+  Iter first = begin;
+  Iter last = end;
+
+  while (comp(pivot, *--last)) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !comp(pivot, *++first)) {
+    }
+  } else {
+    while (!comp(pivot, *++first)) {
+    }
+  }
+
+  while (first < last) {
+    std::iter_swap(first, last);
+    while (comp(pivot, *--last)) {
+    }
+    while (!comp(pivot, *++first)) {
+    }
+  }
+
+  Iter pivotPos = last;
+  *begin = std::move(*pivotPos);
+  *pivotPos = std::move(pivot);
+  return pivotPos;
+}
+
+/// Sort [begin, end), allowing \p badAllowed highly unbalanced partitions
+/// before switching to a heap sort. If \p leftmost is false, *(begin - 1) is
+/// not greater than any element of the range.
+template <bool Branchless, class Iter, class Compare>
+void sortLoop(
+    Iter begin,
+    Iter end,
+    Compare comp,
+    unsigned badAllowed,
+    bool leftmost) {
+  using Diff = typename std::iterator_traits<Iter>::difference_type;
+  for (;;) {
+    Diff size = end - begin;
+    if (size < kInsertionSortThreshold) {
+      if (leftmost)
+        insertionSort<true>(begin, end, comp);
+      else
+        insertionSort<false>(begin, end, comp);
+      return;
+    }
+
+    // Pick the pivot and move it to *begin.
+    Diff s2 = size / 2;
+    if (size > kNintherThreshold) {
+      sort3(begin, begin + s2, end - 1, comp);
+      sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+      sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+      sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+      std::iter_swap(begin, begin + s2);
+    } else {
+      sort3(begin + s2, begin, end - 1, comp);
+    }
+
+    // If the pivot is equal to the element before the range, which is not
+    // greater than any element in it, then the elements equal to the pivot
+    // are its smallest elements. Put them on the left and skip them.
+    if (!leftmost && !comp(*(begin - 1), *begin)) {
+      begin = partitionLeft(begin, end, comp) + 1;
+      continue;
+    }
+
+    auto partResult = partitionRight<Branchless>(begin, end, comp);
+    Iter pivotPos = partResult.first;
+    Diff lSize = pivotPos - begin;
+    Diff rSize = end - (pivotPos + 1);
+
+    if (lSize < size / 8 || rSize < size / 8) {
+      // A highly unbalanced partition. Give up on quicksort if that happens
+      // too often, otherwise shuffle some elements to break the pattern.
+      if (--badAllowed == 0) {
+        std::make_heap(begin, end, comp);
+        std::sort_heap(begin, end, comp);
+        return;
+      }
+      if (lSize >= kInsertionSortThreshold) {
+        std::iter_swap(begin, begin + lSize / 4);
+        std::iter_swap(pivotPos - 1, pivotPos - lSize / 4);
+        if (lSize > kNintherThreshold) {
+          std::iter_swap(begin + 1, begin + (lSize / 4 + 1));
+          std::iter_swap(begin + 2, begin + (lSize / 4 + 2));
+          std::iter_swap(pivotPos - 2, pivotPos - (lSize / 4 + 1));
+          std::iter_swap(pivotPos - 3, pivotPos - (lSize / 4 + 2));
+        }
+      }
+      if (rSize >= kInsertionSortThreshold) {
+        std::iter_swap(pivotPos + 1, pivotPos + (1 + rSize / 4));
+        std::iter_swap(end - 1, end - rSize / 4);
+        if (rSize > kNintherThreshold) {
+          std::iter_swap(pivotPos + 2, pivotPos + (2 + rSize / 4));
+          std::iter_swap(pivotPos + 3, pivotPos + (3 + rSize / 4));
+          std::iter_swap(end - 2, end - (1 + rSize / 4));
+          std::iter_swap(end - 3, end - (2 + rSize / 4));
+        }
+      }
+    } else if (
+        partResult.second && partialInsertionSort(begin, pivotPos, comp) &&
+        partialInsertionSort(pivotPos + 1, end, comp)) {
+      // A balanced partition that moved nothing suggests the range is already
+      // nearly sorted, and it was.
+      return;
+    }
+
+    // Recurse into the left partition and loop on the right one.
+    sortLoop<Branchless>(begin, pivotPos, comp, badAllowed, leftmost);
+    begin = pivotPos + 1;
+    leftmost = false;
+  }
+}
+
+} // namespace pdq
+
+/// Sort [begin, end) with pattern-defeating quicksort (Orson Peters, 2021).
+/// Like std::sort it is an unstable introsort, but it is linear on sorted,
+/// reversed and all-equal inputs, and for arithmetic types it partitions
+/// without branch mispredictions.
+template <class Iter, class Compare>
+void pdqSort(Iter begin, Iter end, Compare comp) {
+  using T = typename std::iterator_traits<Iter>::value_type;
+  auto size = end - begin;
+  if (size < 2)
+    return;
+  unsigned log2 = 0;
+  while (size >>= 1)
+    ++log2;
+  pdq::sortLoop<std::is_arithmetic<T>::value>(begin, end, comp, log2, true);
+}
+
+template <class Iter>
+void pdqSort(Iter begin, Iter end) {
+  using T = typename std::iterator_traits<Iter>::value_type;
+  pdqSort(begin, end, std::less<T>());
+}
+
 } // namespace hermes
 
 #endif // HERMES_SUPPORT_ALGORITHMS_H
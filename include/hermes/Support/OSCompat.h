@@ -107,6 +107,15 @@ void vm_uncommit(void *p, size_t sz);
 /// \pre sz must be a multiple of oscompat::page_size().
 void vm_hugepage(void *p, size_t sz);
 
+/// Ask the OS to place the pages of the \p sz byte region of memory starting
+/// at \p p on the NUMA node of the CPU the calling thread is running on. The
+/// policy is a preference, so the pages may still be placed elsewhere if that
+/// node runs out of memory. Must be called before the pages are touched.
+/// \pre sz must be a multiple of oscompat::page_size().
+/// \return true if the policy was applied, false if it is unsupported or
+///   failed.
+bool vm_bind_to_local_node(void *p, size_t sz);
+
 /// Mark the \p sz byte region of memory starting at \p p as not currently in
 /// use, so that the OS may free it. \p p must be page-aligned.
 void vm_unused(void *p, size_t sz);
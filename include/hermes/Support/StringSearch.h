@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_SUPPORT_STRINGSEARCH_H
+#define HERMES_SUPPORT_STRINGSEARCH_H
+
+#include "hermes/Support/OptValue.h"
+
+#include "llvh/ADT/ArrayRef.h"
+
+#include <cstdint>
+
+namespace hermes {
+
+/// Substring search over strings of ASCII (char) or UTF-16 (char16_t) code
+/// units, in any combination of haystack and needle types. Code units are
+/// compared by value, so a char matches the char16_t with the same value.
+///
+/// Single units are found with memchr or SIMD compares. Short needles use a
+/// SIMD filter on their first and last units before comparing the rest, and
+/// long needles use Boyer-Moore-Horspool.
+
+/// \return the index of the first occurrence of \p needle in \p haystack, or
+/// None if there is none. An empty needle matches at index 0.
+template <typename H, typename N>
+OptValue<uint32_t> findSubstring(
+    llvh::ArrayRef<H> haystack,
+    llvh::ArrayRef<N> needle);
+
+/// \return the index of the last occurrence of \p needle in \p haystack, or
+/// None if there is none. An empty needle matches at the end of \p haystack.
+template <typename H, typename N>
+OptValue<uint32_t> findLastSubstring(
+    llvh::ArrayRef<H> haystack,
+    llvh::ArrayRef<N> needle);
+
+/// \return the index of the first unit in \p haystack that is equal to any of
+/// the units in \p units, or None if there is none. Up to four units are
+/// compared with SIMD.
+template <typename H>
+OptValue<uint32_t> findFirstOf(
+    llvh::ArrayRef<H> haystack,
+    llvh::ArrayRef<char16_t> units);
+
+/// Needles of at least this many units are searched for with
+/// Boyer-Moore-Horspool in haystacks of at least
+/// HORSPOOL_MIN_HAYSTACK_LENGTH units.
+static constexpr uint32_t HORSPOOL_MIN_NEEDLE_LENGTH = 32;
+static constexpr uint32_t HORSPOOL_MIN_HAYSTACK_LENGTH = 1024;
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_STRINGSEARCH_H
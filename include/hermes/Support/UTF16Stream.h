@@ -60,6 +60,22 @@ class UTF16Stream {
     return *this;
   }
 
+  /// \return the units from the current position that are available without
+  /// converting more input. This lets callers scan the stream in bulk.
+  /// The result is empty if hasChar has not been called since the buffered
+  /// units were consumed.
+  llvh::ArrayRef<char16_t> getBuffered() const {
+    return {cur_, end_};
+  }
+
+  /// Advances the stream by \p n units.
+  /// \pre \p n is at most the size of getBuffered().
+  UTF16Stream &operator+=(size_t n) {
+    assert(n <= (size_t)(end_ - cur_) && "advancing past the buffered units");
+    cur_ += n;
+    return *this;
+  }
+
   /// Begin capturing the stream of values. Once the capture is completed with a
   /// call to endCapture(), the captured stream can be viewed via an ArrayRef.
   void beginCapture();
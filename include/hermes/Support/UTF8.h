@@ -58,6 +58,31 @@ inline bool isAllASCII(const char *start, const char *end) {
   return isAllASCII((const uint8_t *)start, (const uint8_t *)end);
 }
 
+/// Overload for UTF-16 code units.
+bool isAllASCII(const char16_t *start, const char16_t *end);
+
+/// \return a pointer to the first ASCII letter in [start, end) that is
+/// lowercase if \p upper is true, or uppercase otherwise, or \p end if there is
+/// none. In other words, the first character changed by converting the string
+/// to upper or lower case.
+/// \pre the range is ASCII.
+const char *findASCIICaseChange(const char *start, const char *end, bool upper);
+
+/// Copy the ASCII characters in [start, end) to \p out, converting letters to
+/// upper case if \p upper is true, or to lower case otherwise.
+void convertASCIICase(const char *start, const char *end, char *out, bool upper);
+
+/// \return a pointer to the first character in [start, end) that is not an
+/// ASCII whitespace or line terminator character as defined by ECMAScript
+/// (tab, line feed, vertical tab, form feed, carriage return and space), or
+/// \p end if there is none.
+const char *skipASCIIWhiteSpace(const char *start, const char *end);
+
+/// \return a pointer past the last character in [start, end) that is not an
+/// ASCII whitespace or line terminator character, or \p start if there is
+/// none.
+const char *skipASCIIWhiteSpaceBackward(const char *start, const char *end);
+
 /// Decode a sequence of UTF8 encoded bytes when it is known that the first byte
 /// is a start of an UTF8 sequence.
 /// \tparam allowSurrogates when false, values in the surrogate range are
@@ -176,6 +176,11 @@ class AlignedHeapSegment {
   /// Mark the given \p cell.  Assumes the given address is a valid heap object.
   inline static void setCellMarkBit(const GCCell *cell);
 
+  /// Same as \c setCellMarkBit, but may be called by several threads at once.
+  /// \return true if this call marked the cell, false if it was already
+  ///   marked.
+  inline static bool setCellMarkBitAtomic(const GCCell *cell);
+
   /// Return whether the given \p cell is marked.  Assumes the given address is
   /// a valid heap object.
   inline static bool getCellMarkBit(const GCCell *cell);
@@ -351,6 +356,13 @@ void AlignedHeapSegment::setCellMarkBit(const GCCell *cell) {
   markBits->mark(ind);
 }
 
+/*static*/
+bool AlignedHeapSegment::setCellMarkBitAtomic(const GCCell *cell) {
+  MarkBitArrayNC *markBits = markBitArrayCovering(cell);
+  size_t ind = markBits->addressToIndex(cell);
+  return markBits->markAtomic(ind);
+}
+
 /*static*/
 bool AlignedHeapSegment::getCellMarkBit(const GCCell *cell) {
   MarkBitArrayNC *markBits = markBitArrayCovering(cell);
@@ -1002,6 +1002,18 @@ class GCBase {
   virtual void creditExternalMemory(GCCell *alloc, uint32_t size) = 0;
   virtual void debitExternalMemory(GCCell *alloc, uint32_t size) = 0;
 
+  /// A function that releases a native resource, given a pointer to it.
+  using DeferredFinalizer = void (*)(void *);
+
+  /// Call \p fn with \p arg at some point after the current collection, which
+  /// may be on another thread. Finalizers use this to release native resources
+  /// that are expensive to destroy, to keep that cost out of the GC pause.
+  /// \p fn must not access the heap or the runtime.
+  /// Must only be called from a finalizer.
+  virtual void deferFinalization(DeferredFinalizer fn, void *arg) {
+    fn(arg);
+  }
+
 #ifdef HERMESVM_GC_RUNTIME
   /// Default implementations for read and write barriers: do nothing.
   void writeBarrier(const GCHermesValue *loc, HermesValue value);
@@ -21,6 +21,7 @@
 #include "llvh/Support/PointerLikeTypeTraits.h"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <deque>
@@ -141,6 +142,11 @@ class HadesGC final : public GCBase {
   /// (Part of general GC API defined in GCBase.h).
   void debitExternalMemory(GCCell *alloc, uint32_t size) override;
 
+  /// Queue \p fn to be called on the finalizer thread after the current
+  /// collection, or call it immediately if there is no finalizer thread.
+  /// (Part of general GC API defined in GCBase.h).
+  void deferFinalization(DeferredFinalizer fn, void *arg) override;
+
   /// \name Write Barriers
   /// \{
 
@@ -343,6 +349,11 @@ class HadesGC final : public GCBase {
   class MarkWeakRootsAcceptor;
   class OldGen;
   class Executor;
+  class WorkerPool;
+  class EvacWorkers;
+  class SharedMarkStack;
+  template <bool CompactionEnabled>
+  class DirtySlotRecorder;
 
   struct CopyListCell final : public GCCell {
     // Linked list of cells pointing to the next cell that was copied.
@@ -393,6 +404,24 @@ class HadesGC final : public GCBase {
     /// \return the segment that was removed.
     HeapSegment popSegment();
 
+    /// \return the index of the segment with the fewest live bytes, according
+    /// to segmentLiveBytes().
+    /// \pre There is at least one segment.
+    size_t sparsestSegment() const;
+
+    /// \return the number of live bytes in the segment at \p segIdx as of the
+    /// last time it was swept. Allocations made since then are not counted.
+    uint64_t segmentLiveBytes(size_t segIdx) const;
+
+    /// \return the sum of segmentLiveBytes() over all segments. Unlike
+    /// allocatedBytes(), this does not include garbage allocated since the
+    /// last sweep.
+    uint64_t sweptLiveBytes() const;
+
+    /// Swap the segment at \p segIdx with the last segment, so that it can be
+    /// removed with popSegment().
+    void moveSegmentToBack(size_t segIdx);
+
     /// Indicate that OG should target having a size of \p targetSizeBytes.
     void setTargetSizeBytes(size_t targetSizeBytes);
 
@@ -466,10 +495,12 @@ class HadesGC final : public GCBase {
       }
     };
 
-    /// Sweep the next segment and advance the internal sweep iterator. If there
-    /// are no more segments left to sweep, update OG collection stats with
-    /// numbers from the sweep. \p backgroundThread indicates  whether this call
-    /// was made from the background thread.
+    /// Sweep the next segment and advance the internal sweep iterator. If
+    /// there are OG worker threads, sweep as many segments as there are
+    /// workers in parallel instead. If there are no more segments left to
+    /// sweep, update OG collection stats with numbers from the sweep.
+    /// \p backgroundThread indicates  whether this call was made from the
+    /// background thread.
     bool sweepNext(bool backgroundThread);
 
     /// Initialize the internal sweep iterator. This will reset the internal
@@ -575,6 +606,25 @@ class HadesGC final : public GCBase {
         SegmentBuckets &segBuckets,
         bool setHead);
 
+    /// The free ranges and dead cells found in a single segment.
+    struct SegmentSweep;
+
+    /// Find the free ranges and the dead cells in the segment at \p segIdx,
+    /// trimming live cells if \p trim is true. This only touches memory in
+    /// that segment, so different segments can be scanned in parallel.
+    void scanSegmentForSweep(
+        size_t segIdx,
+        bool trim,
+        bool isTracking,
+        SegmentSweep &sweep);
+
+    /// Finalize the dead cells found by scanSegmentForSweep, and build the
+    /// freelists of the segment at \p segIdx from its free ranges.
+    void finishSegmentSweep(
+        size_t segIdx,
+        const SegmentSweep &sweep,
+        bool isTracking);
+
     HadesGC &gc_;
 
     /// Use a std::deque instead of a std::vector so that references into it
@@ -612,6 +662,20 @@ class HadesGC final : public GCBase {
     /// as needed.
     std::deque<SegmentBuckets> segmentBuckets_;
 
+    /// The number of live bytes in each segment, updated when it is swept.
+    std::deque<uint32_t> segmentLiveBytes_;
+
+    /// The minimum size of a free cell taken as allocCache_. Must be larger
+    /// than any small allocation.
+    static constexpr uint32_t kMinAllocCacheSize = 4 * kMinSizeForLargeBlock;
+
+    /// A large free cell that has been taken off the freelists. Small
+    /// allocations whose exact size bucket is empty are carved off its end in
+    /// constant time, instead of splitting the first fitting free cell. This
+    /// also keeps objects that are allocated together, such as the ones
+    /// promoted by a YG collection, next to each other. Null if there is none.
+    FreelistCell *allocCache_{nullptr};
+
     /// Contains dummy heads for the segment level freelists for each bucket.
     std::array<SegmentBucket, kNumFreelistBuckets> buckets_{};
 
@@ -638,6 +702,20 @@ class HadesGC final : public GCBase {
     ///   if no such space exists.
     GCCell *search(uint32_t sz);
 
+    /// Allocate a small cell of \p sz bytes by carving it off the end of
+    /// allocCache_, refilling allocCache_ from the freelists if it is too
+    /// small.
+    /// \return null if there is no free cell large enough to refill it.
+    GCCell *allocFromCache(uint32_t sz);
+
+    /// Allocate a cell of \p sz bytes from allocCache_, without refilling it.
+    /// \return null if allocCache_ is too small.
+    GCCell *carveFromAllocCache(uint32_t sz);
+
+    /// Return allocCache_ to the freelists. This must be done before anything
+    /// that rebuilds or removes the freelists of its segment.
+    void flushAllocCache();
+
     /// Common path for when an allocation has succeeded.
     /// \param cell The free memory that will soon have an object allocated into
     ///   it.
@@ -724,6 +802,26 @@ class HadesGC final : public GCBase {
   /// concurrently with the mutator.
   std::unique_ptr<Executor> backgroundExecutor_;
 
+  /// Helper threads that scan dirty cards in parallel during a YG collection.
+  /// Null if YG collections are single threaded.
+  std::unique_ptr<EvacWorkers> ygEvacWorkers_;
+
+  /// Helper threads that mark and sweep the OG alongside the thread running
+  /// the collection. Null if OG collections are single threaded.
+  std::unique_ptr<WorkerPool> ogWorkers_;
+
+  /// The thread that runs deferredFinalizers_ after each collection. Null if
+  /// deferred finalizers are run immediately.
+  std::unique_ptr<Executor> finalizerExecutor_;
+
+  /// Finalizers deferred during the current collection, which have not been
+  /// handed to finalizerExecutor_ yet.
+  /// Protected by gcMutex_.
+  std::vector<std::pair<DeferredFinalizer, void *>> deferredFinalizers_;
+
+  /// The number of finalizers that have been run on finalizerExecutor_.
+  uint64_t numDeferredFinalizers_{0};
+
   /// This tracks the current status of execution in the background thread. The
   /// future should be set every time work is enqueued onto the executor. After
   /// that, whenever we need to wait for execution in the background thread to
@@ -746,6 +844,14 @@ class HadesGC final : public GCBase {
   /// at the end of each YG collection.
   bool overwriteDeadYGObjects_;
 
+  /// If true, allocate the kinds in pretenureFeedback_ directly in the OG
+  /// while most of them survive their first YG collection.
+  const bool pretenure_;
+
+  /// If non-zero, the YG pause time in milliseconds that the YG size should be
+  /// chosen to meet, based on the measured evacuation and survival rates.
+  const unsigned ygPauseTargetMs_;
+
   /// Target OG occupancy ratio at the end of an OG collection.
   const double occupancyTarget_;
 
@@ -769,10 +875,37 @@ class HadesGC final : public GCBase {
   /// each YG collection.
   ExponentialMovingAverage ygAverageSurvivalBytes_;
 
+  /// The weighted averages of the rate at which YG collections evacuate
+  /// objects, in bytes per millisecond, and of the fraction of the YG that
+  /// survives each YG collection. Only maintained if ygPauseTargetMs_ is set.
+  ExponentialMovingAverage ygEvacuationRate_;
+  ExponentialMovingAverage ygSurvivalRatio_;
+
   /// The amount of bytes of external memory credited to objects in the YG.
   /// Only accessible to the mutator.
   uint64_t ygExternalBytes_{0};
 
+  /// Survival feedback for a cell kind that can be pretenured. Only
+  /// accessible to the mutator.
+  struct PretenureFeedback {
+    /// Bytes allocated in the YG since the last decision, and how many of
+    /// them were promoted. Every YG collection evacuates all live objects, so
+    /// these cover the same objects.
+    uint64_t allocatedBytes{0};
+    uint64_t promotedBytes{0};
+
+    /// The number of YG collections until the kind is allocated in the YG
+    /// again to check whether it still survives. Non-zero while pretenured.
+    uint32_t collectionsUntilResample{0};
+  };
+
+  /// The number of kinds that can be pretenured, see pretenureIndex().
+  static constexpr size_t kNumPretenureKinds = 4;
+  std::array<PretenureFeedback, kNumPretenureKinds> pretenureFeedback_{};
+
+  /// The number of bytes allocated directly in the OG due to pretenuring.
+  uint64_t pretenuredBytes_{0};
+
   struct CompacteeState {
     /// \return true if the pointer lives in the segment that is being marked or
     /// evacuated for compaction.
@@ -849,6 +982,20 @@ class HadesGC final : public GCBase {
   /// The number of compactions this GC has performed.
   size_t numCompactions_{0};
 
+  /// The number of compactions that were started because the OG was
+  /// fragmented, rather than above its target size.
+  size_t numFragmentationCompactions_{0};
+
+  /// Time spent in parallel dirty card scans, summed over all workers, and the
+  /// time those workers were available for (wall time times worker count). The
+  /// ratio between the two is the parallel efficiency of YG collections.
+  std::chrono::steady_clock::duration ygParallelBusyTime_{};
+  std::chrono::steady_clock::duration ygParallelAvailableTime_{};
+
+  /// Same as the above, for parallel OG marking.
+  std::chrono::steady_clock::duration ogParallelBusyTime_{};
+  std::chrono::steady_clock::duration ogParallelAvailableTime_{};
+
   struct NativeIDs {
     HeapSnapshot::NodeID ygFinalizables{IDTracker::kInvalidNode};
     HeapSnapshot::NodeID og{IDTracker::kInvalidNode};
@@ -868,6 +1015,38 @@ class HadesGC final : public GCBase {
   /// Slow path for allocations.
   void *allocSlow(uint32_t sz);
 
+  /// \return the index into pretenureFeedback_ for \p kind, or -1 if it is
+  /// never pretenured. Only backing stores that can already be allocated
+  /// long-lived are eligible, since their initialization is known to be
+  /// correct outside the YG.
+  static constexpr int pretenureIndex(CellKind kind) {
+    switch (kind) {
+      case CellKind::ArrayStorageKind:
+        return 0;
+      case CellKind::ArrayStorageSmallKind:
+        return 1;
+      case CellKind::SegmentedArrayKind:
+        return 2;
+      case CellKind::SegmentedArraySmallKind:
+        return 3;
+      default:
+        return -1;
+    }
+  }
+
+  /// \return true if an object of type \p T and size \p sz should be
+  /// allocated directly in the OG. Otherwise, record its allocation in the
+  /// YG for the survival feedback.
+  template <typename T>
+  inline bool shouldPretenure(uint32_t sz);
+
+  /// Record that \p cell, of size \p sz, was promoted out of the YG.
+  void recordPromotion(const GCCell *cell, uint32_t sz);
+
+  /// At the end of a YG collection, decide which kinds to pretenure until the
+  /// next one.
+  void updatePretenuring();
+
   /// Like alloc, but the resulting object is expected to be long-lived.
   /// Allocate directly in the old generation (doing a full collection if
   /// necessary to create room).
@@ -903,9 +1082,14 @@ class HadesGC final : public GCBase {
   /// collection.
   void transferExternalMemoryToOldGen();
 
+  /// Hand the finalizers in deferredFinalizers_ to finalizerExecutor_.
+  void flushDeferredFinalizers();
+
   /// Update the scaling factor for the size of the young gen to meet our pause
   /// time goals, based on the duration of the most recently completed YG.
-  void updateYoungGenSizeFactor();
+  /// \param ygUsedBytes The number of bytes in the YG before the collection.
+  /// \param evacuatedBytes The number of bytes evacuated by the collection.
+  void updateYoungGenSizeFactor(uint64_t ygUsedBytes, uint64_t evacuatedBytes);
 
   /// Perform an OG garbage collection. All live objects in OG will be left
   /// untouched, all unreachable objects will be placed into a free list that
@@ -956,22 +1140,36 @@ class HadesGC final : public GCBase {
   /// heap limit. Should be called at the start of completeMarking.
   void updateOldGenThreshold();
 
-  /// Prepare the last segment in the OG for compaction and initialise any
-  /// necessary state.
+  /// Select the OG segment with the least live data for compaction, remove it
+  /// from the OG, and initialise any necessary state. A segment is only
+  /// selected if the OG is above its target size, or if it is fragmented
+  /// enough that compacting is worthwhile.
   /// \param forceCompaction If true, a compactee will be prepared regardless of
-  ///   heap conditions. Note that if there are no OG heap segments, a
-  ///   compaction cannot occur no matter what.
+  ///   heap conditions. Note that if there are fewer than two OG heap
+  ///   segments, a compaction cannot occur no matter what.
   void prepareCompactee(bool forceCompaction);
 
+  /// \return the fraction of the OG segments' capacity that was found to be
+  ///   free by the last sweep.
+  double oldGenFragmentation() const;
+
+  /// \return true if the OG is fragmented enough that the segment at \p segIdx
+  ///   should be compacted even though the OG is below its target size.
+  bool shouldCompactForFragmentation(size_t segIdx) const;
+
   /// Run finalizers on the compactee and clear any compaction state.
   void finalizeCompactee();
 
   /// Search a single segment for pointers that may need to be updated as the
-  /// YG/compactee are evacuated.
-  template <bool CompactionEnabled>
+  /// YG/compactee are evacuated. Only the cards with indices in
+  /// [fromCard, toCard) are searched, so that a segment can be split between
+  /// several workers.
+  template <bool CompactionEnabled, typename Acceptor>
   void scanDirtyCardsForSegment(
-      SlotVisitor<EvacAcceptor<CompactionEnabled>> &visitor,
-      HeapSegment &segment);
+      SlotVisitor<Acceptor> &visitor,
+      HeapSegment &segment,
+      size_t fromCard = 0,
+      size_t toCard = SIZE_MAX);
 
   /// Find all pointers from OG into the YG/compactee during a YG collection.
   /// This is done quickly through use of write barriers that detect the
@@ -979,6 +1177,12 @@ class HadesGC final : public GCBase {
   template <bool CompactionEnabled>
   void scanDirtyCards(EvacAcceptor<CompactionEnabled> &acceptor);
 
+  /// Same as scanDirtyCards, but the dirty cards are searched by all of the
+  /// ygEvacWorkers_, which only record the slots that need updating. The
+  /// recorded slots are then handed to \p acceptor on the calling thread.
+  template <bool CompactionEnabled>
+  void scanDirtyCardsParallel(EvacAcceptor<CompactionEnabled> &acceptor);
+
   /// Common logic for doing the Snapshot At The Beginning (SATB) write barrier.
   void snapshotWriteBarrierInternal(GCCell *oldValue);
   void snapshotWriteBarrierInternal(CompressedPointer oldValue);
@@ -1096,7 +1300,7 @@ inline T *HadesGC::makeA(uint32_t size, Args &&...args) {
       isSizeHeapAligned(size) &&
       "Call to makeA must use a size aligned to HeapAlign");
   assert(noAllocLevel_ == 0 && "No allocs allowed right now.");
-  if (longLived == LongLived::Yes) {
+  if (longLived == LongLived::Yes || shouldPretenure<T>(size)) {
     auto lk = ensureBackgroundTaskPaused();
     return constructCell<T>(
         allocLongLived(size), size, std::forward<Args>(args)...);
@@ -1108,6 +1312,20 @@ inline T *HadesGC::makeA(uint32_t size, Args &&...args) {
       std::forward<Args>(args)...);
 }
 
+template <typename T>
+inline bool HadesGC::shouldPretenure(uint32_t sz) {
+  constexpr int idx = pretenureIndex(T::getCellKind());
+  if (idx < 0 || !pretenure_)
+    return false;
+  PretenureFeedback &feedback = pretenureFeedback_[idx];
+  if (LLVM_UNLIKELY(feedback.collectionsUntilResample)) {
+    pretenuredBytes_ += sz;
+    return true;
+  }
+  feedback.allocatedBytes += sz;
+  return false;
+}
+
 template <bool fixedSize, HasFinalizer hasFinalizer>
 void *HadesGC::allocWork(uint32_t sz) {
   assert(
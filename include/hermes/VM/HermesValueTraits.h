@@ -39,7 +39,6 @@ HERMES_VM_GCOBJECT(Domain);
 HERMES_VM_GCOBJECT(Environment);
 HERMES_VM_GCOBJECT(FinalizableNativeFunction);
 HERMES_VM_GCOBJECT(GeneratorInnerFunction);
-HERMES_VM_GCOBJECT(HashMapEntry);
 HERMES_VM_GCOBJECT(HiddenClass);
 HERMES_VM_GCOBJECT(HostObject);
 HERMES_VM_GCOBJECT(JSArray);
@@ -56,6 +55,7 @@ HERMES_VM_GCOBJECT(JSError);
 HERMES_VM_GCOBJECT(JSFunction);
 HERMES_VM_GCOBJECT(JSGenerator);
 HERMES_VM_GCOBJECT(JSGeneratorFunction);
+HERMES_VM_GCOBJECT(JSLazyJSONObject);
 HERMES_VM_GCOBJECT(JSNumber);
 HERMES_VM_GCOBJECT(JSObject);
 HERMES_VM_GCOBJECT(JSProxy);
@@ -116,6 +116,14 @@ template <typename T>
 class BufferedStringPrimitive;
 template <typename T>
 struct IsGCObject<BufferedStringPrimitive<T>> : public std::true_type {};
+template <typename T>
+class RopeStringPrimitive;
+template <typename T>
+struct IsGCObject<RopeStringPrimitive<T>> : public std::true_type {};
+template <typename T>
+class SlicedStringPrimitive;
+template <typename T>
+struct IsGCObject<SlicedStringPrimitive<T>> : public std::true_type {};
 
 template <size_t Size>
 struct EmptyCell;
@@ -127,6 +135,11 @@ class ArrayStorageBase;
 template <typename HVType>
 struct IsGCObject<ArrayStorageBase<HVType>> : public std::true_type {};
 
+template <typename T>
+class UnboxedArrayStorage;
+template <typename T>
+struct IsGCObject<UnboxedArrayStorage<T>> : public std::true_type {};
+
 template <typename HVType>
 class SegmentedArrayBase;
 template <typename HVType>
@@ -249,6 +262,18 @@ struct HermesValueTraits<BufferedStringPrimitive<char>, true>
 template <>
 struct HermesValueTraits<BufferedStringPrimitive<char16_t>, true>
     : public StringTraitsImpl<BufferedStringPrimitive<char16_t>> {};
+template <>
+struct HermesValueTraits<RopeStringPrimitive<char>, true>
+    : public StringTraitsImpl<RopeStringPrimitive<char>> {};
+template <>
+struct HermesValueTraits<RopeStringPrimitive<char16_t>, true>
+    : public StringTraitsImpl<RopeStringPrimitive<char16_t>> {};
+template <>
+struct HermesValueTraits<SlicedStringPrimitive<char>, true>
+    : public StringTraitsImpl<SlicedStringPrimitive<char>> {};
+template <>
+struct HermesValueTraits<SlicedStringPrimitive<char16_t>, true>
+    : public StringTraitsImpl<SlicedStringPrimitive<char16_t>> {};
 
 template <class T>
 struct HermesValueTraits<T, true> {
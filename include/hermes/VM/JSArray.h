@@ -11,6 +11,7 @@
 #include "hermes/VM/IterationKind.h"
 #include "hermes/VM/JSObject.h"
 #include "hermes/VM/SegmentedArray.h"
+#include "hermes/VM/UnboxedArrayStorage.h"
 
 namespace hermes {
 namespace vm {
@@ -32,9 +33,34 @@ class ArrayImpl : public JSObject {
   /// @{
   using size_type = uint32_t;
   /// StorageType is the underlying storage that JSArray uses to put the values
-  /// into.
+  /// into, unless the array has one of the packed element kinds.
   using StorageType = SegmentedArraySmall;
 
+  /// How the elements of an array are stored. The kinds are ordered from the
+  /// most to the least specific, and the kind is determined by the type of the
+  /// indexed storage. An array without indexed storage has no elements and
+  /// counts as PackedInt32; it moves to a more general kind on the first write
+  /// that doesn't fit, and only goes back once all its elements are removed.
+  /// In the packed kinds the storage starts at index 0, and every element
+  /// before the end index is present.
+  enum class ElementKind : uint8_t {
+    /// Every element is an int32 number (but not -0), stored unboxed in an
+    /// ArrayStorageInt32.
+    PackedInt32,
+    /// Every element is a number, stored unboxed in an ArrayStorageDouble.
+    PackedDouble,
+    /// Elements are stored in a StorageType, and can be any value or empty.
+    Generic,
+  };
+
+  /// \return the most specific element kind that can store \p value.
+  static ElementKind elementKindFor(HermesValue value) {
+    if (!value.isNumber())
+      return ElementKind::Generic;
+    return isInt32Element(value.getNumber()) ? ElementKind::PackedInt32
+                                             : ElementKind::PackedDouble;
+  }
+
   /// Resize the internal storage. The ".length" property is not affected. It
   /// does \b NOT check for read-only properties.
   static ExecutionStatus setStorageEndIndex(
@@ -71,6 +97,9 @@ class ArrayImpl : public JSObject {
     // The array must be extendable (and by implication is not frozen or sealed)
     // because we don't know whether the element being set is empty or not.
     assert(!self->flags_.noExtend && "this array cannot be extended");
+    assert(
+        self->getElementKind(runtime) == ElementKind::Generic &&
+        "array must have generic storage");
 
     assert(
         index >= self->beginIndex_ && index < self->endIndex_ &&
@@ -79,6 +108,45 @@ class ArrayImpl : public JSObject {
         runtime, index - self->beginIndex_, value);
   }
 
+  /// Fast path for writing \p value to the existing element at \p index of an
+  /// array with a packed element kind, without allocating.
+  /// \return true if the element was written, or false if the array doesn't
+  /// have a packed element kind, the element doesn't exist, \p value doesn't
+  /// fit the element kind, or the array is frozen. The caller must then take
+  /// the general path.
+  static bool trySetPackedElement(
+      ArrayImpl *self,
+      Runtime &runtime,
+      size_type index,
+      HermesValue value) {
+    if (LLVM_UNLIKELY(self->flags_.frozen) || index >= self->endIndex_ ||
+        !value.isNumber())
+      return false;
+    // The element exists, so the array has storage.
+    GCCell *storage = self->indexedStorage_.getNonNull(runtime);
+    const double d = value.getNumber();
+    if (auto *int32Storage = dyn_vmcast<ArrayStorageInt32>(storage)) {
+      if (!isInt32Element(d))
+        return false;
+      int32Storage->set(index, (int32_t)d);
+      return true;
+    }
+    if (auto *doubleStorage = dyn_vmcast<ArrayStorageDouble>(storage)) {
+      doubleStorage->set(index, d);
+      return true;
+    }
+    return false;
+  }
+
+  /// Prepare an array with no indexed storage to be filled with \p capacity
+  /// elements of the packed element kind \p kind, by allocating unboxed
+  /// storage for them.
+  static void reservePackedStorage(
+      Handle<ArrayImpl> selfHandle,
+      Runtime &runtime,
+      ElementKind kind,
+      size_type capacity);
+
   /// Set the element at index \p index to empty. This does not affect the
   /// storage size or array length.
   /// \return true if the operation succeeded (which is always in this class).
@@ -99,23 +167,39 @@ class ArrayImpl : public JSObject {
     return endIndex_;
   }
 
+  /// \return how the elements of this array are stored.
+  ElementKind getElementKind(PointerBase &base) const {
+    const GCCell *storage = indexedStorage_.get(base);
+    if (!storage)
+      return ElementKind::PackedInt32;
+    switch (storage->getKind()) {
+      case CellKind::ArrayStorageInt32Kind:
+        return ElementKind::PackedInt32;
+      case CellKind::ArrayStorageDoubleKind:
+        return ElementKind::PackedDouble;
+      default:
+        return ElementKind::Generic;
+    }
+  }
+
   /// Return the value at index \p index, or \c empty if the index is not
   /// contained in the storage.
-  const SmallHermesValue at(Runtime &runtime, size_type index) const {
+  HermesValue at(PointerBase &base, size_type index) const {
     return index >= beginIndex_ && index < endIndex_
-        ? getIndexedStorage(runtime)->at(runtime, index - beginIndex_)
-        : SmallHermesValue::encodeEmptyValue();
+        ? unsafeAt(base, index)
+        : HermesValue::encodeEmptyValue();
   }
 
   /// Return the value at index \p index.
   Handle<> handleAt(Runtime &runtime, size_type index) const {
-    return runtime.makeHandle(at(runtime, index).unboxToHV(runtime));
+    return runtime.makeHandle(at(runtime, index));
   }
 
-  /// Get a pointer to the indexed storage for this array. The returned value
-  /// may be null if there is no indexed storage.
+  /// Get a pointer to the indexed storage for this array, which must not have
+  /// a packed element kind unless it has no storage. The returned value may be
+  /// null if there is no indexed storage.
   StorageType *getIndexedStorage(PointerBase &base) const {
-    return indexedStorage_.get(base);
+    return vmcast_or_null<StorageType>(indexedStorage_.get(base));
   }
 
   /// Set the indexed storage of this array to be \p p. The pointer is allowed
@@ -213,17 +297,84 @@ class ArrayImpl : public JSObject {
       ObjectVTable::CheckAllOwnIndexedMode mode);
 
   /// Return the value at index \p index, which must be valid.
-  const SmallHermesValue unsafeAt(Runtime &runtime, size_type index) const {
-    return getIndexedStorage(runtime)->at(runtime, index - beginIndex_);
+  HermesValue unsafeAt(PointerBase &base, size_type index) const {
+    // The element is in range, so the array has storage.
+    const GCCell *storage = indexedStorage_.getNonNull(base);
+    switch (storage->getKind()) {
+      case CellKind::ArrayStorageInt32Kind:
+        return HermesValue::encodeNumberValue(
+            vmcast<ArrayStorageInt32>(storage)->at(index));
+      case CellKind::ArrayStorageDoubleKind:
+        return HermesValue::encodeNumberValue(
+            vmcast<ArrayStorageDouble>(storage)->at(index));
+      default:
+        return vmcast<StorageType>(storage)
+            ->at(base, index - beginIndex_)
+            .unboxToHV(base);
+    }
   }
 
  private:
-  /// The first index contained in the storage.
+  /// \return true if \p d can be stored in the PackedInt32 element kind.
+  static bool isInt32Element(double d) {
+    return d >= INT32_MIN && d <= INT32_MAX && d == (int32_t)d &&
+        (d != 0 || !std::signbit(d));
+  }
+
+  /// \return the unboxed storage of an array of the PackedInt32 kind, which
+  /// must exist.
+  ArrayStorageInt32 *getInt32Storage(PointerBase &base) const {
+    return vmcast<ArrayStorageInt32>(indexedStorage_.getNonNull(base));
+  }
+
+  /// \return the unboxed storage of an array of the PackedDouble kind, which
+  /// must exist.
+  ArrayStorageDouble *getDoubleStorage(PointerBase &base) const {
+    return vmcast<ArrayStorageDouble>(indexedStorage_.getNonNull(base));
+  }
+
+  /// \return the maximum number of elements in the storage of an array of
+  /// the packed element kind \p kind.
+  static size_type maxPackedElements(ElementKind kind) {
+    return kind == ElementKind::PackedInt32 ? ArrayStorageInt32::maxElements()
+                                            : ArrayStorageDouble::maxElements();
+  }
+
+  /// Move the array to the more general element kind \p kind, converting
+  /// its elements to the new storage.
+  static ExecutionStatus transitionElementKind(
+      Handle<ArrayImpl> selfHandle,
+      Runtime &runtime,
+      ElementKind kind);
+
+  /// Set the element at \p index of an array with a packed element kind to
+  /// \p value, moving the array to a more general element kind if \p value
+  /// doesn't fit or the write would leave a hole.
+  /// \return true if the element was written, or false if the array now has
+  /// the generic element kind and the caller has to write the element.
+  static CallResult<bool> setPackedElement(
+      Handle<ArrayImpl> selfHandle,
+      Runtime &runtime,
+      size_type index,
+      HermesValue value);
+
+  /// Append \p value to the unboxed storage of type \p Storage of an array
+  /// with a packed element kind.
+  template <typename Storage>
+  static void pushPackedElement(
+      Handle<ArrayImpl> selfHandle,
+      Runtime &runtime,
+      typename Storage::value_type value);
+
+  /// The first index contained in the storage. It is 0 if there is no
+  /// storage.
   uint32_t beginIndex_{0};
-  /// One past the last index contained in the storage.
+  /// One past the last index contained in the storage. It is 0 if there is no
+  /// storage.
   uint32_t endIndex_{0};
-  /// The indexed storage for this array.
-  GCPointer<StorageType> indexedStorage_;
+  /// The indexed storage for this array: an UnboxedArrayStorage in the packed
+  /// element kinds, and a StorageType in the generic one.
+  GCPointer<GCCell> indexedStorage_;
 };
 
 class Arguments final : public ArrayImpl {
@@ -105,6 +105,10 @@ class JSArrayBuffer final : public JSObject {
     return attached_;
   }
 
+  /// Stop accounting for the data block owned by this JSArrayBuffer, and
+  /// \return it so that the caller can free it.
+  uint8_t *releaseInternalBuffer(GC &gc);
+
   /// Free the data block owned by this JSArrayBuffer.
   void freeInternalBuffer(GC &gc);
 
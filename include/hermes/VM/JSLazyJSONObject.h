@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_JSLAZYJSONOBJECT_H
+#define HERMES_VM_JSLAZYJSONOBJECT_H
+
+#include "hermes/VM/JSArrayBuffer.h"
+#include "hermes/VM/JSObject.h"
+
+namespace hermes {
+namespace vm {
+
+/// An object produced by a lazy JSON parse whose properties have not been
+/// parsed yet. It is created as a lazy object, and remembers where its text
+/// starts in the source document. The first operation that needs its
+/// properties materializes them from the source, after which it behaves
+/// exactly like an ordinary object created by JSON.parse.
+class JSLazyJSONObject final : public JSObject {
+  using Super = JSObject;
+  friend void JSLazyJSONObjectBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  static const ObjectVTable vt;
+
+  static constexpr CellKind getCellKind() {
+    return CellKind::JSLazyJSONObjectKind;
+  }
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == CellKind::JSLazyJSONObjectKind;
+  }
+
+  /// Create a lazy object for the JSON object starting at offset \p offset of
+  /// \p source. \p ordinal is the position of the object in the structural
+  /// index \p index of the document.
+  /// \pre \p source is an external UTF-16 string, so its characters don't
+  ///   move during GC.
+  static PseudoHandle<JSLazyJSONObject> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> source,
+      Handle<JSArrayBuffer> index,
+      uint32_t offset,
+      uint32_t ordinal);
+
+  /// \return the source document, or null if the object has already been
+  /// materialized.
+  StringPrimitive *getSource(PointerBase &base) const {
+    return source_.get(base);
+  }
+
+  /// \return the structural index of the source document.
+  JSArrayBuffer *getIndex(PointerBase &base) const {
+    return index_.get(base);
+  }
+
+  /// \return the offset of the opening brace of this object in the source.
+  uint32_t getOffset() const {
+    return offset_;
+  }
+
+  /// \return the position of this object in the structural index.
+  uint32_t getOrdinal() const {
+    return ordinal_;
+  }
+
+  /// Drop the references to the source document once the properties have
+  /// been materialized, so that it can be collected.
+  void releaseSource(Runtime &runtime) {
+    source_.setNull(runtime.getHeap());
+    index_.setNull(runtime.getHeap());
+  }
+
+  JSLazyJSONObject(
+      Runtime &runtime,
+      Handle<JSObject> parent,
+      Handle<HiddenClass> clazz,
+      Handle<StringPrimitive> source,
+      Handle<JSArrayBuffer> index,
+      uint32_t offset,
+      uint32_t ordinal);
+
+ private:
+  /// The source document.
+  GCPointer<StringPrimitive> source_;
+
+  /// The structural index of the source document. See
+  /// runtimeJSONParseLazy() for its layout.
+  GCPointer<JSArrayBuffer> index_;
+
+  /// The offset of the opening brace of this object in source_.
+  uint32_t offset_;
+
+  /// The position of this object in index_.
+  uint32_t ordinal_;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JSLAZYJSONOBJECT_H
@@ -11,9 +11,15 @@
 #include "hermes/Support/UTF16Stream.h"
 #include "hermes/VM/Runtime.h"
 
+namespace llvh {
+class raw_ostream;
+} // namespace llvh
+
 namespace hermes {
 namespace vm {
 
+class JSLazyJSONObject;
+
 /// Parse JSON string \p jsonString according to ES5.1 15.12.1 and 15.12.2.
 CallResult<HermesValue> runtimeJSONParse(
     Runtime &runtime,
@@ -23,6 +29,18 @@ CallResult<HermesValue> runtimeJSONParse(
 /// Alternative interface to runtimeJSONParse for strings outside the JS heap.
 CallResult<HermesValue> runtimeJSONParseRef(Runtime &runtime, UTF16Stream &&s);
 
+/// Parse JSON string \p jsonString like runtimeJSONParse without a reviver,
+/// but defer parsing the contents of objects until they are first used.
+/// The whole document is still validated up front, so a SyntaxError is
+/// reported immediately.
+CallResult<HermesValue> runtimeJSONParseLazy(
+    Runtime &runtime,
+    Handle<StringPrimitive> jsonString);
+
+/// Define the properties of lazy object \p obj, created by
+/// runtimeJSONParseLazy, from its source text.
+void runtimeJSONMaterialize(Runtime &runtime, Handle<JSLazyJSONObject> obj);
+
 /// Returns a String in JSON format representing an ECMAScript value,
 /// according to 15.12.3.
 CallResult<HermesValue> runtimeJSONStringify(
@@ -31,6 +49,16 @@ CallResult<HermesValue> runtimeJSONStringify(
     Handle<> replacer,
     Handle<> space);
 
+/// Same as runtimeJSONStringify, but writes the result to \p os as UTF-8 in
+/// chunks as it is produced, instead of creating a String.
+/// \return false if the result is undefined, in which case nothing is written.
+CallResult<bool> runtimeJSONStringifyTo(
+    Runtime &runtime,
+    Handle<> value,
+    Handle<> replacer,
+    Handle<> space,
+    llvh::raw_ostream &os);
+
 } // namespace vm
 } // namespace hermes
 
@@ -11,6 +11,8 @@
 #include <cstdint>
 
 #include "hermes/VM/CallResult.h"
+#include "hermes/VM/Handle.h"
+#include "hermes/VM/SegmentedArray.h"
 
 /// Defines custom sorting routines used in cases that we can't use std::sort.
 /// std::sort doesn't always use std::swap, performing operations that bypass
@@ -42,6 +44,36 @@ class SortModel {
 /// with ExecutionStatus::EXCEPTION if any compare or swap operations fail.
 ExecutionStatus quickSort(SortModel *sm, uint32_t begin, uint32_t end);
 
+/// Abstraction of the comparison used by timSort, which sorts values that
+/// have been copied out of the object being sorted. Like SortModel::compare,
+/// an implementation can evaluate JavaScript.
+class SortComparator {
+ public:
+  // Compare values a and b.
+  // Return negative if a < b, positive if a > b, 0 if a = b.
+  virtual CallResult<int> compare(Handle<> a, Handle<> b) = 0;
+
+  virtual ~SortComparator() = 0;
+};
+
+/// Stable TimSort of all the elements of \p values. It finds the runs that
+/// are already in order and merges them, galloping through long stretches
+/// that come from the same run, so partially sorted input needs far fewer
+/// comparisons than a quicksort. Returns immediately with
+/// ExecutionStatus::EXCEPTION if any compare operation fails, leaving the
+/// contents of \p values unspecified. An inconsistent comparison leaves the
+/// elements in an unspecified order, but never loses or duplicates any.
+ExecutionStatus
+timSort(Runtime &runtime, SortComparator *cmp, Handle<SegmentedArray> values);
+
+/// Sort the elements in [begin, end) of a typed array whose element type is
+/// \p T, in the order used by TypedArray.prototype.sort without a comparator:
+/// ascending, with -0 before +0 and NaN last. Integers of up to 32 bits are
+/// sorted with a radix sort, and other types with pdqSort. Instantiated for
+/// every element type in TypedArrays.def.
+template <typename T>
+void sortTypedArrayElements(T *begin, T *end);
+
 } // namespace vm
 } // namespace hermes
 
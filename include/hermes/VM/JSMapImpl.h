@@ -51,19 +51,33 @@ class JSMapImpl final : public JSObject {
     return ExecutionStatus::RETURNED;
   }
 
-  /// Advance iterator and return the next.
-  HashMapEntry *iteratorNext(Runtime &runtime, HashMapEntry *entry) {
-    return storage_.getNonNull(runtime)->iteratorNext(runtime, entry);
+  /// Advance the iteration position \p table and \p index to the next entry.
+  /// See OrderedHashMap::iteratorNext.
+  bool iteratorNext(
+      Runtime &runtime,
+      SegmentedArraySmall *&table,
+      uint32_t &index) {
+    return storage_.getNonNull(runtime)->iteratorNext(runtime, table, index);
+  }
+
+  /// \return the key of the entry at \p index, as found by iteratorNext().
+  HermesValue iteratorKey(Runtime &runtime, uint32_t index) {
+    return storage_.getNonNull(runtime)->iteratorKey(runtime, index);
+  }
+
+  /// \return the value of the entry at \p index, as found by iteratorNext().
+  HermesValue iteratorValue(Runtime &runtime, uint32_t index) {
+    return storage_.getNonNull(runtime)->iteratorValue(runtime, index);
   }
 
   /// Add a value.
-  static void addValue(
+  static ExecutionStatus addValue(
       Handle<JSMapImpl> self,
       Runtime &runtime,
       Handle<> key,
       Handle<> value) {
     self->assertInitialized();
-    OrderedHashMap::insert(
+    return OrderedHashMap::insert(
         runtime.makeHandle<OrderedHashMap>(self->storage_),
         runtime,
         key,
@@ -99,9 +113,10 @@ class JSMapImpl final : public JSObject {
   }
 
   /// Clear all elements from the storage.
-  static void clear(Handle<JSMapImpl> self, Runtime &runtime) {
+  static ExecutionStatus clear(Handle<JSMapImpl> self, Runtime &runtime) {
     self->assertInitialized();
-    self->storage_.getNonNull(runtime)->clear(runtime);
+    return OrderedHashMap::clear(
+        runtime.makeHandle<OrderedHashMap>(self->storage_), runtime);
   }
 
   /// Call \p callbackfn for each entry, with \p thisArg as this.
@@ -111,15 +126,18 @@ class JSMapImpl final : public JSObject {
       Handle<Callable> callbackfn,
       Handle<> thisArg) {
     self->assertInitialized();
-    MutableHandle<HashMapEntry> entry{runtime};
+    MutableHandle<SegmentedArraySmall> table{runtime};
+    uint32_t index = 0;
     GCScopeMarkerRAII marker{runtime};
-    for (entry = self->storage_.getNonNull(runtime)->iteratorNext(runtime);
-         entry;
-         entry = self->storage_.getNonNull(runtime)->iteratorNext(
-             runtime, entry.get())) {
+    for (;;) {
       marker.flush();
-      HermesValue key = entry->key;
-      HermesValue value = entry->value;
+      SegmentedArraySmall *tablePtr = table.get();
+      if (!self->iteratorNext(runtime, tablePtr, index))
+        break;
+      table = tablePtr;
+      HermesValue key = self->iteratorKey(runtime, index);
+      HermesValue value = self->iteratorValue(runtime, index);
+      ++index;
       assert(!key.isEmpty() && "Invalid key encountered");
       assert(!value.isEmpty() && "Invalid value encountered");
       if (LLVM_UNLIKELY(
@@ -213,18 +231,20 @@ class JSMapIteratorImpl final : public JSObject {
       // Iteration has not yet reached the end previously.
       assert(self->data_ && "Storage uninitialized");
       // Advance the iterator.
-      self->itr_.set(
-          runtime,
-          self->data_.getNonNull(runtime)->iteratorNext(
-              runtime, self->itr_.get(runtime)),
-          runtime.getHeap());
-      if (self->itr_) {
+      SegmentedArraySmall *table = self->itrTable_.get(runtime);
+      uint32_t index = self->itrIndex_;
+      if (self->data_.getNonNull(runtime)->iteratorNext(
+              runtime, table, index)) {
+        self->itrTable_.set(runtime, table, runtime.getHeap());
+        self->itrIndex_ = index + 1;
         switch (self->iterationKind_) {
           case IterationKind::Key:
-            value = self->itr_.getNonNull(runtime)->key;
+            value =
+                self->data_.getNonNull(runtime)->iteratorKey(runtime, index);
             break;
           case IterationKind::Value:
-            value = self->itr_.getNonNull(runtime)->value;
+            value =
+                self->data_.getNonNull(runtime)->iteratorValue(runtime, index);
             break;
           case IterationKind::Entry: {
             // If we are iterating both key and value, we need to create an
@@ -234,9 +254,11 @@ class JSMapIteratorImpl final : public JSObject {
               return ExecutionStatus::EXCEPTION;
             }
             auto arrHandle = *arrRes;
-            value = self->itr_.getNonNull(runtime)->key;
+            value =
+                self->data_.getNonNull(runtime)->iteratorKey(runtime, index);
             JSArray::setElementAt(arrHandle, runtime, 0, value);
-            value = self->itr_.getNonNull(runtime)->value;
+            value =
+                self->data_.getNonNull(runtime)->iteratorValue(runtime, index);
             JSArray::setElementAt(arrHandle, runtime, 1, value);
             value = arrHandle.getHermesValue();
             break;
@@ -250,6 +272,7 @@ class JSMapIteratorImpl final : public JSObject {
         // reached the end.
         self->iterationFinished_ = true;
         self->data_.setNull(runtime.getHeap());
+        self->itrTable_.setNull(runtime.getHeap());
       }
     }
     return createIterResultObject(runtime, value, self->iterationFinished_)
@@ -272,8 +295,12 @@ class JSMapIteratorImpl final : public JSObject {
   /// initialized or the iteration has ended.
   GCPointer<JSMapImpl<JSMapTypeTraits<C>::ContainerKind>> data_{nullptr};
 
-  /// Iteration pointer to the element storage in the Map.
-  GCPointer<HashMapEntry> itr_{nullptr};
+  /// The table of the Map that the iteration was last in. nullptr if the
+  /// iteration has not started or has ended.
+  GCPointer<SegmentedArraySmall> itrTable_{nullptr};
+
+  /// Index of the next entry to visit in itrTable_.
+  uint32_t itrIndex_{0};
 
   IterationKind iterationKind_;
 
@@ -55,6 +55,11 @@ class MarkBitArrayNC {
   /// range of the array.
   inline void mark(size_t ind);
 
+  /// Same as \c mark, but safe to call concurrently with other calls to
+  /// markAtomic on the same array.
+  /// \return true if the bit was not already marked.
+  inline bool markAtomic(size_t ind);
+
   /// Clears the bit array.
   inline void clear();
 
@@ -140,6 +145,11 @@ void MarkBitArrayNC::mark(size_t ind) {
   bitArray_.set(ind, true);
 }
 
+bool MarkBitArrayNC::markAtomic(size_t ind) {
+  assert(ind < kNumBits && "precondition: ind must be within the index range");
+  return bitArray_.setAtomic(ind);
+}
+
 void MarkBitArrayNC::clear() {
   bitArray_.reset();
 }
@@ -9,74 +9,47 @@
 #define HERMES_VM_ORDERED_HASHMAP_H
 
 #include "hermes/Support/ErrorHandling.h"
-#include "hermes/VM/ArrayStorage.h"
 #include "hermes/VM/Runtime.h"
-
-#include <vector>
+#include "hermes/VM/SegmentedArray.h"
 
 namespace hermes {
 namespace vm {
 
-/// HashMapEntry is a gc-managed entry in the OrderedHashMap.
-/// We use HashMapEntry to form two separate linked lists,
-/// one that tracks the insertion order for iteration purpose, one
-/// tracks the list of entries in a hash table bucket for hash operations.
-class HashMapEntry final : public GCCell {
- public:
-  static const VTable vt;
-
-  /// The key.
-  GCHermesValue key;
-
-  /// The value.
-  GCHermesValue value;
-
-  /// Previous entry in insertion order.
-  GCPointer<HashMapEntry> prevIterationEntry{nullptr};
-
-  /// Next entry in insertion order.
-  GCPointer<HashMapEntry> nextIterationEntry{nullptr};
-
-  /// Next entry in the hash table bucket.
-  GCPointer<HashMapEntry> nextEntryInBucket{nullptr};
-
-  static constexpr CellKind getCellKind() {
-    return CellKind::HashMapEntryKind;
-  }
-  static bool classof(const GCCell *cell) {
-    return cell->getKind() == CellKind::HashMapEntryKind;
-  }
-
-  static CallResult<PseudoHandle<HashMapEntry>> create(Runtime &runtime);
-
-  /// Indicates whether this entry has been deleted.
-  bool isDeleted() const {
-    assert(key.isEmpty() == value.isEmpty() && "Inconsistent deleted status");
-    return value.isEmpty();
-  }
-
-  /// Mark this entry as deleted.
-  void markDeleted(Runtime &runtime) {
-    key.setNonPtr(HermesValue::encodeEmptyValue(), runtime.getHeap());
-    value.setNonPtr(HermesValue::encodeEmptyValue(), runtime.getHeap());
-  }
-}; // HashMapEntry
-
 /// OrderedHashMap is a gc-managed hash map that maintains insertion order.
-/// The map contains two conceptual parts: a standard chained hash table,
-/// to store and lookup HermesValue; a linked list to maintain the insertion
-/// order.
-/// When an element is added, it's always appended to the end of the linked
-/// list. When an element is deleted, we mark it as deleted and remove it
-/// from the linked list, unless it's the last element.
-/// Iterators are pointers to the entries, which are always linked according
-/// to insertion order.
-/// When the size of the hash table becomes unreasonably large or small
-/// comparing to the number of alive elements, we will rehash the table.
-/// We always make sure that any entry at any moment can successfully find
-/// the next entry according to insertion order, and rely on GC to manage
-/// the "deleted" entries", free them when no more iterators are before
-/// that entry.
+/// It is a deterministic hash table in the style described by Tyler Close:
+/// all entries live in a single table, which contains a dense array of
+/// entries in insertion order and an array of hash buckets. Each bucket holds
+/// the index of the first entry in its chain, and each entry holds its key,
+/// its value and the index of the next entry in the same chain. There is no
+/// per-entry allocation.
+///
+/// When an element is added, it's always appended to the entries array. When
+/// an element is deleted, it's unlinked from its chain and its key and value
+/// are cleared, leaving a tombstone that iteration skips. When the entries
+/// array is full, the table is rebuilt: it grows if most entries are alive,
+/// and is otherwise compacted in place of growing. It also shrinks when few
+/// entries are alive.
+///
+/// Iteration positions are pairs of a table and an entry index in it. When a
+/// table is rebuilt or cleared, the old table is kept as a forwarding record
+/// for any iteration still pointing into it: it links to the new table, and
+/// each of its entries records the index at which iteration continues in the
+/// new table. An iteration that finds its table out of date follows these
+/// records to the current table, and so never misses or repeats an entry.
+///
+/// The layout of a table is:
+///   [NEXT_TABLE_SLOT] empty while the table is current, otherwise the table
+///   that replaced it.
+///   [FORWARDED_ENTRIES_SLOT] the number of entries in the table when it was
+///   replaced. Only used once the table is no longer current.
+///   [FORWARDED_LIVE_SLOT] the number of live entries carried over to the
+///   next table. Only used once the table is no longer current.
+///   [HEADER_SIZE, ...) the entries, each made of ENTRY_SIZE slots: the key,
+///   the value, and the index of the next entry in the chain (or empty). Once
+///   the table is no longer current, the last slot is instead the index at
+///   which iteration continues in the next table.
+///   [..., end) the bucket heads, the index of the first entry in the chain
+///   (or empty).
 class OrderedHashMap final : public GCCell {
   friend void OrderedHashMapBuildMeta(
       const GCCell *cell,
@@ -102,11 +75,6 @@ class OrderedHashMap final : public GCCell {
   static HermesValue
   get(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
 
-  /// Lookup \p key in the table and \return the value if exists.
-  /// Otherwise \return nullptr.
-  static HashMapEntry *
-  find(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
-
   /// Insert a key/value pair into the map, if not already existing.
   static ExecutionStatus insert(
       Handle<OrderedHashMap> self,
@@ -118,74 +86,146 @@ class OrderedHashMap final : public GCCell {
   static bool
   erase(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key);
 
-  /// Clear the map.  The \p gc parameter is necessary for write barriers.
-  void clear(Runtime &runtime);
+  /// Clear the map.
+  static ExecutionStatus clear(Handle<OrderedHashMap> self, Runtime &runtime);
 
   /// \return the size of the map.
   uint32_t size() const {
     return size_;
   }
 
-  /// \return the next element in insertion order.
-  /// If \p entry is nullptr, we are starting the iteration from the first
-  /// entry that is not deleted.
-  /// Otherwise, we look for the next element after \p entry that is not
-  /// deleted.
-  HashMapEntry *iteratorNext(Runtime &runtime, HashMapEntry *entry = nullptr)
-      const;
+  /// Advance an iteration over the map. The position of the iteration is
+  /// given by \p table, the table it was last in, and \p index, the index of
+  /// the next entry to visit in that table. A null \p table starts a new
+  /// iteration. If \p table is out of date, the position is first carried
+  /// over to the current table.
+  /// \return true if there is another entry, in which case \p table is the
+  /// current table and \p index is the index of that entry, which can be read
+  /// with iteratorKey() and iteratorValue(). Otherwise \return false.
+  bool iteratorNext(
+      Runtime &runtime,
+      SegmentedArraySmall *&table,
+      uint32_t &index) const;
+
+  /// \return the key of the entry at \p index in the current table.
+  HermesValue iteratorKey(Runtime &runtime, uint32_t index) const {
+    assert(index < usedEntries_ && "Invalid entry index");
+    return table_.getNonNull(runtime)
+        ->at(runtime, keySlot(index))
+        .unboxToHV(runtime);
+  }
+
+  /// \return the value of the entry at \p index in the current table.
+  HermesValue iteratorValue(Runtime &runtime, uint32_t index) const {
+    assert(index < usedEntries_ && "Invalid entry index");
+    return table_.getNonNull(runtime)
+        ->at(runtime, valueSlot(index))
+        .unboxToHV(runtime);
+  }
 
-  OrderedHashMap(Runtime &runtime, Handle<ArrayStorageSmall> hashTableStorage);
+  OrderedHashMap(Runtime &runtime, Handle<SegmentedArraySmall> table);
 
  private:
-  /// The hashtable, with size always equal to capacity_. The number of
-  /// reachable entries from hashTable_ should be equal to size_.
-  GCPointer<ArrayStorageSmall> hashTable_{nullptr};
+  /// The current table.
+  GCPointer<SegmentedArraySmall> table_{nullptr};
 
-  /// The first entry ever inserted. We need this entry to begin an iteration.
-  GCPointer<HashMapEntry> firstIterationEntry_{nullptr};
+  /// Number of hash buckets in the table, always a power of two. The table
+  /// has room for twice as many entries.
+  uint32_t numBuckets_{INITIAL_BUCKETS};
 
-  /// The last entry inserted. We need it to add new elements afterwards.
-  GCPointer<HashMapEntry> lastIterationEntry_{nullptr};
+  /// Number of entries used in the table, including deleted ones.
+  uint32_t usedEntries_{0};
 
-  /// Initial capacity of the hash table.
-  static constexpr uint32_t INITIAL_CAPACITY = 16;
+  /// Number of alive entries in the table.
+  uint32_t size_{0};
 
-  /// Maximum capacity cannot exceed the maximum capacity of the underlying
-  /// ArrayStorage.
-  // It needs to be less than 1/4th the max 32-bit integer in order to use an
-  // integer-based load factor check of 0.75.
-  static constexpr uint32_t MAX_CAPACITY =
-      std::min(ArrayStorageSmall::maxElements(), UINT32_MAX / 4);
+  /// Table slots that hold the forwarding information.
+  static constexpr uint32_t NEXT_TABLE_SLOT = 0;
+  static constexpr uint32_t FORWARDED_ENTRIES_SLOT = 1;
+  static constexpr uint32_t FORWARDED_LIVE_SLOT = 2;
+  static constexpr uint32_t HEADER_SIZE = 3;
 
-  /// Capacity of the hash table.
-  uint32_t capacity_{INITIAL_CAPACITY};
+  /// Number of slots per entry.
+  static constexpr uint32_t ENTRY_SIZE = 3;
 
-  /// Number of alive entries in the storage.
-  uint32_t size_{0};
+  /// Number of entries per bucket.
+  static constexpr uint32_t ENTRIES_PER_BUCKET = 2;
+
+  /// Initial number of buckets.
+  static constexpr uint32_t INITIAL_BUCKETS = 4;
+
+  /// \return the number of slots in a table with \p numBuckets buckets.
+  static constexpr uint64_t tableSize(uint64_t numBuckets) {
+    return HEADER_SIZE + numBuckets * (1 + ENTRIES_PER_BUCKET * ENTRY_SIZE);
+  }
 
-  /// Hash a HermesValue to an index to our hash table.
-  static uint32_t
-  hashToBucket(Handle<OrderedHashMap> self, Runtime &runtime, Handle<> key) {
-    auto hash = runtime.gcStableHashHermesValue(key);
-    assert(
-        (self->capacity_ & (self->capacity_ - 1)) == 0 &&
-        "capacity_ must be power of 2");
-    return hash & (self->capacity_ - 1);
+  /// \return the largest power of two number of buckets whose table fits in
+  /// a SegmentedArraySmall.
+  static constexpr uint32_t maxBuckets() {
+    uint32_t numBuckets = 1u << 31;
+    while (tableSize(numBuckets) > SegmentedArraySmall::maxElements())
+      numBuckets >>= 1;
+    return numBuckets;
   }
 
-  /// Remove a node from the linked list.
-  void removeLinkedListNode(Runtime &runtime, HashMapEntry *entry, GC &gc);
+  /// \return the slots of the entry at \p index.
+  static uint32_t keySlot(uint32_t index) {
+    return HEADER_SIZE + index * ENTRY_SIZE;
+  }
+  static uint32_t valueSlot(uint32_t index) {
+    return keySlot(index) + 1;
+  }
+  static uint32_t chainSlot(uint32_t index) {
+    return keySlot(index) + 2;
+  }
 
-  /// Lookup an entry with key as \p key in a given \p bucket.
-  HashMapEntry *
-  lookupInBucket(Runtime &runtime, uint32_t bucket, HermesValue key);
+  /// \return the slot of \p bucket in a table with \p numBuckets buckets.
+  static uint32_t bucketSlot(uint32_t numBuckets, uint32_t bucket) {
+    return keySlot(numBuckets * ENTRIES_PER_BUCKET) + bucket;
+  }
 
-  /// Adjust the capacity of the hashtable and rehash if necessary.
-  /// We make decisions based on the Load Factor (size / capacity).
-  /// Rehash if load factor is outside of the range of [0.25, 0.75].
-  static ExecutionStatus rehashIfNecessary(
-      Handle<OrderedHashMap> self,
-      Runtime &runtime);
+  /// \return the number of entries that fit in the current table.
+  uint32_t entryCapacity() const {
+    return numBuckets_ * ENTRIES_PER_BUCKET;
+  }
+
+  /// Hash a HermesValue to be reduced to a bucket.
+  static uint32_t hash(Runtime &runtime, Handle<> key) {
+    return runtime.gcStableHashHermesValue(key);
+  }
+
+  /// Encode an entry index to be stored in a table. Like any number, this
+  /// may allocate.
+  static SmallHermesValue encodeIndex(Runtime &runtime, uint32_t index) {
+    return SmallHermesValue::encodeNumberValue(index, runtime);
+  }
+
+  /// Store \p index in \p slot of \p table.
+  static void setIndex(
+      Runtime &runtime,
+      Handle<SegmentedArraySmall> table,
+      uint32_t slot,
+      uint32_t index) {
+    SmallHermesValue shv = encodeIndex(runtime, index);
+    table->set(runtime, slot, shv);
+  }
+
+  /// Decode an entry index stored in a table.
+  static uint32_t decodeIndex(Runtime &runtime, SmallHermesValue index) {
+    return index.getNumber(runtime);
+  }
+
+  /// Value of lookup() when the key is not found.
+  static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+  /// Lookup an entry with key as \p key, whose hash is \p keyHash.
+  /// \return the index of the entry, or NOT_FOUND.
+  uint32_t lookup(Runtime &runtime, uint32_t keyHash, HermesValue key) const;
+
+  /// Replace the table with one of \p newBuckets buckets, containing only the
+  /// alive entries, and leave forwarding information in the old table.
+  static ExecutionStatus
+  rehash(Handle<OrderedHashMap> self, Runtime &runtime, uint32_t newBuckets);
 }; // OrderedHashMap
 } // namespace vm
 } // namespace hermes
@@ -865,6 +865,11 @@ class Runtime : public PointerBase,
     return vmExperimentFlags_;
   }
 
+  /// \return the maximum number of frames recorded in an Error's stack trace.
+  uint32_t getErrorStackTraceLimit() const {
+    return errorStackTraceLimit_;
+  }
+
   // Return a reference to the runtime's CrashManager.
   inline CrashManager &getCrashManager();
 
@@ -1127,6 +1132,9 @@ class Runtime : public PointerBase,
   // Signal-based I/O tracking. Slows down execution.
   const bool trackIO_;
 
+  /// Maximum number of frames recorded in an Error's stack trace.
+  const uint32_t errorStackTraceLimit_;
+
   // Whether we are currently formatting a stack trace. Used to break recursion
   // in Error.prepareStackTrace.
   bool formattingStackTrace_{false};
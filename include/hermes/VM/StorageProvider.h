@@ -30,7 +30,20 @@ class StorageProvider {
   static std::unique_ptr<StorageProvider> mmapProvider();
 
   /// Provide storage from a contiguous mmap'ed region.
-  static std::unique_ptr<StorageProvider> contiguousVAProvider(size_t size);
+  /// \param hugePages If true, each storage is advised to be backed by
+  ///   transparent huge pages when it is committed.
+  /// \param numaLocal If true, each storage is placed on the NUMA node of the
+  ///   thread that allocates it.
+  static std::unique_ptr<StorageProvider> contiguousVAProvider(
+      size_t size,
+      bool hugePages = false,
+      bool numaLocal = false);
+
+  /// Provide storage from mmap'ed separate regions, reusing storage freed by
+  /// other pooled providers in this process. Deleted storage is returned to
+  /// the OS lazily, and kept in a process-wide pool as long as the pool holds
+  /// fewer than \p maxPooled storages.
+  static std::unique_ptr<StorageProvider> pooledProvider(size_t maxPooled);
 
   /// Provide storage via malloc.
   static std::unique_ptr<StorageProvider> mallocProvider();
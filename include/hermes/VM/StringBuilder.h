@@ -9,6 +9,7 @@
 #define HERMES_VM_STRINGBUILDER_H
 
 #include "hermes/ADT/SafeInt.h"
+#include "hermes/Support/UTF8.h"
 #include "hermes/VM/Casting.h"
 #include "hermes/VM/Runtime.h"
 #include "hermes/VM/StringPrimitive.h"
@@ -97,6 +98,22 @@ class StringBuilder {
     index_ += ascii.size();
   }
 
+  /// Append \p ascii, converting letters to upper case if \p upper is true, or
+  /// to lower case otherwise.
+  /// \pre The string being built is ASCII.
+  void appendASCIIRefConvertingCase(ASCIIRef ascii, bool upper) {
+    assert(
+        index_ + ascii.size() <= strPrim_->getStringLength() &&
+        "StringBuilder append out of bound");
+    assert(strPrim_->isASCII() && "string being built must be ASCII");
+    convertASCIICase(
+        ascii.begin(),
+        ascii.end(),
+        strPrim_->castToASCIIPointerForWrite() + index_,
+        upper);
+    index_ += ascii.size();
+  }
+
   /// Append a char16_t character \p ch.
   void appendCharacter(char16_t ch) {
     assert(
@@ -39,6 +39,10 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   friend class StringView;
   template <typename T>
   friend class BufferedStringPrimitive;
+  template <typename T>
+  friend class RopeStringPrimitive;
+  template <typename T>
+  friend class SlicedStringPrimitive;
 
   friend llvh::raw_ostream &operator<<(
       llvh::raw_ostream &OS,
@@ -134,6 +138,19 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   static constexpr uint32_t CONCAT_STRING_MIN_SIZE =
       std::max(256u, EXTERNAL_STRING_MIN_SIZE);
 
+  /// A concatenation of at least CONCAT_STRING_MIN_SIZE characters whose right
+  /// operand has at least this many characters creates a
+  /// RopeStringPrimitive, unless it can append to a concatenation buffer.
+  static constexpr uint32_t ROPE_MIN_RIGHT_LENGTH = 64;
+
+  /// The maximum depth of a RopeStringPrimitive. Concatenations that would
+  /// exceed it copy the characters instead.
+  static constexpr uint32_t MAX_ROPE_DEPTH = 128;
+
+  /// Slices of at least this many characters create a SlicedStringPrimitive
+  /// that shares the characters of the original string.
+  static constexpr uint32_t SLICED_STRING_MIN_LENGTH = 32;
+
   static bool classof(const GCCell *cell) {
     return kindInRange(
         cell->getKind(),
@@ -257,18 +274,11 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   /// Flatten the string if it's a rope, possibly causing allocation/GC.
   static Handle<StringPrimitive> ensureFlat(
       Runtime &runtime,
-      Handle<StringPrimitive> self) {
-    // In the future, ensureFlat may trigger GC as it might allocate for
-    // ropes. Move the heap here.
-    runtime.potentiallyMoveHeap();
-    return self;
-    // TODO: Deal with different subclasses (e.g. rope)
-  }
+      Handle<StringPrimitive> self);
 
-  /// \return true if the string is flat.
-  bool isFlat() const {
-    return true;
-  }
+  /// \return true if the characters of the string can be accessed without
+  /// copying them first, i.e. it is not a rope that hasn't been flattened.
+  inline bool isFlat() const;
 
   /// \return a StringView of this string. In the case of a rope, we will need
   /// to resolve the rope, which might involve object allocations.
@@ -774,6 +784,228 @@ inline bool isBufferedStringPrimitive(const GCCell *cell) {
       cell->getKind() == CellKind::BufferedASCIIStringPrimitiveKind;
 }
 
+/// An immutable JavaScript primitive representing the concatenation of two
+/// other StringPrimitives, without copying their characters. It is created by
+/// concatenations that cannot append to a concatenation buffer, such as
+/// prepending to a long string or joining long strings in a tree shape, which
+/// would otherwise copy both operands every time.
+///
+/// The characters are copied into a flat buffer the first time they are
+/// accessed, and the buffer is kept for later accesses. That may happen in any
+/// of the raw accessors, which cannot allocate in the JS heap, so the buffer
+/// is malloc'ed and freed by the finalizer. It is reported through the malloc
+/// size of the cell. Flattening with \c StringPrimitive::ensureFlat() also
+/// drops the references to the operands, so that they can be collected.
+///
+/// A rope is ASCII only if both of its operands are. Its depth is limited to
+/// \c MAX_ROPE_DEPTH, and flattening walks it without recursion.
+template <typename T>
+class RopeStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  template <typename U>
+  friend class RopeStringPrimitive;
+  friend void RopeASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void RopeUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::RopeUTF16StringPrimitiveKind
+        : CellKind::RopeASCIIStringPrimitiveKind;
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == RopeStringPrimitive::getCellKind();
+  }
+
+ private:
+  static const VTable vt;
+
+ public:
+  /// Construct the concatenation of \p left and \p right, whose combined
+  /// length must have been validated.
+  RopeStringPrimitive(
+      Runtime &runtime,
+      Handle<StringPrimitive> left,
+      Handle<StringPrimitive> right,
+      uint32_t depth)
+      : StringPrimitive(left->getStringLength() + right->getStringLength()),
+        depth_(depth) {
+    leftHV_.set(left.getHermesValue(), runtime.getHeap());
+    rightHV_.set(right.getHermesValue(), runtime.getHeap());
+  }
+
+  /// Allocate the concatenation of \p left and \p right.
+  /// \pre The combined length must have been validated, the depth of the
+  /// result must not exceed MAX_ROPE_DEPTH, and if T is char, both operands
+  /// must be ASCII.
+  static PseudoHandle<StringPrimitive> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> left,
+      Handle<StringPrimitive> right);
+
+  /// \return the depth of the rope \p str, or 0 if it is not a rope.
+  static uint32_t getDepth(const StringPrimitive *str);
+
+  /// \return whether the characters have been copied into a flat buffer.
+  bool isFlattened() const {
+    return flat_ != nullptr;
+  }
+
+  /// \return the left operand of the concatenation.
+  /// \pre The rope has not been flattened.
+  StringPrimitive *getLeft() const {
+    assert(!isFlattened() && "operands may have been released");
+    return vmcast<StringPrimitive>(leftHV_);
+  }
+
+  /// \return the right operand of the concatenation.
+  /// \pre The rope has not been flattened.
+  StringPrimitive *getRight() const {
+    assert(!isFlattened() && "operands may have been released");
+    return vmcast<StringPrimitive>(rightHV_);
+  }
+
+ private:
+  /// \return a const pointer to the first character of the string, copying
+  /// the characters into a flat buffer if that hasn't happened yet.
+  const T *getRawPointer() const {
+    if (LLVM_UNLIKELY(!flat_))
+      flatten();
+    return flat_;
+  }
+
+  /// Copy the characters of the operands into flat_.
+  void flatten() const;
+
+  /// Flatten the rope if needed, and drop the references to the operands.
+  void flattenAndReleaseOperands(GC &gc);
+
+  /// Finalizer to free the flat buffer.
+  static void _finalizeImpl(GCCell *cell, GC &gc);
+
+  /// \return the size of the flat buffer of \p cell.
+  static size_t _mallocSizeImpl(GCCell *cell);
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  static void _snapshotAddEdgesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+  static void _snapshotAddNodesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+#endif
+
+  /// The operands of the concatenation, or undefined once they have been
+  /// released. As in BufferedStringPrimitive, these are GCHermesValues so
+  /// that they can be read without a PointerBase.
+  GCHermesValue leftHV_;
+  GCHermesValue rightHV_;
+
+  /// The depth of this rope: one more than the depth of its deepest operand.
+  uint32_t depth_;
+
+  /// The characters of the string once it has been flattened, or null.
+  mutable T *flat_{nullptr};
+};
+
+/// \return true if this is one of the RopeStringPrimitive classes.
+inline bool isRopeStringPrimitive(const GCCell *cell) {
+  return cell->getKind() == CellKind::RopeUTF16StringPrimitiveKind ||
+      cell->getKind() == CellKind::RopeASCIIStringPrimitiveKind;
+}
+
+/// An immutable JavaScript primitive representing a range of the characters of
+/// another StringPrimitive, its parent, without copying them. It is created by
+/// StringPrimitive::slice() for ranges of at least SLICED_STRING_MIN_LENGTH
+/// characters, so that substrings and regexp matches taken from a large
+/// string don't duplicate its characters.
+///
+/// The parent is never itself a slice, and the characters are read from it on
+/// every access, so they may move with it. A slice keeps its whole parent
+/// alive: a short slice of a string that is otherwise garbage retains all of
+/// its characters.
+template <typename T>
+class SlicedStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  friend void SlicedASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void SlicedUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::SlicedUTF16StringPrimitiveKind
+        : CellKind::SlicedASCIIStringPrimitiveKind;
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == SlicedStringPrimitive::getCellKind();
+  }
+
+ private:
+  static const VTable vt;
+
+ public:
+  /// Construct the slice [start, start + length) of \p parent.
+  SlicedStringPrimitive(
+      Runtime &runtime,
+      Handle<StringPrimitive> parent,
+      uint32_t start,
+      uint32_t length)
+      : StringPrimitive(length), offset_(start) {
+    parentHV_.set(parent.getHermesValue(), runtime.getHeap());
+  }
+
+  /// Allocate the slice [start, start + length) of \p str, which must have
+  /// characters of type T. If \p str is itself a slice, the result refers to
+  /// its parent instead.
+  static PseudoHandle<StringPrimitive> create(
+      Runtime &runtime,
+      Handle<StringPrimitive> str,
+      uint32_t start,
+      uint32_t length);
+
+  /// \return the string whose characters this slice refers to.
+  StringPrimitive *getParent() const {
+    return vmcast<StringPrimitive>(parentHV_);
+  }
+
+  /// \return the offset of the first character of this slice in its parent.
+  uint32_t getOffset() const {
+    return offset_;
+  }
+
+ private:
+  /// \return a const pointer to the first character of the string.
+  const T *getRawPointer() const {
+    return getParent()->template castToPointer<T>() + offset_;
+  }
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+  static void _snapshotAddEdgesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+  static void _snapshotAddNodesImpl(GCCell *cell, GC &gc, HeapSnapshot &snap);
+#endif
+
+  /// The string containing the characters. As in BufferedStringPrimitive, this
+  /// is a GCHermesValue so that it can be read without a PointerBase.
+  GCHermesValue parentHV_;
+
+  /// The offset of the first character of this slice in the parent.
+  uint32_t offset_;
+};
+
+/// \return true if this is one of the SlicedStringPrimitive classes.
+inline bool isSlicedStringPrimitive(const GCCell *cell) {
+  return cell->getKind() == CellKind::SlicedUTF16StringPrimitiveKind ||
+      cell->getKind() == CellKind::SlicedASCIIStringPrimitiveKind;
+}
+
 /// This function is not part of the API and is not supposed to be called
 /// directly. It is used internally by StringPrimitive::concat. It is used
 /// to handle the case when the result string exceeds the minimal length for
@@ -862,6 +1094,50 @@ const VTable BufferedStringPrimitive<T>::vt = VTable(
 using BufferedUTF16StringPrimitive = BufferedStringPrimitive<char16_t>;
 using BufferedASCIIStringPrimitive = BufferedStringPrimitive<char>;
 
+template <typename T>
+const VTable RopeStringPrimitive<T>::vt = VTable(
+    RopeStringPrimitive<T>::getCellKind(),
+    0,
+    RopeStringPrimitive<T>::_finalizeImpl,
+    nullptr, // markWeak.
+    RopeStringPrimitive<T>::_mallocSizeImpl,
+    nullptr
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+    ,
+    VTable::HeapSnapshotMetadata {
+      HeapSnapshot::NodeType::String,
+          RopeStringPrimitive<T>::_snapshotNameImpl,
+          RopeStringPrimitive<T>::_snapshotAddEdgesImpl,
+          RopeStringPrimitive<T>::_snapshotAddNodesImpl, nullptr
+    }
+#endif
+);
+
+using RopeUTF16StringPrimitive = RopeStringPrimitive<char16_t>;
+using RopeASCIIStringPrimitive = RopeStringPrimitive<char>;
+
+template <typename T>
+const VTable SlicedStringPrimitive<T>::vt = VTable(
+    SlicedStringPrimitive<T>::getCellKind(),
+    0,
+    nullptr, // finalize.
+    nullptr, // markWeak.
+    nullptr, // mallocSize.
+    nullptr
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+    ,
+    VTable::HeapSnapshotMetadata {
+      HeapSnapshot::NodeType::String,
+          SlicedStringPrimitive<T>::_snapshotNameImpl,
+          SlicedStringPrimitive<T>::_snapshotAddEdgesImpl,
+          SlicedStringPrimitive<T>::_snapshotAddNodesImpl, nullptr
+    }
+#endif
+);
+
+using SlicedUTF16StringPrimitive = SlicedStringPrimitive<char16_t>;
+using SlicedASCIIStringPrimitive = SlicedStringPrimitive<char>;
+
 //===----------------------------------------------------------------------===//
 // StringPrimitive inline methods.
 
@@ -874,6 +1150,13 @@ inline llvh::raw_ostream &operator<<(
   return OS << str->castToUTF16Ref();
 }
 
+inline bool StringPrimitive::isFlat() const {
+  if (LLVM_LIKELY(!isRopeStringPrimitive(this)))
+    return true;
+  return isASCII() ? vmcast<RopeASCIIStringPrimitive>(this)->isFlattened()
+                   : vmcast<RopeUTF16StringPrimitive>(this)->isFlattened();
+}
+
 /*static*/ inline Handle<StringPrimitive> StringPrimitive::createNoThrow(
     Runtime &runtime,
     UTF16Ref str) {
@@ -999,8 +1282,12 @@ inline const char *StringPrimitive::castToASCIIPointer() const {
     return vmcast<DynamicUniquedASCIIStringPrimitive>(this)->getRawPointer();
   } else if (vmisa<DynamicASCIIStringPrimitive>(this)) {
     return vmcast<DynamicASCIIStringPrimitive>(this)->getRawPointer();
-  } else {
+  } else if (vmisa<BufferedASCIIStringPrimitive>(this)) {
     return vmcast<BufferedASCIIStringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<SlicedASCIIStringPrimitive>(this)) {
+    return vmcast<SlicedASCIIStringPrimitive>(this)->getRawPointer();
+  } else {
+    return vmcast<RopeASCIIStringPrimitive>(this)->getRawPointer();
   }
 }
 
@@ -1011,8 +1298,12 @@ inline const char16_t *StringPrimitive::castToUTF16Pointer() const {
     return vmcast<DynamicUniquedUTF16StringPrimitive>(this)->getRawPointer();
   } else if (vmisa<DynamicUTF16StringPrimitive>(this)) {
     return vmcast<DynamicUTF16StringPrimitive>(this)->getRawPointer();
-  } else {
+  } else if (vmisa<BufferedUTF16StringPrimitive>(this)) {
     return vmcast<BufferedUTF16StringPrimitive>(this)->getRawPointer();
+  } else if (vmisa<SlicedUTF16StringPrimitive>(this)) {
+    return vmcast<SlicedUTF16StringPrimitive>(this)->getRawPointer();
+  } else {
+    return vmcast<RopeUTF16StringPrimitive>(this)->getRawPointer();
   }
 }
 
@@ -1066,6 +1357,10 @@ inline bool StringPrimitive::isASCII() const {
           CellKind::DynamicASCIIStringPrimitiveKind,
           CellKind::BufferedUTF16StringPrimitiveKind,
           CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::RopeUTF16StringPrimitiveKind,
+          CellKind::RopeASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind,
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
@@ -1085,6 +1380,10 @@ inline bool StringPrimitive::isExternal() const {
           CellKind::DynamicASCIIStringPrimitiveKind,
           CellKind::BufferedUTF16StringPrimitiveKind,
           CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::RopeUTF16StringPrimitiveKind,
+          CellKind::RopeASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind,
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
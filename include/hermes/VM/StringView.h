@@ -9,6 +9,7 @@
 #define HERMES_VM_STRINGVIEW_H
 
 #include "SmallXString.h"
+#include "hermes/Support/OptValue.h"
 #include "hermes/VM/Runtime.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "hermes/VM/StringRefUtils.h"
@@ -375,6 +376,14 @@ class StringView {
     return stringRefEquals(UTF16Ref(castToChar16Ptr(), length()), other);
   }
 
+  /// \return the index of the first occurrence of \p needle in this string,
+  /// or None if there is none. An empty needle matches at index 0.
+  OptValue<uint32_t> find(const StringView &needle) const;
+
+  /// \return the index of the last occurrence of \p needle in this string,
+  /// or None if there is none. An empty needle matches at the end.
+  OptValue<uint32_t> findLast(const StringView &needle) const;
+
   TwineChar16 toTwine() const {
     if (isASCII()) {
       return TwineChar16(llvh::StringRef(castToCharPtr(), length()));
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef HERMES_VM_UNBOXEDARRAYSTORAGE_H
+#define HERMES_VM_UNBOXEDARRAYSTORAGE_H
+
+#include "hermes/VM/Runtime.h"
+
+#include "llvh/Support/TrailingObjects.h"
+
+namespace hermes {
+namespace vm {
+
+/// A GC-managed resizable vector of unboxed numbers of type \p T. It holds the
+/// elements of arrays whose elements are all of that type (see
+/// ArrayImpl::ElementKind). It contains no pointers, so the GC never has to
+/// scan its contents, and storing a double doesn't allocate.
+template <typename T>
+class UnboxedArrayStorage final
+    : public VariableSizeRuntimeCell,
+      private llvh::TrailingObjects<UnboxedArrayStorage<T>, T> {
+  friend llvh::TrailingObjects<UnboxedArrayStorage<T>, T>;
+  friend void ArrayStorageInt32BuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void ArrayStorageDoubleBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+ public:
+  using size_type = uint32_t;
+  using value_type = T;
+
+  static const VTable vt;
+
+  /// Gets the amount of memory used by this object for a given \p capacity.
+  static constexpr uint32_t allocationSize(size_type capacity) {
+    return UnboxedArrayStorage::template totalSizeToAlloc<T>(capacity);
+  }
+
+  /// \return The the maximum number of elements that will fit in an
+  /// UnboxedArrayStorage with allocated size \p allocSize.
+  static constexpr size_type capacityForAllocationSize(uint32_t allocSize) {
+    return (allocSize - allocationSize(0)) / sizeof(T);
+  }
+
+  /// \return The maximum number of elements we can fit in a single array in the
+  /// current GC.
+  static constexpr size_type maxElements() {
+    return capacityForAllocationSize(GC::maxAllocationSize());
+  }
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == getCellKind();
+  }
+
+  static constexpr CellKind getCellKind() {
+    static_assert(
+        std::is_same<T, int32_t>::value || std::is_same<T, double>::value,
+        "Illegal element type.");
+    return std::is_same<T, int32_t>::value ? CellKind::ArrayStorageInt32Kind
+                                           : CellKind::ArrayStorageDoubleKind;
+  }
+
+  /// Create a new empty instance with at least the specified \p capacity,
+  /// which must not exceed maxElements().
+  static UnboxedArrayStorage *create(Runtime &runtime, size_type capacity) {
+    assert(capacity <= maxElements() && "capacity is too large");
+    return runtime.makeAVariable<UnboxedArrayStorage>(
+        allocationSize(capacity));
+  }
+
+  /// \return a pointer to the underlying data storage.
+  T *data() {
+    return this->template getTrailingObjects<T>();
+  }
+  const T *data() const {
+    return this->template getTrailingObjects<T>();
+  }
+
+  /// \return the element at index \p index.
+  T at(size_type index) const {
+    assert(index < size() && "index out of range");
+    return data()[index];
+  }
+
+  /// Set the element at index \p index to \p val.
+  void set(size_type index, T val) {
+    assert(index < size() && "index out of range");
+    data()[index] = val;
+  }
+
+  size_type capacity() const {
+    return capacityForAllocationSize(getAllocatedSize());
+  }
+  size_type size() const {
+    return size_;
+  }
+
+  /// Set the size to a value <= the capacity. Elements added this way are
+  /// uninitialized, and must be set before they are read.
+  void resizeWithinCapacity(size_type newSize) {
+    assert(newSize <= capacity() && "newSize overflows capacity");
+    size_ = newSize;
+  }
+
+  /// Append \p val to the end (increasing size by 1), reallocating if the
+  /// capacity is exhausted. The size must be less than maxElements().
+  static void push_back(
+      MutableHandle<UnboxedArrayStorage> &selfHandle,
+      Runtime &runtime,
+      T val) {
+    const size_type sz = selfHandle->size();
+    if (LLVM_UNLIKELY(sz == selfHandle->capacity()))
+      grow(selfHandle, runtime);
+    selfHandle->size_ = sz + 1;
+    selfHandle->data()[sz] = val;
+  }
+
+  UnboxedArrayStorage() = default;
+  UnboxedArrayStorage(const UnboxedArrayStorage &) = delete;
+  void operator=(const UnboxedArrayStorage &) = delete;
+  ~UnboxedArrayStorage() = delete;
+
+ private:
+  /// Reallocate to a larger capacity, keeping the elements.
+  static void grow(
+      MutableHandle<UnboxedArrayStorage> &selfHandle,
+      Runtime &runtime);
+
+  /// The number of elements in use.
+  size_type size_{0};
+};
+
+using ArrayStorageInt32 = UnboxedArrayStorage<int32_t>;
+using ArrayStorageDouble = UnboxedArrayStorage<double>;
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_UNBOXEDARRAYSTORAGE_H
@@ -177,7 +177,52 @@ ExceptionEntryList hermes::generateExceptionHandlers(
   // Sort ranges by depth. In hermes, depth increase when you nest try inside
   // try/catch/finally.
   std::sort(exception_entries.begin(), exception_entries.end());
-  return exception_entries;
+  return flattenExceptionHandlers(exception_entries);
+}
+
+ExceptionEntryList hermes::flattenExceptionHandlers(
+    const ExceptionEntryList &entries) {
+  if (entries.size() < 2)
+    return entries;
+
+  // Split the covered offsets into elementary intervals at every boundary.
+  llvh::SmallVector<uint32_t, 8> points;
+  for (const auto &entry : entries) {
+    points.push_back(entry.start);
+    points.push_back(entry.end);
+  }
+  std::sort(points.begin(), points.end());
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+
+  // Assign each elementary interval to the first entry covering it. Since the
+  // entries are sorted by decreasing depth, that is the innermost handler.
+  static constexpr uint32_t kUnassigned = UINT32_MAX;
+  llvh::SmallVector<uint32_t, 8> owner(points.size() - 1, kUnassigned);
+  for (uint32_t i = 0, e = entries.size(); i < e; ++i) {
+    auto it = std::lower_bound(points.begin(), points.end(), entries[i].start);
+    for (size_t idx = it - points.begin();
+         idx + 1 < points.size() && points[idx] < entries[i].end;
+         ++idx) {
+      if (owner[idx] == kUnassigned)
+        owner[idx] = i;
+    }
+  }
+
+  // Emit the intervals in offset order, merging adjacent intervals which
+  // resolve to the same handler.
+  ExceptionEntryList result;
+  for (size_t idx = 0, e = owner.size(); idx < e; ++idx) {
+    if (owner[idx] == kUnassigned)
+      continue;
+    const auto &entry = entries[owner[idx]];
+    if (!result.empty() && result.back().end == points[idx] &&
+        result.back().target == entry.target) {
+      result.back().end = points[idx + 1];
+      continue;
+    }
+    result.push_back({points[idx], points[idx + 1], entry.target, entry.depth});
+  }
+  return result;
 }
 
 #undef DEBUG_TYPE
@@ -13,6 +13,8 @@
 #include "llvh/Support/MathExtras.h"
 #include "llvh/Support/SHA1.h"
 
+#include <algorithm>
+
 namespace hermes {
 namespace hbc {
 
@@ -329,11 +331,17 @@ int32_t BCProviderBase::findCatchTargetOffset(
     uint32_t functionID,
     uint32_t exceptionOffset) const {
   auto exceptions = getExceptionTable(functionID);
-  for (unsigned i = 0, e = exceptions.size(); i < e; ++i) {
-    if (exceptions[i].start <= exceptionOffset &&
-        exceptionOffset < exceptions[i].end) {
-      return exceptions[i].target;
-    }
+  // The table is sorted by start offset and its ranges are disjoint, so the
+  // only candidate is the last entry starting at or before the offset.
+  auto it = std::upper_bound(
+      exceptions.begin(),
+      exceptions.end(),
+      exceptionOffset,
+      [](uint32_t offset, const hbc::HBCExceptionHandlerInfo &entry) {
+        return offset < entry.start;
+      });
+  if (it != exceptions.begin() && exceptionOffset < (--it)->end) {
+    return it->target;
   }
   // No handler is found.
   return -1;
@@ -8,6 +8,7 @@
 #include "hermes/Regex/Executor.h"
 #include "hermes/Regex/RegexTraits.h"
 #include "hermes/Support/OptValue.h"
+#include "hermes/Support/StringSearch.h"
 
 #include "llvh/ADT/SmallVector.h"
 #include "llvh/Support/TrailingObjects.h"
@@ -246,6 +247,97 @@ class Cursor {
   bool forwards_;
 };
 
+/// The threads of the Pike VM at one input position, in order of priority.
+/// A thread is identified by its instruction offset in the Pike VM program:
+/// without backreferences, what a thread can go on to match only depends on
+/// its offset and the input position, so of two threads reaching the same
+/// offset only the one with higher priority is kept. Offsets of instructions
+/// that don't consume input are recorded too, so that computing the threads
+/// reachable from an instruction visits each instruction once.
+class PikeThreadList {
+  /// Maps an offset to its index in visited_, if it has been visited.
+  std::vector<uint32_t> sparse_;
+
+  /// The offsets visited at this position.
+  std::vector<uint32_t> visited_;
+
+  /// The offsets of the threads, which are consuming or Goal instructions.
+  std::vector<uint32_t> threads_;
+
+  /// The capture groups of each thread, with stride_ ranges per thread. The
+  /// first range holds the start of the match.
+  std::vector<CapturedRange> captures_;
+
+  /// Number of ranges per thread.
+  const uint32_t stride_;
+
+ public:
+  PikeThreadList(uint32_t programSize, uint32_t stride)
+      : sparse_(programSize), stride_(stride) {}
+
+  /// Mark the offset \p pc as visited.
+  /// \return false if it had already been visited.
+  bool visit(uint32_t pc) {
+    uint32_t idx = sparse_[pc];
+    if (idx < visited_.size() && visited_[idx] == pc)
+      return false;
+    sparse_[pc] = visited_.size();
+    visited_.push_back(pc);
+    return true;
+  }
+
+  /// Add a thread at offset \p pc with the capture groups \p captures, at a
+  /// lower priority than the existing threads.
+  void addThread(uint32_t pc, const CapturedRange *captures) {
+    threads_.push_back(pc);
+    captures_.insert(captures_.end(), captures, captures + stride_);
+  }
+
+  /// \return the number of threads.
+  size_t size() const {
+    return threads_.size();
+  }
+
+  /// \return whether there are no threads.
+  bool empty() const {
+    return threads_.empty();
+  }
+
+  /// \return the offset of the thread at index \p idx.
+  uint32_t pc(size_t idx) const {
+    return threads_[idx];
+  }
+
+  /// \return the capture groups of the thread at index \p idx.
+  const CapturedRange *captures(size_t idx) const {
+    return &captures_[idx * stride_];
+  }
+
+  /// Remove all threads and visited offsets.
+  void clear() {
+    visited_.clear();
+    threads_.clear();
+    captures_.clear();
+  }
+};
+
+/// A pending step in computing the threads reachable from an instruction.
+/// Either explore the instruction at pc, or restore the capture group at slot
+/// to range after the exploration of a higher priority branch.
+struct PikeFrame {
+  bool restore;
+  uint32_t pc;
+  uint32_t slot;
+  CapturedRange range;
+
+  static PikeFrame explore(uint32_t pc) {
+    return {false, pc, 0, {kNotMatched, kNotMatched}};
+  }
+  static PikeFrame restoreCapture(uint32_t slot, CapturedRange range) {
+    return {true, 0, slot, range};
+  }
+};
+
 /// A Context records global information about a match attempt.
 template <class Traits>
 struct Context {
@@ -429,6 +521,19 @@ struct Context {
       State<Traits> *state,
       bool onlyAtStart);
 
+  /// Run the Pike VM program \p program, a bytecode stream with its own
+  /// header, starting at \p start. If \p onlyAtStart is set, only find a match
+  /// starting at \p start; otherwise find the first match starting at or
+  /// after it. All threads advance through the input together, so this takes
+  /// time linear in the length of the input.
+  /// \return whether a match was found. If so, populates \p captures with the
+  /// range of the match followed by the capture groups.
+  bool matchPike(
+      llvh::ArrayRef<uint8_t> program,
+      const CodeUnit *start,
+      bool onlyAtStart,
+      std::vector<CapturedRange> &captures);
+
   /// Backtrack the given state \p s with the backtrack stack \p bts.
   /// \return true if we backtracked, false if we exhausted the stack.
   LLVM_NODISCARD
@@ -504,6 +609,37 @@ struct Context {
       const CodeUnit *start,
       size_t index,
       size_t lastIndex) const;
+
+  /// \return the smallest index not less than \p index at which a match may
+  /// start in the string \p start of length \p length, according to the
+  /// prefilter in the bytecode header, or \p length + 1 if there is none.
+  size_t skipToPrefilterCandidate(
+      const CodeUnit *start,
+      size_t index,
+      size_t length) const;
+
+  /// Add to \p list the threads reachable without consuming input from the
+  /// instruction at offset \p pc of the Pike VM instructions \p program, at
+  /// the input position \p pos, with the capture groups \p captures. The
+  /// captures are modified along the way but restored before returning.
+  /// \p stack is scratch space.
+  void addPikeThreads(
+      const uint8_t *program,
+      PikeThreadList &list,
+      uint32_t pc,
+      CapturedRange *captures,
+      const CodeUnit *pos,
+      llvh::SmallVectorImpl<PikeFrame> &stack) const;
+
+  /// \return the size of the consuming Pike VM instruction \p base if it
+  /// matches the character at the current position, or 0 if it doesn't. The
+  /// character is the code unit \p c, and \p cp is the code point decoded
+  /// there, which is \p width code units long.
+  inline uint32_t matchPikeInsn(
+      const Insn *base,
+      CodeUnit c,
+      CodePoint cp,
+      uint32_t width) const;
 };
 
 /// We store loop and captured range data contiguously in a single allocation at
@@ -567,9 +703,8 @@ bool isLineTerminator(CharT c) {
 }
 
 template <class Traits>
-bool matchesLeftAnchor(Context<Traits> &ctx, State<Traits> &s) {
+bool matchesLeftAnchor(const Context<Traits> &ctx, const Cursor<Traits> &c) {
   bool matchesAnchor = false;
-  const Cursor<Traits> &c = s.cursor_;
   if (c.atLeft()) {
     // Beginning of text.
     matchesAnchor = true;
@@ -583,9 +718,8 @@ bool matchesLeftAnchor(Context<Traits> &ctx, State<Traits> &s) {
 }
 
 template <class Traits>
-bool matchesRightAnchor(Context<Traits> &ctx, State<Traits> &s) {
+bool matchesRightAnchor(const Context<Traits> &ctx, const Cursor<Traits> &c) {
   bool matchesAnchor = false;
-  const Cursor<Traits> &c = s.cursor_;
   if (c.atRight() && !(ctx.flags_ & constants::matchNotEndOfLine)) {
     matchesAnchor = true;
   } else if (
@@ -596,6 +730,29 @@ bool matchesRightAnchor(Context<Traits> &ctx, State<Traits> &s) {
   return matchesAnchor;
 }
 
+/// \return whether the cursor \p c is at a word boundary, or not at one if
+/// \p invert is set.
+template <class Traits>
+bool matchesWordBoundary(
+    const Context<Traits> &ctx,
+    const Cursor<Traits> &c,
+    bool invert) {
+  const auto *charPointer = c.currentPointer();
+
+  bool prevIsWordchar = false;
+  if (!c.atLeft())
+    prevIsWordchar =
+        ctx.traits_.characterHasType(charPointer[-1], CharacterClass::Words);
+
+  bool currentIsWordchar = false;
+  if (!c.atRight())
+    currentIsWordchar =
+        ctx.traits_.characterHasType(charPointer[0], CharacterClass::Words);
+
+  bool isWordBoundary = (prevIsWordchar != currentIsWordchar);
+  return isWordBoundary ^ invert;
+}
+
 /// \return true if all chars, stored in contiguous memory after \p insn,
 /// match the chars in state \p s in the same order. Note the count of chars
 /// is given in \p insn.
@@ -958,6 +1115,32 @@ inline size_t Context<Traits>::advanceStringIndex(
   return index + 2;
 }
 
+template <class Traits>
+size_t Context<Traits>::skipToPrefilterCandidate(
+    const CodeUnit *start,
+    size_t index,
+    size_t length) const {
+  auto header =
+      reinterpret_cast<const RegexBytecodeHeader *>(bytecodeStream_.data());
+  llvh::ArrayRef<CodeUnit> haystack{start + index, length - index};
+  llvh::ArrayRef<char16_t> units{header->prefilter, header->prefilterLength};
+  OptValue<uint32_t> found;
+  switch (static_cast<PrefilterKind>(header->prefilterKind)) {
+    case PrefilterKind::LiteralPrefix:
+      found = findSubstring(haystack, units);
+      break;
+    case PrefilterKind::FirstUnits:
+      found = findFirstOf(haystack, units);
+      break;
+    case PrefilterKind::None:
+    case PrefilterKind::RequiredSubstring:
+      return index;
+  }
+  // Prefilter units are never surrogates, so a candidate is never inside a
+  // surrogate pair and advanceStringIndex() would have reached it.
+  return found ? index + *found : length + 1;
+}
+
 template <class Traits>
 auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
     -> ExecutorResult<const CodeUnit *> {
@@ -990,6 +1173,15 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
       (c.forwards() || locsToCheckCount == 1) &&
       "Can only check one location when cursor is backwards");
 
+  // The prefilter describes where matches of the whole regex may start, so
+  // it can skip locations when we are searching for one.
+  const auto prefilterKind = static_cast<PrefilterKind>(
+      reinterpret_cast<const RegexBytecodeHeader *>(bytecodeStream_.data())
+          ->prefilterKind);
+  const bool usePrefilter = !onlyAtStart &&
+      (prefilterKind == PrefilterKind::LiteralPrefix ||
+       prefilterKind == PrefilterKind::FirstUnits);
+
   // Macro used when a state fails to match.
 #define BACKTRACK()                            \
   do {                                         \
@@ -1003,6 +1195,11 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
 
   for (size_t locIndex = 0; locIndex < locsToCheckCount;
        locIndex = advanceStringIndex(startLoc, locIndex, charsToRight)) {
+    if (usePrefilter) {
+      locIndex = skipToPrefilterCandidate(startLoc, locIndex, charsToRight);
+      if (locIndex >= locsToCheckCount)
+        break;
+    }
     const CodeUnit *potentialMatchLocation = startLoc + locIndex;
     c.setCurrentPointer(potentialMatchLocation);
     s->ip_ = startIp;
@@ -1014,13 +1211,13 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
           return potentialMatchLocation;
 
         case Opcode::LeftAnchor:
-          if (!matchesLeftAnchor(*this, *s))
+          if (!matchesLeftAnchor(*this, c))
             BACKTRACK();
           s->ip_ += sizeof(LeftAnchorInsn);
           break;
 
         case Opcode::RightAnchor:
-          if (!matchesRightAnchor(*this, *s))
+          if (!matchesRightAnchor(*this, c))
             BACKTRACK();
           s->ip_ += sizeof(RightAnchorInsn);
           break;
@@ -1179,20 +1376,7 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
 
         case Opcode::WordBoundary: {
           const WordBoundaryInsn *insn = llvh::cast<WordBoundaryInsn>(base);
-          const auto *charPointer = c.currentPointer();
-
-          bool prevIsWordchar = false;
-          if (!c.atLeft())
-            prevIsWordchar = traits_.characterHasType(
-                charPointer[-1], CharacterClass::Words);
-
-          bool currentIsWordchar = false;
-          if (!c.atRight())
-            currentIsWordchar =
-                traits_.characterHasType(charPointer[0], CharacterClass::Words);
-
-          bool isWordBoundary = (prevIsWordchar != currentIsWordchar);
-          if (isWordBoundary ^ insn->invert)
+          if (matchesWordBoundary(*this, c, insn->invert))
             s->ip_ += sizeof(WordBoundaryInsn);
           else
             BACKTRACK();
@@ -1490,6 +1674,9 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
             BACKTRACK();
           break;
         }
+
+        case Opcode::ClearCaptures:
+          llvm_unreachable("ClearCaptures only appears in Pike VM programs");
       }
     }
   // The search failed at this location.
@@ -1501,6 +1688,274 @@ auto Context<Traits>::match(State<Traits> *s, bool onlyAtStart)
   return nullptr;
 }
 
+template <class Traits>
+void Context<Traits>::addPikeThreads(
+    const uint8_t *program,
+    PikeThreadList &list,
+    uint32_t pc,
+    CapturedRange *captures,
+    const CodeUnit *pos,
+    llvh::SmallVectorImpl<PikeFrame> &stack) const {
+  const Cursor<Traits> c{first_, pos, last_, true /* forwards */};
+  const uint32_t offset = c.offsetFromLeft();
+  assert(stack.empty() && "Stack should be empty");
+  stack.push_back(PikeFrame::explore(pc));
+  while (!stack.empty()) {
+    PikeFrame frame = stack.pop_back_val();
+    if (frame.restore) {
+      captures[frame.slot] = frame.range;
+      continue;
+    }
+    // Follow the instructions until one fails, becomes a thread, or was
+    // already visited by a thread with higher priority. Capture groups are
+    // stored after the match range, hence the + 1.
+    bool live = true;
+    for (pc = frame.pc; live && list.visit(pc);) {
+      const Insn *base = reinterpret_cast<const Insn *>(&program[pc]);
+      switch (base->opcode) {
+        case Opcode::Jump32:
+          pc = llvh::cast<Jump32Insn>(base)->target;
+          break;
+
+        case Opcode::Alternation: {
+          // Explore the primary branch first. The secondary branch is pushed
+          // below the captures restored after the primary branch.
+          const auto *alt = llvh::cast<AlternationInsn>(base);
+          bool primaryViable =
+              c.satisfiesConstraints(flags_, alt->primaryConstraints);
+          bool secondaryViable =
+              c.satisfiesConstraints(flags_, alt->secondaryConstraints);
+          if (primaryViable && secondaryViable)
+            stack.push_back(PikeFrame::explore(alt->secondaryBranch));
+          if (primaryViable)
+            pc += sizeof(AlternationInsn);
+          else if (secondaryViable)
+            pc = alt->secondaryBranch;
+          else
+            live = false;
+          break;
+        }
+
+        case Opcode::BeginMarkedSubexpression: {
+          uint32_t slot =
+              llvh::cast<BeginMarkedSubexpressionInsn>(base)->mexp + 1;
+          stack.push_back(PikeFrame::restoreCapture(slot, captures[slot]));
+          captures[slot].start = offset;
+          pc += sizeof(BeginMarkedSubexpressionInsn);
+          break;
+        }
+
+        case Opcode::EndMarkedSubexpression: {
+          uint32_t slot =
+              llvh::cast<EndMarkedSubexpressionInsn>(base)->mexp + 1;
+          stack.push_back(PikeFrame::restoreCapture(slot, captures[slot]));
+          captures[slot].end = offset;
+          pc += sizeof(EndMarkedSubexpressionInsn);
+          break;
+        }
+
+        case Opcode::ClearCaptures: {
+          const auto *insn = llvh::cast<ClearCapturesInsn>(base);
+          for (uint32_t mexp = insn->mexpBegin; mexp != insn->mexpEnd; mexp++) {
+            stack.push_back(
+                PikeFrame::restoreCapture(mexp + 1, captures[mexp + 1]));
+            captures[mexp + 1] = {kNotMatched, kNotMatched};
+          }
+          pc += sizeof(ClearCapturesInsn);
+          break;
+        }
+
+        case Opcode::LeftAnchor:
+          live = matchesLeftAnchor(*this, c);
+          pc += sizeof(LeftAnchorInsn);
+          break;
+
+        case Opcode::RightAnchor:
+          live = matchesRightAnchor(*this, c);
+          pc += sizeof(RightAnchorInsn);
+          break;
+
+        case Opcode::WordBoundary:
+          live = matchesWordBoundary(
+              *this, c, llvh::cast<WordBoundaryInsn>(base)->invert);
+          pc += sizeof(WordBoundaryInsn);
+          break;
+
+        default:
+          // Goal and the instructions that consume input.
+          list.addThread(pc, captures);
+          live = false;
+          break;
+      }
+    }
+  }
+}
+
+template <class Traits>
+inline uint32_t Context<Traits>::matchPikeInsn(
+    const Insn *base,
+    CodeUnit c,
+    CodePoint cp,
+    uint32_t width) const {
+  // Instructions other than the U16 ones match a single code unit, which is
+  // never part of a surrogate pair when the U16 ones are in use.
+  switch (base->opcode) {
+    case Opcode::MatchChar8:
+      return width == 1 && matchWidth1<Width1Opcode::MatchChar8>(base, c)
+          ? sizeof(MatchChar8Insn)
+          : 0;
+    case Opcode::MatchChar16:
+      return width == 1 && matchWidth1<Width1Opcode::MatchChar16>(base, c)
+          ? sizeof(MatchChar16Insn)
+          : 0;
+    case Opcode::MatchCharICase8:
+      return width == 1 && matchWidth1<Width1Opcode::MatchCharICase8>(base, c)
+          ? sizeof(MatchCharICase8Insn)
+          : 0;
+    case Opcode::MatchCharICase16:
+      return width == 1 && matchWidth1<Width1Opcode::MatchCharICase16>(base, c)
+          ? sizeof(MatchCharICase16Insn)
+          : 0;
+    case Opcode::MatchAny:
+      return width == 1 ? sizeof(MatchAnyInsn) : 0;
+    case Opcode::MatchAnyButNewline:
+      return width == 1 &&
+              matchWidth1<Width1Opcode::MatchAnyButNewline>(base, c)
+          ? sizeof(MatchAnyButNewlineInsn)
+          : 0;
+    case Opcode::Bracket:
+      return width == 1 && matchWidth1<Width1Opcode::Bracket>(base, c)
+          ? llvh::cast<BracketInsn>(base)->totalWidth()
+          : 0;
+
+    case Opcode::U16MatchAny:
+      return sizeof(U16MatchAnyInsn);
+    case Opcode::U16MatchAnyButNewline:
+      return !isLineTerminator(cp) ? sizeof(U16MatchAnyButNewlineInsn) : 0;
+    case Opcode::U16MatchChar32:
+      return cp == (CodePoint)llvh::cast<U16MatchChar32Insn>(base)->c
+          ? sizeof(U16MatchChar32Insn)
+          : 0;
+    case Opcode::U16MatchCharICase32: {
+      const auto *insn = llvh::cast<U16MatchCharICase32Insn>(base);
+      return cp == (CodePoint)insn->c ||
+              traits_.canonicalize(cp, true) == (CodePoint)insn->c
+          ? sizeof(U16MatchCharICase32Insn)
+          : 0;
+    }
+    case Opcode::U16Bracket: {
+      const auto *insn = llvh::cast<U16BracketInsn>(base);
+      const auto *ranges = reinterpret_cast<const BracketRange32 *>(insn + 1);
+      return bracketMatchesChar<Traits>(*this, insn, ranges, cp)
+          ? insn->totalWidth()
+          : 0;
+    }
+
+    default:
+      llvm_unreachable("Not a consuming Pike VM instruction");
+  }
+}
+
+template <class Traits>
+bool Context<Traits>::matchPike(
+    llvh::ArrayRef<uint8_t> program,
+    const CodeUnit *start,
+    bool onlyAtStart,
+    std::vector<CapturedRange> &captures) {
+  const uint8_t *const insns = &program[sizeof(RegexBytecodeHeader)];
+  const uint32_t programSize = program.size() - sizeof(RegexBytecodeHeader);
+  const uint32_t stride = markedCount_ + 1;
+
+  PikeThreadList lists[2] = {{programSize, stride}, {programSize, stride}};
+  PikeThreadList *clist = &lists[0];
+  PikeThreadList *nlist = &lists[1];
+  llvh::SmallVector<PikeFrame, 16> stack;
+  std::vector<CapturedRange> scratch(stride);
+
+  // As in match(), the prefilter can skip positions at which no thread is
+  // running.
+  const auto prefilterKind = static_cast<PrefilterKind>(
+      reinterpret_cast<const RegexBytecodeHeader *>(bytecodeStream_.data())
+          ->prefilterKind);
+  const bool usePrefilter = !onlyAtStart &&
+      (prefilterKind == PrefilterKind::LiteralPrefix ||
+       prefilterKind == PrefilterKind::FirstUnits);
+  const size_t length = last_ - first_;
+
+  bool matched = false;
+  for (const CodeUnit *pos = start;;) {
+    // Start a thread at this position, with the lowest priority, unless a
+    // match starting at an earlier position was found.
+    bool canStart = !matched && (!onlyAtStart || pos == start);
+    if (canStart) {
+      if (usePrefilter && clist->empty()) {
+        size_t index = skipToPrefilterCandidate(first_, pos - first_, length);
+        if (index > length)
+          break;
+        if (first_ + index != pos) {
+          pos = first_ + index;
+          clist->clear();
+        }
+      }
+      std::fill(
+          scratch.begin(),
+          scratch.end(),
+          CapturedRange{kNotMatched, kNotMatched});
+      scratch[0].start = pos - first_;
+      addPikeThreads(insns, *clist, 0, scratch.data(), pos, stack);
+    } else if (clist->empty()) {
+      break;
+    }
+
+    // Decode the character at this position. Every thread consumes it, so
+    // they all move to the same position.
+    const bool atEnd = pos == last_;
+    CodeUnit c = 0;
+    CodePoint cp = 0;
+    uint32_t width = 1;
+    if (!atEnd) {
+      c = *pos;
+      cp = c;
+      if (syntaxFlags_.unicode) {
+        Cursor<Traits> cursor{first_, pos, last_, true /* forwards */};
+        cp = cursor.consumeUTF16();
+        width = cursor.currentPointer() - pos;
+      }
+    }
+
+    for (size_t i = 0, e = clist->size(); i < e; ++i) {
+      const Insn *base = reinterpret_cast<const Insn *>(&insns[clist->pc(i)]);
+      if (base->opcode == Opcode::Goal) {
+        // Threads with lower priority can't produce the match that the
+        // backtracking executor would find.
+        captures.assign(clist->captures(i), clist->captures(i) + stride);
+        captures[0].end = pos - first_;
+        matched = true;
+        break;
+      }
+      if (atEnd)
+        continue;
+      if (uint32_t insnSize = matchPikeInsn(base, c, cp, width)) {
+        std::copy_n(clist->captures(i), stride, scratch.begin());
+        addPikeThreads(
+            insns,
+            *nlist,
+            clist->pc(i) + insnSize,
+            scratch.data(),
+            pos + width,
+            stack);
+      }
+    }
+
+    if (atEnd)
+      break;
+    pos += width;
+    std::swap(clist, nlist);
+    nlist->clear();
+  }
+  return matched;
+}
+
 /// Entry point for searching a string via regex compiled bytecode.
 /// Given the bytecode \p bytecode, search the range starting at \p first up to
 /// (not including) \p last with the flags \p matchFlags. If the search
@@ -1525,6 +1980,16 @@ MatchRuntimeResult searchWithBytecodeImpl(
   if (!cursor.satisfiesConstraints(matchFlags, header->constraints))
     return MatchRuntimeResult::NoMatch;
 
+  // Every match contains a required substring, so there is no match if the
+  // input doesn't.
+  if (static_cast<PrefilterKind>(header->prefilterKind) ==
+          PrefilterKind::RequiredSubstring &&
+      !findSubstring(
+          llvh::ArrayRef<CharT>{first + start, length - start},
+          llvh::ArrayRef<char16_t>{
+              header->prefilter, header->prefilterLength}))
+    return MatchRuntimeResult::NoMatch;
+
   auto markedCount = header->markedCount;
   auto loopCount = header->loopCount;
 
@@ -1543,7 +2008,30 @@ MatchRuntimeResult searchWithBytecodeImpl(
   bool onlyAtStart = (header->constraints & MatchConstraintAnchoredAtStart) ||
       (matchFlags & constants::matchOnlyAtStart);
 
+  // Regexes that the Pike VM can run have a program for it. Backtracking is
+  // faster unless it backtracks excessively, so give it a budget linear in the
+  // length of the input and fall back to the Pike VM when it runs out.
+  const bool hasPikeProgram = header->pikeProgramOffset != 0;
+  if (hasPikeProgram) {
+    ctx.backtracksRemaining_ = std::min<uint64_t>(
+        kBacktrackLimit,
+        kPikeFallbackMinBacktracks +
+            (uint64_t)kPikeFallbackBacktracksPerUnit * (length - start));
+  }
+
   auto res = ctx.match(&state, onlyAtStart);
+  if (!res && hasPikeProgram) {
+    std::vector<CapturedRange> captures;
+    if (!ctx.matchPike(
+            bytecode.drop_front(header->pikeProgramOffset),
+            first + start,
+            onlyAtStart,
+            captures))
+      return MatchRuntimeResult::NoMatch;
+    if (m != nullptr)
+      *m = std::move(captures);
+    return MatchRuntimeResult::Match;
+  }
   if (!res) {
     assert(res.getStatus() == ExecutionStatus::STACK_OVERFLOW);
     return MatchRuntimeResult::StackOverflow;
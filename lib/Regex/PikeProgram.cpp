@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Regex/PikeProgram.h"
+#include "hermes/Regex/RegexBytecode.h"
+#include "hermes/Regex/RegexTypes.h"
+
+#include "llvh/ADT/ArrayRef.h"
+
+#include <cstring>
+#include <functional>
+#include <map>
+
+namespace hermes {
+namespace regex {
+
+namespace {
+
+/// Translates the instructions of a program for the backtracking executor into
+/// a program for the Pike VM.
+class PikeTranslator {
+  /// The instructions of the backtracking program, following its header.
+  const llvh::ArrayRef<uint8_t> insns_;
+
+  /// Whether the regex has the unicode flag.
+  const bool unicode_;
+
+  /// The Pike VM program being built.
+  RegexBytecodeStream &bcs_;
+
+  /// Depth of the loops enclosing the instructions being translated.
+  uint32_t loopDepth_ = 0;
+
+  /// Whether any instruction that creates a thread has been emitted.
+  bool branches_ = false;
+
+ public:
+  PikeTranslator(
+      llvh::ArrayRef<uint8_t> insns,
+      bool unicode,
+      RegexBytecodeStream &bcs)
+      : insns_(insns), unicode_(unicode), bcs_(bcs) {}
+
+  /// Translate the instructions in [begin, end) of the backtracking program.
+  /// \return false if the Pike VM can't run them.
+  bool translate(uint32_t begin, uint32_t end);
+
+  /// \return whether the program may run more than one thread. If not, the
+  /// backtracking executor never backtracks either.
+  bool branches() const {
+    return branches_;
+  }
+
+ private:
+  /// Emit the loop whose body is [bodyBegin, bodyEnd) in the backtracking
+  /// program, running it between \p min and \p max times. The capture groups
+  /// [mexpBegin, mexpEnd) are cleared before each iteration. \p nonEmpty is
+  /// whether the body can't match the empty string.
+  /// \return false if the Pike VM can't run the loop.
+  bool translateLoop(
+      uint32_t bodyBegin,
+      uint32_t bodyEnd,
+      uint32_t min,
+      uint32_t max,
+      bool greedy,
+      uint16_t mexpBegin,
+      uint16_t mexpEnd,
+      bool nonEmpty);
+
+  /// Emit one iteration of a loop body, as described in translateLoop().
+  bool translateIteration(
+      uint32_t bodyBegin,
+      uint32_t bodyEnd,
+      uint16_t mexpBegin,
+      uint16_t mexpEnd);
+
+  /// \return whether the program has grown beyond kMaxPikeProgramSize.
+  bool tooLarge() const {
+    return bcs_.size() > kMaxPikeProgramSize;
+  }
+
+  /// \return the instruction at offset \p ip of the backtracking program.
+  template <typename Instruction>
+  const Instruction *at(uint32_t ip) const {
+    return llvh::cast<Instruction>(reinterpret_cast<const Insn *>(&insns_[ip]));
+  }
+};
+
+bool PikeTranslator::translate(uint32_t begin, uint32_t end) {
+  // Alternations and jumps in the range target instructions following them.
+  // Their targets are set once the translation reaches the instruction, keyed
+  // by its offset in the backtracking program.
+  std::multimap<uint32_t, std::function<void()>> fixups;
+  auto resolveFixups = [&](uint32_t ip) {
+    auto range = fixups.equal_range(ip);
+    for (auto it = range.first; it != range.second; ++it)
+      it->second();
+    fixups.erase(range.first, range.second);
+  };
+
+  uint32_t ip = begin;
+  auto copy = [&](uint32_t width) {
+    bcs_.emitCopy(insns_.slice(ip, width));
+    ip += width;
+  };
+
+  while (ip < end) {
+    resolveFixups(ip);
+    if (tooLarge())
+      return false;
+    const Insn *base = reinterpret_cast<const Insn *>(&insns_[ip]);
+    switch (base->opcode) {
+      // These instructions behave the same in both executors.
+      case Opcode::Goal:
+        copy(sizeof(GoalInsn));
+        break;
+      case Opcode::LeftAnchor:
+        copy(sizeof(LeftAnchorInsn));
+        break;
+      case Opcode::RightAnchor:
+        copy(sizeof(RightAnchorInsn));
+        break;
+      case Opcode::MatchAny:
+        copy(sizeof(MatchAnyInsn));
+        break;
+      case Opcode::MatchAnyButNewline:
+        copy(sizeof(MatchAnyButNewlineInsn));
+        break;
+      case Opcode::MatchChar8:
+        copy(sizeof(MatchChar8Insn));
+        break;
+      case Opcode::MatchChar16:
+        copy(sizeof(MatchChar16Insn));
+        break;
+      case Opcode::MatchCharICase8:
+        copy(sizeof(MatchCharICase8Insn));
+        break;
+      case Opcode::MatchCharICase16:
+        copy(sizeof(MatchCharICase16Insn));
+        break;
+      case Opcode::Bracket:
+        copy(at<BracketInsn>(ip)->totalWidth());
+        break;
+      case Opcode::WordBoundary:
+        copy(sizeof(WordBoundaryInsn));
+        break;
+      case Opcode::BeginMarkedSubexpression:
+        copy(sizeof(BeginMarkedSubexpressionInsn));
+        break;
+      case Opcode::EndMarkedSubexpression:
+        copy(sizeof(EndMarkedSubexpressionInsn));
+        break;
+
+      // The Pike VM only decodes surrogate pairs in unicode mode, which is
+      // also the only mode in which these are emitted.
+      case Opcode::U16MatchAny:
+        if (!unicode_)
+          return false;
+        copy(sizeof(U16MatchAnyInsn));
+        break;
+      case Opcode::U16MatchAnyButNewline:
+        if (!unicode_)
+          return false;
+        copy(sizeof(U16MatchAnyButNewlineInsn));
+        break;
+      case Opcode::U16MatchChar32:
+        if (!unicode_)
+          return false;
+        copy(sizeof(U16MatchChar32Insn));
+        break;
+      case Opcode::U16MatchCharICase32:
+        if (!unicode_)
+          return false;
+        copy(sizeof(U16MatchCharICase32Insn));
+        break;
+      case Opcode::U16Bracket:
+        if (!unicode_)
+          return false;
+        copy(at<U16BracketInsn>(ip)->totalWidth());
+        break;
+
+      // Threads step one character at a time, so split character runs.
+      case Opcode::MatchNChar8: {
+        const auto *insn = at<MatchNChar8Insn>(ip);
+        const char *c = reinterpret_cast<const char *>(insn + 1);
+        for (uint8_t i = 0; i < insn->charCount; ++i)
+          bcs_.emit<MatchChar8Insn>()->c = c[i];
+        ip += insn->totalWidth();
+        break;
+      }
+      case Opcode::MatchNCharICase8: {
+        const auto *insn = at<MatchNCharICase8Insn>(ip);
+        const char *c = reinterpret_cast<const char *>(insn + 1);
+        for (uint8_t i = 0; i < insn->charCount; ++i)
+          bcs_.emit<MatchCharICase8Insn>()->c = c[i];
+        ip += insn->totalWidth();
+        break;
+      }
+
+      case Opcode::Alternation: {
+        const auto *insn = at<AlternationInsn>(ip);
+        if (insn->secondaryBranch <= ip || insn->secondaryBranch > end)
+          return false;
+        auto alt = bcs_.emit<AlternationInsn>();
+        alt->primaryConstraints = insn->primaryConstraints;
+        alt->secondaryConstraints = insn->secondaryConstraints;
+        fixups.emplace(insn->secondaryBranch, [this, alt]() mutable {
+          alt->secondaryBranch = bcs_.currentOffset();
+        });
+        branches_ = true;
+        ip += sizeof(AlternationInsn);
+        break;
+      }
+      case Opcode::Jump32: {
+        const auto *insn = at<Jump32Insn>(ip);
+        if (insn->target <= ip || insn->target > end)
+          return false;
+        auto jump = bcs_.emit<Jump32Insn>();
+        fixups.emplace(insn->target, [this, jump]() mutable {
+          jump->target = bcs_.currentOffset();
+        });
+        ip += sizeof(Jump32Insn);
+        break;
+      }
+
+      case Opcode::BeginLoop: {
+        const auto *insn = at<BeginLoopInsn>(ip);
+        if (!translateLoop(
+                ip + sizeof(BeginLoopInsn),
+                insn->notTakenTarget - sizeof(EndLoopInsn),
+                insn->min,
+                insn->max,
+                insn->greedy,
+                insn->mexpBegin,
+                insn->mexpEnd,
+                insn->loopeeConstraints & MatchConstraintNonEmpty))
+          return false;
+        ip = insn->notTakenTarget;
+        break;
+      }
+      case Opcode::BeginSimpleLoop: {
+        const auto *insn = at<BeginSimpleLoopInsn>(ip);
+        if (!translateLoop(
+                ip + sizeof(BeginSimpleLoopInsn),
+                insn->notTakenTarget - sizeof(EndSimpleLoopInsn),
+                0,
+                UINT32_MAX,
+                true,
+                0,
+                0,
+                true))
+          return false;
+        ip = insn->notTakenTarget;
+        break;
+      }
+      case Opcode::Width1Loop: {
+        const auto *insn = at<Width1LoopInsn>(ip);
+        if (!translateLoop(
+                ip + sizeof(Width1LoopInsn),
+                insn->notTakenTarget,
+                insn->min,
+                insn->max,
+                insn->greedy,
+                0,
+                0,
+                true))
+          return false;
+        ip = insn->notTakenTarget;
+        break;
+      }
+
+      // Backreferences and lookarounds need the backtracking executor. Loop
+      // ends are consumed with their loops.
+      case Opcode::BackRef:
+      case Opcode::Lookaround:
+      case Opcode::EndLoop:
+      case Opcode::EndSimpleLoop:
+      case Opcode::ClearCaptures:
+        return false;
+    }
+  }
+  resolveFixups(end);
+  return ip == end && fixups.empty();
+}
+
+bool PikeTranslator::translateIteration(
+    uint32_t bodyBegin,
+    uint32_t bodyEnd,
+    uint16_t mexpBegin,
+    uint16_t mexpEnd) {
+  if (mexpBegin != mexpEnd) {
+    auto clear = bcs_.emit<ClearCapturesInsn>();
+    clear->mexpBegin = mexpBegin;
+    clear->mexpEnd = mexpEnd;
+  }
+  return translate(bodyBegin, bodyEnd) && !tooLarge();
+}
+
+bool PikeTranslator::translateLoop(
+    uint32_t bodyBegin,
+    uint32_t bodyEnd,
+    uint32_t min,
+    uint32_t max,
+    bool greedy,
+    uint16_t mexpBegin,
+    uint16_t mexpEnd,
+    bool nonEmpty) {
+  // An optional iteration that matches the empty string must fail in the
+  // backtracking executor; a thread can't tell, so we don't handle it.
+  if (min != max && !nonEmpty)
+    return false;
+  if (bodyBegin > bodyEnd || loopDepth_ >= kMaxPikeLoopDepth)
+    return false;
+  ++loopDepth_;
+
+  // The required iterations are unrolled.
+  for (uint32_t i = 0; i < min; ++i) {
+    if (!translateIteration(bodyBegin, bodyEnd, mexpBegin, mexpEnd))
+      return false;
+  }
+
+  if (max == UINT32_MAX) {
+    // Greedy:     L: Alternation X; body; Jump32 L; X:
+    // Non-greedy: L: Alternation B; Jump32 X; B: body; Jump32 L; X:
+    uint32_t loopStart = bcs_.currentOffset();
+    auto alt = bcs_.emit<AlternationInsn>();
+    if (greedy) {
+      if (!translateIteration(bodyBegin, bodyEnd, mexpBegin, mexpEnd))
+        return false;
+      bcs_.emit<Jump32Insn>()->target = loopStart;
+      alt->secondaryBranch = bcs_.currentOffset();
+    } else {
+      auto exit = bcs_.emit<Jump32Insn>();
+      alt->secondaryBranch = bcs_.currentOffset();
+      if (!translateIteration(bodyBegin, bodyEnd, mexpBegin, mexpEnd))
+        return false;
+      bcs_.emit<Jump32Insn>()->target = loopStart;
+      exit->target = bcs_.currentOffset();
+    }
+  } else {
+    // Each optional iteration is preceded by an alternation that can skip it
+    // and all of the following ones.
+    std::vector<RegexBytecodeStream::InstructionWrapper<AlternationInsn>> alts;
+    std::vector<RegexBytecodeStream::InstructionWrapper<Jump32Insn>> exits;
+    for (uint32_t i = min; i < max; ++i) {
+      alts.push_back(bcs_.emit<AlternationInsn>());
+      if (!greedy) {
+        exits.push_back(bcs_.emit<Jump32Insn>());
+        alts.back()->secondaryBranch = bcs_.currentOffset();
+      }
+      if (!translateIteration(bodyBegin, bodyEnd, mexpBegin, mexpEnd))
+        return false;
+    }
+    if (greedy) {
+      for (auto &alt : alts)
+        alt->secondaryBranch = bcs_.currentOffset();
+    } else {
+      for (auto &exit : exits)
+        exit->target = bcs_.currentOffset();
+    }
+  }
+
+  if (min != max)
+    branches_ = true;
+  --loopDepth_;
+  return true;
+}
+
+} // namespace
+
+void appendPikeProgram(std::vector<uint8_t> &bytecode) {
+  RegexBytecodeHeader header;
+  std::memcpy(&header, bytecode.data(), sizeof(header));
+  // The prefilter is applied by the caller using the main header, and the
+  // Pike VM program has no loops.
+  header.loopCount = 0;
+  header.prefilterKind = (uint8_t)PrefilterKind::None;
+  header.prefilterLength = 0;
+  header.pikeProgramOffset = 0;
+
+  RegexBytecodeStream bcs(header);
+  llvh::ArrayRef<uint8_t> insns =
+      llvh::makeArrayRef(bytecode).drop_front(sizeof(header));
+  PikeTranslator translator(
+      insns, SyntaxFlags::fromByte(header.syntaxFlags).unicode, bcs);
+  if (!translator.translate(0, insns.size()) || !translator.branches() ||
+      bcs.size() > kMaxPikeProgramSize)
+    return;
+
+  std::vector<uint8_t> program = bcs.acquireBytecode();
+  uint32_t offset = bytecode.size();
+  bytecode.insert(bytecode.end(), program.begin(), program.end());
+  reinterpret_cast<RegexBytecodeHeader *>(bytecode.data())->pikeProgramOffset =
+      offset;
+}
+
+} // namespace regex
+} // namespace hermes
@@ -162,6 +162,11 @@ void vm_hugepage(void *p, size_t sz) {
       "Precondition: pointer is page-aligned.");
 }
 
+bool vm_bind_to_local_node(void *p, size_t sz) {
+  // Not implemented.
+  return false;
+}
+
 void vm_unused(void *p, size_t sz) {
 #ifndef NDEBUG
   const size_t PS = page_size();
@@ -253,6 +253,32 @@ void vm_hugepage(void *p, size_t sz) {
 #endif
 }
 
+bool vm_bind_to_local_node(void *p, size_t sz) {
+  assert(
+      reinterpret_cast<uintptr_t>(p) % page_size() == 0 &&
+      "Precondition: pointer is page-aligned.");
+
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+  // Use the raw syscalls rather than libnuma, which may not be available.
+  unsigned cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+    return false;
+  // Matches MPOL_PREFERRED from linux/mempolicy.h.
+  constexpr int kMPolPreferred = 1;
+  constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;
+  constexpr size_t kMaxNodes = 1024;
+  if (node >= kMaxNodes)
+    return false;
+  unsigned long nodeMask[kMaxNodes / kBitsPerWord] = {};
+  nodeMask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+  return syscall(SYS_mbind, p, sz, kMPolPreferred, nodeMask, kMaxNodes + 1, 0) ==
+      0;
+#else
+  (void)sz;
+  return false;
+#endif
+}
+
 void vm_unused(void *p, size_t sz) {
 #ifndef NDEBUG
   const size_t PS = page_size();
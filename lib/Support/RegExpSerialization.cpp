@@ -275,6 +275,12 @@ void dumpInstruction(const regex::Width1LoopInsn *insn, llvh::raw_ostream &OS) {
       aligner(insn->min),
       aligner(insn->max));
 }
+
+void dumpInstruction(
+    const regex::ClearCapturesInsn *insn,
+    llvh::raw_ostream &OS) {
+  OS << "ClearCaptures: [" << insn->mexpBegin << "," << insn->mexpEnd << ')';
+}
 } // namespace
 
 namespace hermes {
@@ -289,6 +295,37 @@ void dumpRegexBytecode(llvh::ArrayRef<uint8_t> bytes, llvh::raw_ostream &OS) {
       aligner(header->loopCount),
       aligner(header->syntaxFlags),
       header->constraints);
+  const char *prefilterDesc = nullptr;
+  switch (static_cast<regex::PrefilterKind>(header->prefilterKind)) {
+    case regex::PrefilterKind::None:
+      break;
+    case regex::PrefilterKind::LiteralPrefix:
+      prefilterDesc = "prefix";
+      break;
+    case regex::PrefilterKind::FirstUnits:
+      prefilterDesc = "first of";
+      break;
+    case regex::PrefilterKind::RequiredSubstring:
+      prefilterDesc = "contains";
+      break;
+  }
+  if (prefilterDesc) {
+    OS << "  Prefilter: " << prefilterDesc << " '";
+    for (uint8_t i = 0; i < header->prefilterLength; ++i) {
+      char16_t c = aligner(header->prefilter[i]);
+      if (c < 128 && std::isprint(c))
+        OS << (char)c;
+      else
+        OS << llvh::format("\\u%04x", c);
+    }
+    OS << "'\n";
+  }
+  // The Pike VM program follows the main program, if there is one.
+  llvh::ArrayRef<uint8_t> pikeProgram;
+  if (uint32_t pikeProgramOffset = aligner(header->pikeProgramOffset)) {
+    pikeProgram = bytes.drop_front(pikeProgramOffset);
+    bytes = bytes.take_front(pikeProgramOffset);
+  }
   bytes = bytes.slice(sizeof *header);
   uint32_t cursor = 0;
   while (cursor < bytes.size()) {
@@ -311,6 +348,11 @@ void dumpRegexBytecode(llvh::ArrayRef<uint8_t> bytes, llvh::raw_ostream &OS) {
   }
   // We expect to have consumed exactly the size of the stream.
   assert(cursor == bytes.size() && "Invalid instructions in regex stream");
+
+  if (!pikeProgram.empty()) {
+    OS << "  Pike program:\n";
+    dumpRegexBytecode(pikeProgram, OS);
+  }
 }
 
 CompiledRegExp::CompiledRegExp(CompiledRegExp &&) = default;
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/StringSearch.h"
+
+#include "llvh/Support/MathExtras.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HERMES_STRING_SEARCH_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HERMES_STRING_SEARCH_NEON
+#endif
+
+namespace hermes {
+
+namespace {
+
+/// \return the value of the code unit \p c.
+inline char16_t unit(char c) {
+  return static_cast<unsigned char>(c);
+}
+inline char16_t unit(char16_t c) {
+  return c;
+}
+
+/// \return whether a unit of type H can have the value \p c.
+template <typename H>
+inline bool canContain(char16_t c) {
+  return sizeof(H) == sizeof(char16_t) || c <= 0xFF;
+}
+
+/// \return whether the \p n units at \p a and \p b have the same values.
+template <typename H, typename N>
+inline bool unitsEqual(const H *a, const N *b, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    if (unit(a[i]) != unit(b[i]))
+      return false;
+  }
+  return true;
+}
+inline bool unitsEqual(const char *a, const char *b, size_t n) {
+  return std::memcmp(a, b, n) == 0;
+}
+inline bool unitsEqual(const char16_t *a, const char16_t *b, size_t n) {
+  return std::memcmp(a, b, n * sizeof(char16_t)) == 0;
+}
+
+#if defined(HERMES_STRING_SEARCH_SSE2) || defined(HERMES_STRING_SEARCH_NEON)
+#define HERMES_STRING_SEARCH_SIMD
+
+/// Compares a block of kUnits units of type H against a single value. match()
+/// returns a bitmask with kBitsPerUnit bits set for every equal unit, in
+/// order.
+template <typename H>
+struct Block;
+
+#if defined(HERMES_STRING_SEARCH_SSE2)
+template <>
+struct Block<char> {
+  static constexpr size_t kUnits = 16;
+  static constexpr unsigned kBitsPerUnit = 1;
+  using Vec = __m128i;
+  static Vec splat(char16_t c) {
+    return _mm_set1_epi8(static_cast<char>(c));
+  }
+  static uint64_t match(const char *p, Vec c) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, c)));
+  }
+};
+template <>
+struct Block<char16_t> {
+  static constexpr size_t kUnits = 8;
+  static constexpr unsigned kBitsPerUnit = 2;
+  using Vec = __m128i;
+  static Vec splat(char16_t c) {
+    return _mm_set1_epi16(static_cast<short>(c));
+  }
+  static uint64_t match(const char16_t *p, Vec c) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(v, c)));
+  }
+};
+#else
+// NEON has no movemask. Shifting every 16-bit lane right by 4 and narrowing
+// it keeps 4 bits of every byte lane, or 8 bits of every 16-bit lane.
+template <>
+struct Block<char> {
+  static constexpr size_t kUnits = 16;
+  static constexpr unsigned kBitsPerUnit = 4;
+  using Vec = uint8x16_t;
+  static Vec splat(char16_t c) {
+    return vdupq_n_u8(static_cast<uint8_t>(c));
+  }
+  static uint64_t match(const char *p, Vec c) {
+    uint8x16_t eq = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(p)), c);
+    return vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+  }
+};
+template <>
+struct Block<char16_t> {
+  static constexpr size_t kUnits = 8;
+  static constexpr unsigned kBitsPerUnit = 8;
+  using Vec = uint16x8_t;
+  static Vec splat(char16_t c) {
+    return vdupq_n_u16(c);
+  }
+  static uint64_t match(const char16_t *p, Vec c) {
+    uint16x8_t eq =
+        vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t *>(p)), c);
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(eq, 4)), 0);
+  }
+};
+#endif
+
+/// \return the index of the first unit set in the mask \p bits returned by
+/// Block<H>::match().
+template <typename H>
+inline size_t firstSetUnit(uint64_t bits) {
+  return llvh::countTrailingZeros(bits) / Block<H>::kBitsPerUnit;
+}
+
+/// \return \p bits without the unit at \p idx.
+template <typename H>
+inline uint64_t clearUnit(uint64_t bits, size_t idx) {
+  constexpr uint64_t unitMask = (uint64_t(1) << Block<H>::kBitsPerUnit) - 1;
+  return bits & ~(unitMask << (idx * Block<H>::kBitsPerUnit));
+}
+#endif
+
+/// \return a pointer to the first unit in [cur, end) with value \p c, or
+/// \p end if there is none.
+inline const char *findUnit(const char *cur, const char *end, char16_t c) {
+  if (c > 0xFF || cur == end)
+    return end;
+  auto *found = static_cast<const char *>(
+      std::memchr(cur, static_cast<unsigned char>(c), end - cur));
+  return found ? found : end;
+}
+inline const char16_t *
+findUnit(const char16_t *cur, const char16_t *end, char16_t c) {
+#ifdef HERMES_STRING_SEARCH_SIMD
+  using B = Block<char16_t>;
+  const B::Vec vc = B::splat(c);
+  for (; end - cur >= (ptrdiff_t)B::kUnits; cur += B::kUnits) {
+    if (uint64_t bits = B::match(cur, vc))
+      return cur + firstSetUnit<char16_t>(bits);
+  }
+#endif
+  while (cur != end && *cur != c)
+    ++cur;
+  return cur;
+}
+
+/// Find \p needle, of length \p m >= 2, in \p hay of length \p h >= m, by
+/// looking for its first and last units before comparing the rest.
+/// \return a pointer to the match, or nullptr.
+template <typename H, typename N>
+const H *searchFirstLast(const H *hay, size_t h, const N *needle, size_t m) {
+  const char16_t first = unit(needle[0]);
+  const char16_t last = unit(needle[m - 1]);
+  if (!canContain<H>(first) || !canContain<H>(last))
+    return nullptr;
+  const H *cur = hay;
+  // The last position at which a match may start.
+  const H *lastStart = hay + (h - m);
+#ifdef HERMES_STRING_SEARCH_SIMD
+  using B = Block<H>;
+  const typename B::Vec vFirst = B::splat(first);
+  const typename B::Vec vLast = B::splat(last);
+  for (; lastStart - cur >= (ptrdiff_t)B::kUnits; cur += B::kUnits) {
+    uint64_t bits = B::match(cur, vFirst) & B::match(cur + m - 1, vLast);
+    while (bits) {
+      size_t idx = firstSetUnit<H>(bits);
+      if (unitsEqual(cur + idx + 1, needle + 1, m - 2))
+        return cur + idx;
+      bits = clearUnit<H>(bits, idx);
+    }
+  }
+#endif
+  for (; cur <= lastStart; ++cur) {
+    if (unit(*cur) == first && unit(cur[m - 1]) == last &&
+        unitsEqual(cur + 1, needle + 1, m - 2))
+      return cur;
+  }
+  return nullptr;
+}
+
+/// Find \p needle, of length \p m >= 2, in \p hay of length \p h >= m, with
+/// Boyer-Moore-Horspool. The shift table is indexed by the low byte of each
+/// unit and holds the smallest shift of all units sharing that byte.
+/// \return a pointer to the match, or nullptr.
+template <typename H, typename N>
+const H *searchHorspool(const H *hay, size_t h, const N *needle, size_t m) {
+  uint32_t shift[256];
+  std::fill(std::begin(shift), std::end(shift), static_cast<uint32_t>(m));
+  for (size_t i = 0; i + 1 < m; ++i)
+    shift[unit(needle[i]) & 0xFF] = static_cast<uint32_t>(m - 1 - i);
+
+  const char16_t last = unit(needle[m - 1]);
+  for (size_t pos = 0; pos + m <= h;) {
+    char16_t c = unit(hay[pos + m - 1]);
+    if (c == last && unitsEqual(hay + pos, needle, m - 1))
+      return hay + pos;
+    pos += shift[c & 0xFF];
+  }
+  return nullptr;
+}
+
+/// The maximum number of units findFirstOf() compares with SIMD.
+constexpr size_t kMaxSIMDFirstOfUnits = 4;
+
+/// \return the index of the first unit in \p haystack that is equal to any of
+/// the units in \p units, or None, comparing one unit at a time.
+template <typename H>
+OptValue<uint32_t> findFirstOfScalar(
+    llvh::ArrayRef<H> haystack,
+    llvh::ArrayRef<char16_t> units) {
+  for (size_t i = 0, e = haystack.size(); i < e; ++i) {
+    if (std::find(units.begin(), units.end(), unit(haystack[i])) !=
+        units.end())
+      return static_cast<uint32_t>(i);
+  }
+  return llvh::None;
+}
+
+} // namespace
+
+template <typename H, typename N>
+OptValue<uint32_t> findSubstring(
+    llvh::ArrayRef<H> haystack,
+    llvh::ArrayRef<N> needle) {
+  const size_t h = haystack.size();
+  const size_t m = needle.size();
+  if (m == 0)
+    return 0;
+  if (m > h)
+    return llvh::None;
+
+  const H *hay = haystack.data();
+  const H *found;
+  if (m == 1) {
+    found = findUnit(hay, hay + h, unit(needle[0]));
+    if (found == hay + h)
+      return llvh::None;
+  } else if (
+      m >= HORSPOOL_MIN_NEEDLE_LENGTH && h >= HORSPOOL_MIN_HAYSTACK_LENGTH) {
+    found = searchHorspool(hay, h, needle.data(), m);
+  } else {
+    found = searchFirstLast(hay, h, needle.data(), m);
+  }
+  if (!found)
+    return llvh::None;
+  return static_cast<uint32_t>(found - hay);
+}
+
+template <typename H, typename N>
+OptValue<uint32_t> findLastSubstring(
+    llvh::ArrayRef<H> haystack,
+    llvh::ArrayRef<N> needle) {
+  const size_t h = haystack.size();
+  const size_t m = needle.size();
+  if (m == 0)
+    return static_cast<uint32_t>(h);
+  if (m > h)
+    return llvh::None;
+
+  const H *hay = haystack.data();
+  const char16_t first = unit(needle[0]);
+  for (const H *cur = hay + (h - m) + 1; cur != hay;) {
+    --cur;
+    if (unit(*cur) == first && unitsEqual(cur + 1, needle.data() + 1, m - 1))
+      return static_cast<uint32_t>(cur - hay);
+  }
+  return llvh::None;
+}
+
+template <typename H>
+OptValue<uint32_t> findFirstOf(
+    llvh::ArrayRef<H> haystack,
+    llvh::ArrayRef<char16_t> units) {
+  // Units that can't occur in the haystack can't match.
+  char16_t wanted[kMaxSIMDFirstOfUnits];
+  size_t count = 0;
+  for (char16_t u : units) {
+    if (!canContain<H>(u))
+      continue;
+    if (count == kMaxSIMDFirstOfUnits)
+      return findFirstOfScalar(haystack, units);
+    wanted[count++] = u;
+  }
+  if (count == 0)
+    return llvh::None;
+
+  const H *hay = haystack.data();
+  const H *end = hay + haystack.size();
+  const H *cur = hay;
+  if (count == 1) {
+    cur = findUnit(cur, end, wanted[0]);
+    if (cur == end)
+      return llvh::None;
+    return static_cast<uint32_t>(cur - hay);
+  }
+#ifdef HERMES_STRING_SEARCH_SIMD
+  using B = Block<H>;
+  typename B::Vec vs[kMaxSIMDFirstOfUnits];
+  for (size_t i = 0; i < count; ++i)
+    vs[i] = B::splat(wanted[i]);
+  for (; end - cur >= (ptrdiff_t)B::kUnits; cur += B::kUnits) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < count; ++i)
+      bits |= B::match(cur, vs[i]);
+    if (bits)
+      return static_cast<uint32_t>(cur - hay + firstSetUnit<H>(bits));
+  }
+#endif
+  for (; cur != end; ++cur) {
+    if (std::find(wanted, wanted + count, unit(*cur)) != wanted + count)
+      return static_cast<uint32_t>(cur - hay);
+  }
+  return llvh::None;
+}
+
+#define HERMES_INSTANTIATE_STRING_SEARCH(H, N)                  \
+  template OptValue<uint32_t> findSubstring<H, N>(              \
+      llvh::ArrayRef<H> haystack, llvh::ArrayRef<N> needle);    \
+  template OptValue<uint32_t> findLastSubstring<H, N>(          \
+      llvh::ArrayRef<H> haystack, llvh::ArrayRef<N> needle);
+
+HERMES_INSTANTIATE_STRING_SEARCH(char, char)
+HERMES_INSTANTIATE_STRING_SEARCH(char, char16_t)
+HERMES_INSTANTIATE_STRING_SEARCH(char16_t, char)
+HERMES_INSTANTIATE_STRING_SEARCH(char16_t, char16_t)
+
+#undef HERMES_INSTANTIATE_STRING_SEARCH
+
+template OptValue<uint32_t> findFirstOf<char>(
+    llvh::ArrayRef<char> haystack,
+    llvh::ArrayRef<char16_t> units);
+template OptValue<uint32_t> findFirstOf<char16_t>(
+    llvh::ArrayRef<char16_t> haystack,
+    llvh::ArrayRef<char16_t> units);
+
+} // namespace hermes
@@ -7,6 +7,16 @@
 
 #include "hermes/Support/UTF8.h"
 
+#include "llvh/Support/MathExtras.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HERMES_UTF8_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define HERMES_UTF8_NEON
+#endif
+
 namespace hermes {
 
 void encodeUTF8(char *&dst, uint32_t cp) {
@@ -131,13 +141,77 @@ void convertUTF16ToUTF8WithSingleSurrogates(
   }
 }
 
+#if defined(HERMES_UTF8_SSE2) || defined(HERMES_UTF8_NEON)
+/// Number of bytes processed at once.
+static constexpr size_t kVectorBytes = 16;
+#endif
+
+#if defined(HERMES_UTF8_SSE2)
+using ByteVec = __m128i;
+static inline ByteVec loadBytes(const void *p) {
+  return _mm_loadu_si128(static_cast<const __m128i *>(p));
+}
+static inline ByteVec splatByte(uint8_t b) {
+  return _mm_set1_epi8(static_cast<char>(b));
+}
+/// \return a mask with 0xFF in the lanes of \p v that are in [lo, lo + n),
+/// for ASCII values of \p v.
+static inline ByteVec bytesInRange(ByteVec v, uint8_t lo, uint8_t n) {
+  // Move the range to the bottom of the signed range, so that a single signed
+  // comparison checks both ends.
+  ByteVec biased = _mm_add_epi8(v, splatByte(0x80 - lo));
+  return _mm_cmplt_epi8(biased, splatByte(0x80 + n));
+}
+static inline ByteVec bytesEqual(ByteVec v, uint8_t b) {
+  return _mm_cmpeq_epi8(v, splatByte(b));
+}
+/// \return a bitmask with one bit per lane of the lane mask \p mask.
+static inline uint32_t laneBits(ByteVec mask) {
+  return static_cast<uint32_t>(_mm_movemask_epi8(mask));
+}
+#elif defined(HERMES_UTF8_NEON)
+using ByteVec = uint8x16_t;
+static inline ByteVec loadBytes(const void *p) {
+  return vld1q_u8(static_cast<const uint8_t *>(p));
+}
+static inline ByteVec splatByte(uint8_t b) {
+  return vdupq_n_u8(b);
+}
+static inline ByteVec bytesInRange(ByteVec v, uint8_t lo, uint8_t n) {
+  return vcltq_u8(vsubq_u8(v, splatByte(lo)), splatByte(n));
+}
+static inline ByteVec bytesEqual(ByteVec v, uint8_t b) {
+  return vceqq_u8(v, splatByte(b));
+}
+static inline uint32_t laneBits(ByteVec mask) {
+  // NEON has no movemask: weight every lane by its bit and add them up.
+  static const uint8_t kWeights[16] = {
+      1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t bits = vandq_u8(mask, vld1q_u8(kWeights));
+  return vaddv_u8(vget_low_u8(bits)) |
+      (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+}
+#endif
+
 bool isAllASCII(const uint8_t *start, const uint8_t *end) {
   const uint8_t *cursor = start;
-  size_t len = end - start;
+#if defined(HERMES_UTF8_SSE2)
+  __m128i acc = _mm_setzero_si128();
+  for (; end - cursor >= (ptrdiff_t)kVectorBytes; cursor += kVectorBytes)
+    acc = _mm_or_si128(acc, loadBytes(cursor));
+  if (_mm_movemask_epi8(acc))
+    return false;
+#elif defined(HERMES_UTF8_NEON)
+  uint8x16_t acc = vdupq_n_u8(0);
+  for (; end - cursor >= (ptrdiff_t)kVectorBytes; cursor += kVectorBytes)
+    acc = vorrq_u8(acc, loadBytes(cursor));
+  if (vmaxvq_u8(acc) & 0x80u)
+    return false;
+#else
+  size_t len = end - cursor;
   static_assert(
       sizeof(uint32_t) == 4 && alignof(uint32_t) <= 4,
       "uint32_t must be 4 bytes and cannot be more than 4 byte aligned");
-
   if (len >= 4) {
     // Step by 1s until aligned for uint32_t.
     uint8_t mask = 0;
@@ -159,14 +233,119 @@ bool isAllASCII(const uint8_t *start, const uint8_t *end) {
       len -= 4;
     }
   }
-  assert(len < 4 && "Length should now be less than 4");
+#endif
   uint8_t mask = 0;
-  while (len--) {
+  while (cursor < end)
     mask |= *cursor++;
-  }
-  if (mask & 0x80u)
+  return !(mask & 0x80u);
+}
+
+bool isAllASCII(const char16_t *start, const char16_t *end) {
+  const char16_t *cursor = start;
+#if defined(HERMES_UTF8_SSE2) || defined(HERMES_UTF8_NEON)
+  constexpr size_t kUnits = kVectorBytes / sizeof(char16_t);
+#endif
+#if defined(HERMES_UTF8_SSE2)
+  __m128i acc = _mm_setzero_si128();
+  for (; end - cursor >= (ptrdiff_t)kUnits; cursor += kUnits)
+    acc = _mm_or_si128(acc, loadBytes(cursor));
+  // A unit is ASCII iff none of its bits above the lowest 7 are set.
+  if (_mm_movemask_epi8(
+          _mm_cmpeq_epi16(_mm_and_si128(acc, _mm_set1_epi16(~0x7F)),
+                          _mm_setzero_si128())) != 0xFFFF)
+    return false;
+#elif defined(HERMES_UTF8_NEON)
+  uint16x8_t acc = vdupq_n_u16(0);
+  for (; end - cursor >= (ptrdiff_t)kUnits; cursor += kUnits)
+    acc = vorrq_u16(acc, vld1q_u16(reinterpret_cast<const uint16_t *>(cursor)));
+  if (vmaxvq_u16(acc) > 0x7F)
     return false;
-  return true;
+#endif
+  char16_t mask = 0;
+  while (cursor < end)
+    mask |= *cursor++;
+  return mask <= 0x7F;
+}
+
+const char *findASCIICaseChange(const char *start, const char *end, bool upper) {
+  const uint8_t first = upper ? 'a' : 'A';
+  const char *cursor = start;
+#if defined(HERMES_UTF8_SSE2) || defined(HERMES_UTF8_NEON)
+  for (; end - cursor >= (ptrdiff_t)kVectorBytes; cursor += kVectorBytes) {
+    if (uint32_t bits = laneBits(bytesInRange(loadBytes(cursor), first, 26)))
+      return cursor + llvh::countTrailingZeros(bits);
+  }
+#endif
+  for (; cursor != end; ++cursor) {
+    if ((uint8_t)(*cursor - first) < 26)
+      return cursor;
+  }
+  return end;
+}
+
+void convertASCIICase(const char *start, const char *end, char *out, bool upper) {
+  const uint8_t first = upper ? 'a' : 'A';
+  const char *cursor = start;
+#if defined(HERMES_UTF8_SSE2)
+  for (; end - cursor >= (ptrdiff_t)kVectorBytes;
+       cursor += kVectorBytes, out += kVectorBytes) {
+    __m128i v = loadBytes(cursor);
+    // Letters differ from their other case only in bit 5.
+    __m128i flip = _mm_and_si128(bytesInRange(v, first, 26), splatByte(0x20));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_xor_si128(v, flip));
+  }
+#elif defined(HERMES_UTF8_NEON)
+  for (; end - cursor >= (ptrdiff_t)kVectorBytes;
+       cursor += kVectorBytes, out += kVectorBytes) {
+    uint8x16_t v = loadBytes(cursor);
+    uint8x16_t flip = vandq_u8(bytesInRange(v, first, 26), splatByte(0x20));
+    vst1q_u8(reinterpret_cast<uint8_t *>(out), veorq_u8(v, flip));
+  }
+#endif
+  for (; cursor != end; ++cursor, ++out) {
+    char c = *cursor;
+    *out = (uint8_t)(c - first) < 26 ? c ^ 0x20 : c;
+  }
+}
+
+/// \return whether \p c is an ASCII whitespace or line terminator character.
+static inline bool isASCIIWhiteSpace(char c) {
+  return c == ' ' || (uint8_t)(c - '\t') <= '\r' - '\t';
+}
+
+#if defined(HERMES_UTF8_SSE2) || defined(HERMES_UTF8_NEON)
+/// \return a bitmask of the lanes of \p v that are not whitespace.
+static inline uint32_t nonWhiteSpaceBits(ByteVec v) {
+  uint32_t white = laneBits(bytesEqual(v, ' ')) |
+      laneBits(bytesInRange(v, '\t', '\r' - '\t' + 1));
+  return ~white & 0xFFFF;
+}
+#endif
+
+const char *skipASCIIWhiteSpace(const char *start, const char *end) {
+  const char *cursor = start;
+#if defined(HERMES_UTF8_SSE2) || defined(HERMES_UTF8_NEON)
+  for (; end - cursor >= (ptrdiff_t)kVectorBytes; cursor += kVectorBytes) {
+    if (uint32_t bits = nonWhiteSpaceBits(loadBytes(cursor)))
+      return cursor + llvh::countTrailingZeros(bits);
+  }
+#endif
+  while (cursor != end && isASCIIWhiteSpace(*cursor))
+    ++cursor;
+  return cursor;
+}
+
+const char *skipASCIIWhiteSpaceBackward(const char *start, const char *end) {
+  const char *cursor = end;
+#if defined(HERMES_UTF8_SSE2) || defined(HERMES_UTF8_NEON)
+  for (; cursor - start >= (ptrdiff_t)kVectorBytes; cursor -= kVectorBytes) {
+    if (uint32_t bits = nonWhiteSpaceBits(loadBytes(cursor - kVectorBytes)))
+      return cursor - kVectorBytes + (32 - llvh::countLeadingZeros(bits));
+  }
+#endif
+  while (cursor != start && isASCIIWhiteSpace(cursor[-1]))
+    --cursor;
+  return cursor;
 }
 
 } // namespace hermes
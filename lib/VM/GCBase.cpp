@@ -1844,9 +1844,12 @@ void GCBase::sizeDiagnosticCensus(size_t allocatedBytes) {
     // We include ExternalStringPrimitives because we're including external
     // memory in the overall heap size. We do not include
     // BufferedStringPrimitives because they just store a pointer to an
-    // ExternalStringPrimitive (which is already tracked).
+    // ExternalStringPrimitive (which is already tracked), nor
+    // RopeStringPrimitives and SlicedStringPrimitives, whose characters are in
+    // other strings.
     auto *strprim = dyn_vmcast<StringPrimitive>(cell);
-    if (strprim && !isBufferedStringPrimitive(cell)) {
+    if (strprim && !isBufferedStringPrimitive(cell) &&
+        !isRopeStringPrimitive(cell) && !isSlicedStringPrimitive(cell)) {
       auto &stat = strprim->isASCII()
           ? acceptor.diagnostic.stats.breakdown["StringPrimitive (ASCII)"]
           : acceptor.diagnostic.stats.breakdown["StringPrimitive (UTF-16)"];
@@ -628,6 +628,30 @@ CallResult<PseudoHandle<>> Interpreter::createArrayFromBuffer(
     unsigned numElements,
     unsigned numLiterals,
     unsigned bufferIndex) {
+  // If the literals are all numbers, create a packed array and store them
+  // unboxed.
+  auto kind = JSArray::ElementKind::PackedInt32;
+  for (auto iter = curCodeBlock->getArrayBufferIter(bufferIndex, numLiterals);
+       iter.hasNext() && kind != JSArray::ElementKind::Generic;) {
+    kind = std::max(kind, JSArray::elementKindFor(iter.get(runtime)));
+  }
+  if (kind != JSArray::ElementKind::Generic) {
+    auto arrRes = JSArray::create(runtime, 0, numElements);
+    if (arrRes == ExecutionStatus::EXCEPTION) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    auto arr = *arrRes;
+    JSArray::reservePackedStorage(arr, runtime, kind, numElements);
+    auto iter = curCodeBlock->getArrayBufferIter(bufferIndex, numLiterals);
+    MutableHandle<> value{runtime};
+    JSArray::size_type i = 0;
+    while (iter.hasNext()) {
+      value = iter.get(runtime);
+      JSArray::setElementAt(arr, runtime, i++, value);
+    }
+    return createPseudoHandle(HermesValue::encodeObjectValue(*arr));
+  }
+
   // Create a new array using the built-in constructor, and initialize
   // the elements from a literal array buffer.
   auto arrRes = JSArray::create(runtime, numElements, numElements);
@@ -2498,6 +2522,19 @@ tailCall:
 
       CASE(GetByVal) {
         if (LLVM_LIKELY(O2REG(GetByVal).isObject())) {
+          // Fast path: an element of an array that is in its indexed storage.
+          // The storage only has elements when the array has fast index
+          // properties.
+          if (auto *arr = dyn_vmcast<JSArray>(O2REG(GetByVal))) {
+            if (auto idx = toArrayIndexFastPath(O3REG(GetByVal))) {
+              HermesValue value = arr->at(runtime, *idx);
+              if (LLVM_LIKELY(!value.isEmpty())) {
+                O1REG(GetByVal) = value;
+                ip = NEXTINST(GetByVal);
+                DISPATCH;
+              }
+            }
+          }
           CAPTURE_IP(
               resPH = JSObject::getComputed_RJS(
                   Handle<JSObject>::vmcast(&O2REG(GetByVal)),
@@ -2525,6 +2562,17 @@ tailCall:
 
       CASE(PutByVal) {
         if (LLVM_LIKELY(O1REG(PutByVal).isObject())) {
+          // Fast path: a number stored into an existing element of a packed
+          // array.
+          if (auto *arr = dyn_vmcast<JSArray>(O1REG(PutByVal))) {
+            if (auto idx = toArrayIndexFastPath(O2REG(PutByVal))) {
+              if (LLVM_LIKELY(JSArray::trySetPackedElement(
+                      arr, runtime, *idx, O3REG(PutByVal)))) {
+                ip = NEXTINST(PutByVal);
+                DISPATCH;
+              }
+            }
+          }
           CAPTURE_IP_ASSIGN(
               auto putRes,
               JSObject::putComputed_RJS(
@@ -36,7 +36,8 @@ void ArrayImpl::_snapshotAddEdgesImpl(
   auto *const self = vmcast<ArrayImpl>(cell);
   // Add the super type's edges too.
   JSObject::_snapshotAddEdgesImpl(self, gc, snap);
-  if (!self->getIndexedStorage(gc.getPointerBase())) {
+  PointerBase &base = gc.getPointerBase();
+  if (!self->indexedStorage_.get(base)) {
     return;
   }
 
@@ -45,14 +46,12 @@ void ArrayImpl::_snapshotAddEdgesImpl(
   snap.addNamedEdge(
       HeapSnapshot::EdgeType::Internal,
       "elements",
-      gc.getObjectID(self->getIndexedStorage(gc.getPointerBase())));
-  auto *const indexedStorage = self->getIndexedStorage(gc.getPointerBase());
+      gc.getObjectID(self->indexedStorage_.get(base)));
   const auto beginIndex = self->beginIndex_;
   const auto endIndex = self->endIndex_;
   for (uint32_t i = beginIndex; i < endIndex; i++) {
-    const auto &elem = indexedStorage->at(gc.getPointerBase(), i - beginIndex);
     const llvh::Optional<HeapSnapshot::NodeID> elemID =
-        gc.getSnapshotID(elem.toHV(gc.getPointerBase()));
+        gc.getSnapshotID(self->unsafeAt(base, i));
     if (!elemID) {
       continue;
     }
@@ -69,9 +68,7 @@ bool ArrayImpl::_haveOwnIndexedImpl(
 
   // Check whether the index is within the storage.
   if (index >= self->beginIndex_ && index < self->endIndex_)
-    return !self->getIndexedStorage(runtime)
-                ->at(runtime, index - self->beginIndex_)
-                .isEmpty();
+    return !self->unsafeAt(runtime, index).isEmpty();
 
   return false;
 }
@@ -83,10 +80,7 @@ OptValue<PropertyFlags> ArrayImpl::_getOwnIndexedPropertyFlagsImpl(
   auto *self = vmcast<ArrayImpl>(selfObj);
 
   // Check whether the index is within the storage.
-  if (index >= self->beginIndex_ && index < self->endIndex_ &&
-      !self->getIndexedStorage(runtime)
-           ->at(runtime, index - self->beginIndex_)
-           .isEmpty()) {
+  if (!self->at(runtime, index).isEmpty()) {
     PropertyFlags indexedElementFlags{};
     indexedElementFlags.enumerable = 1;
     indexedElementFlags.writable = 1;
@@ -117,15 +111,166 @@ HermesValue ArrayImpl::_getOwnIndexedImpl(
     uint32_t index) {
   NoAllocScope noAllocs{runtime};
 
-  return vmcast<ArrayImpl>(selfObj.get())
-      ->at(runtime, index)
-      .unboxToHV(runtime);
+  return vmcast<ArrayImpl>(selfObj.get())->at(runtime, index);
+}
+
+void ArrayImpl::reservePackedStorage(
+    Handle<ArrayImpl> selfHandle,
+    Runtime &runtime,
+    ElementKind kind,
+    size_type capacity) {
+  assert(kind != ElementKind::Generic && "element kind must be packed");
+  assert(
+      !selfHandle->indexedStorage_ && "array already has indexed storage");
+  // Leave it to the writes to pick the storage if the elements don't fit.
+  if (capacity == 0 || capacity > maxPackedElements(kind))
+    return;
+  GCCell *storage;
+  if (kind == ElementKind::PackedInt32)
+    storage = ArrayStorageInt32::create(runtime, capacity);
+  else
+    storage = ArrayStorageDouble::create(runtime, capacity);
+  selfHandle->indexedStorage_.set(runtime, storage, runtime.getHeap());
+}
+
+ExecutionStatus ArrayImpl::transitionElementKind(
+    Handle<ArrayImpl> selfHandle,
+    Runtime &runtime,
+    ElementKind kind) {
+  const ElementKind oldKind = selfHandle->getElementKind(runtime);
+  assert(kind > oldKind && "element kinds only generalize");
+  const uint32_t endIndex = selfHandle->endIndex_;
+  GCCell *oldStorage = selfHandle->indexedStorage_.get(runtime);
+  if (!oldStorage) {
+    // There are no elements, so the next write picks the storage.
+    return ExecutionStatus::RETURNED;
+  }
+  // Keep the capacity, since arrays often change kind while they are being
+  // filled in.
+  const uint32_t capacity = oldKind == ElementKind::PackedInt32
+      ? vmcast<ArrayStorageInt32>(oldStorage)->capacity()
+      : vmcast<ArrayStorageDouble>(oldStorage)->capacity();
+
+  if (kind == ElementKind::PackedDouble) {
+    auto *newStorage = ArrayStorageDouble::create(runtime, capacity);
+    // The allocation may have moved the old storage.
+    const auto *src = selfHandle->getInt32Storage(runtime);
+    newStorage->resizeWithinCapacity(endIndex);
+    std::copy(src->data(), src->data() + endIndex, newStorage->data());
+    selfHandle->indexedStorage_.set(runtime, newStorage, runtime.getHeap());
+    return ExecutionStatus::RETURNED;
+  }
+
+  assert(kind == ElementKind::Generic && "invalid element kind");
+  auto arrRes = StorageType::create(runtime, capacity, endIndex);
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto newStorage = runtime.makeHandle<StorageType>(std::move(*arrRes));
+  for (uint32_t i = 0; i != endIndex; ++i) {
+    // Boxing a double may allocate, so read the old storage every time.
+    auto shv = SmallHermesValue::encodeNumberValue(
+        selfHandle->unsafeAt(runtime, i).getNumber(), runtime);
+    newStorage->set(runtime, i, shv);
+  }
+  selfHandle->setIndexedStorage(runtime, *newStorage, runtime.getHeap());
+  return ExecutionStatus::RETURNED;
+}
+
+template <typename Storage>
+void ArrayImpl::pushPackedElement(
+    Handle<ArrayImpl> selfHandle,
+    Runtime &runtime,
+    typename Storage::value_type value) {
+  auto *storage =
+      vmcast_or_null<Storage>(selfHandle->indexedStorage_.get(runtime));
+  if (LLVM_UNLIKELY(!storage)) {
+    // Allocate storage with capacity for 4 elements.
+    storage = Storage::create(runtime, 4);
+    selfHandle->indexedStorage_.set(runtime, storage, runtime.getHeap());
+  }
+  const uint32_t size = storage->size();
+  if (LLVM_LIKELY(size < storage->capacity())) {
+    storage->resizeWithinCapacity(size + 1);
+    storage->set(size, value);
+  } else {
+    MutableHandle<Storage> storageHandle{runtime, storage};
+    Storage::push_back(storageHandle, runtime, value);
+    selfHandle->indexedStorage_.set(
+        runtime, storageHandle.get(), runtime.getHeap());
+  }
+  ++selfHandle->endIndex_;
+}
+
+CallResult<bool> ArrayImpl::setPackedElement(
+    Handle<ArrayImpl> selfHandle,
+    Runtime &runtime,
+    size_type index,
+    HermesValue value) {
+  const ElementKind oldKind = selfHandle->getElementKind(runtime);
+  const uint32_t endIndex = selfHandle->endIndex_;
+  assert(oldKind != ElementKind::Generic && "array must be packed");
+  ElementKind kind = std::max(oldKind, elementKindFor(value));
+  // Writing past the end would leave a hole, and the unboxed storage can't
+  // grow past its maximum size.
+  if (index > endIndex ||
+      (index == endIndex && kind != ElementKind::Generic &&
+       endIndex >= maxPackedElements(kind)))
+    kind = ElementKind::Generic;
+
+  if (kind != oldKind) {
+    if (LLVM_UNLIKELY(
+            transitionElementKind(selfHandle, runtime, kind) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (kind == ElementKind::Generic)
+      return false;
+  }
+
+  // Only numbers get here, so value doesn't need to be rooted.
+  const double d = value.getNumber();
+  if (kind == ElementKind::PackedInt32) {
+    if (index < endIndex)
+      selfHandle->getInt32Storage(runtime)->set(index, (int32_t)d);
+    else
+      pushPackedElement<ArrayStorageInt32>(selfHandle, runtime, (int32_t)d);
+  } else {
+    if (index < endIndex)
+      selfHandle->getDoubleStorage(runtime)->set(index, d);
+    else
+      pushPackedElement<ArrayStorageDouble>(selfHandle, runtime, d);
+  }
+  return true;
 }
 
 ExecutionStatus ArrayImpl::setStorageEndIndex(
     Handle<ArrayImpl> selfHandle,
     Runtime &runtime,
     uint32_t newLength) {
+  const ElementKind kind = selfHandle->getElementKind(runtime);
+  if (kind != ElementKind::Generic) {
+    auto *self = selfHandle.get();
+    if (newLength <= self->endIndex_) {
+      // Shrinking keeps the array packed.
+      self->endIndex_ = newLength;
+      if (newLength == 0) {
+        // Remove the storage. If this array grows again it can be
+        // re-allocated.
+        self->indexedStorage_.setNull(runtime.getHeap());
+      } else if (kind == ElementKind::PackedInt32) {
+        self->getInt32Storage(runtime)->resizeWithinCapacity(newLength);
+      } else {
+        self->getDoubleStorage(runtime)->resizeWithinCapacity(newLength);
+      }
+      return ExecutionStatus::RETURNED;
+    }
+    // Growing the storage creates holes, which need the generic kind.
+    if (LLVM_UNLIKELY(
+            transitionElementKind(selfHandle, runtime, ElementKind::Generic) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+
   auto *self = selfHandle.get();
 
   if (LLVM_UNLIKELY(
@@ -158,7 +303,8 @@ ExecutionStatus ArrayImpl::setStorageEndIndex(
 
     if (newLength <= beginIndex) {
       // the new length is prior to beginIndex, clearing the storage.
-      selfHandle->endIndex_ = beginIndex;
+      selfHandle->beginIndex_ = 0;
+      selfHandle->endIndex_ = 0;
       // Remove the storage. If this array grows again it can be re-allocated.
       self->setIndexedStorage(runtime, nullptr, runtime.getHeap());
       return ExecutionStatus::RETURNED;
@@ -189,12 +335,24 @@ CallResult<bool> ArrayImpl::_setOwnIndexedImpl(
     uint32_t index,
     Handle<> value) {
   auto *self = vmcast<ArrayImpl>(selfHandle.get());
-  auto beginIndex = self->beginIndex_;
-  auto endIndex = self->endIndex_;
 
   if (LLVM_UNLIKELY(self->flags_.frozen))
     return false;
 
+  if (self->getElementKind(runtime) != ElementKind::Generic) {
+    auto res = setPackedElement(
+        Handle<ArrayImpl>::vmcast(selfHandle), runtime, index, *value);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (*res)
+      return true;
+    // The array has moved to the generic kind, write the element below.
+    self = vmcast<ArrayImpl>(selfHandle.get());
+  }
+
+  auto beginIndex = self->beginIndex_;
+  auto endIndex = self->endIndex_;
+
   // Check whether the index is within the storage.
   if (LLVM_LIKELY(index >= beginIndex && index < endIndex)) {
     const auto shv = SmallHermesValue::encodeHermesValue(*value, runtime);
@@ -319,6 +477,31 @@ bool ArrayImpl::_deleteOwnIndexedImpl(
     Runtime &runtime,
     uint32_t index) {
   auto *self = vmcast<ArrayImpl>(selfHandle.get());
+  if (index < self->endIndex_ &&
+      self->getElementKind(runtime) != ElementKind::Generic) {
+    // Cannot delete indexed elements if we are sealed.
+    if (LLVM_UNLIKELY(self->flags_.sealed))
+      return false;
+    // Deleting the last element keeps the array packed.
+    if (index == self->endIndex_ - 1) {
+      auto status = setStorageEndIndex(
+          Handle<ArrayImpl>::vmcast(selfHandle), runtime, index);
+      assert(
+          status != ExecutionStatus::EXCEPTION &&
+          "shrinking packed storage failed");
+      (void)status;
+      return true;
+    }
+    // Any other element leaves a hole, which needs the generic kind.
+    auto status = transitionElementKind(
+        Handle<ArrayImpl>::vmcast(selfHandle), runtime, ElementKind::Generic);
+    assert(
+        status != ExecutionStatus::EXCEPTION &&
+        "converting to generic storage failed");
+    (void)status;
+    self = vmcast<ArrayImpl>(selfHandle.get());
+  }
+
   NoAllocScope noAlloc{runtime};
   if (index >= self->beginIndex_ && index < self->endIndex_) {
     auto *indexedStorage = self->getIndexedStorage(runtime);
@@ -348,8 +531,8 @@ bool ArrayImpl::_checkAllOwnIndexedImpl(
 
   // If we have any indexed properties at all, they don't satisfy the
   // requirements.
-  for (uint32_t i = 0, e = self->endIndex_ - self->beginIndex_; i != e; ++i) {
-    if (!self->getIndexedStorage(runtime)->at(runtime, i).isEmpty())
+  for (uint32_t i = self->beginIndex_, e = self->endIndex_; i != e; ++i) {
+    if (!self->unsafeAt(runtime, i).isEmpty())
       return false;
   }
   return true;
@@ -551,7 +734,8 @@ CallResult<Handle<JSArray>> JSArray::create(
       runtime.makeAFixed<JSArray>(
           runtime, prototypeHandle, classHandle, GCPointerBase::NoBarriers()));
 
-  // Only allocate the storage if capacity is not zero.
+  // Only allocate the storage if capacity is not zero. Arrays without storage
+  // are packed, and pick the storage for their elements as they are written.
   if (capacity) {
     if (LLVM_UNLIKELY(capacity > StorageType::maxElements()))
       return runtime.raiseRangeError("Out of memory for array elements");
@@ -118,8 +118,11 @@ JSArrayBuffer::JSArrayBuffer(
 
 void JSArrayBuffer::_finalizeImpl(GCCell *cell, GC &gc) {
   auto *self = vmcast<JSArrayBuffer>(cell);
-  if (self->attached() && !self->external_)
-    self->freeInternalBuffer(gc);
+  if (self->attached() && !self->external_) {
+    // Freeing a large data block can be slow, and nothing else refers to it.
+    gc.deferFinalization(
+        [](void *data) { free(data); }, self->releaseInternalBuffer(gc));
+  }
   self->~JSArrayBuffer();
 }
 
@@ -167,7 +170,7 @@ void JSArrayBuffer::_snapshotAddNodesImpl(
 }
 #endif
 
-void JSArrayBuffer::freeInternalBuffer(GC &gc) {
+uint8_t *JSArrayBuffer::releaseInternalBuffer(GC &gc) {
   uint8_t *data = data_.get(gc);
   assert(attached() && "Buffer must be attached");
   assert((data || size_ == 0) && "Null buffers must have zero size");
@@ -176,7 +179,11 @@ void JSArrayBuffer::freeInternalBuffer(GC &gc) {
   // Need to untrack the native memory that may have been tracked by snapshots.
   gc.debitExternalMemory(this, size_);
   gc.getIDTracker().untrackNative(data);
-  free(data);
+  return data;
+}
+
+void JSArrayBuffer::freeInternalBuffer(GC &gc) {
+  free(releaseInternalBuffer(gc));
 }
 
 ExecutionStatus JSArrayBuffer::detach(
@@ -309,11 +309,12 @@ ExecutionStatus JSError::setMessage(
 /// set. Names are returned in reverse order (topmost frame is first).
 /// In case of error returns a nullptr handle.
 /// \param skipTopFrame if true, skip the top frame.
+/// \param count the maximum number of names to return.
 static Handle<PropStorage> getCallStackFunctionNames(
     Runtime &runtime,
     bool skipTopFrame,
-    size_t sizeHint) {
-  auto arrRes = PropStorage::create(runtime, sizeHint);
+    size_t count) {
+  auto arrRes = PropStorage::create(runtime, count);
   if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
     runtime.clearThrownValue();
     return Runtime::makeNullHandle<PropStorage>();
@@ -329,6 +330,8 @@ static Handle<PropStorage> getCallStackFunctionNames(
   for (StackFramePtr cf : runtime.getStackFrames()) {
     if (frameIndex++ == 0 && skipTopFrame)
       continue;
+    if (namesIndex == count)
+      break;
 
     name = HermesValue::encodeUndefinedValue();
     if (auto callableHandle = Handle<Callable>::dyn_vmcast(
@@ -417,7 +420,12 @@ ExecutionStatus JSError::recordStackTrace(
     return ArrayStorageSmall::push_back(domains, runtime, domain);
   };
 
-  if (!skipTopFrame) {
+  // Only the topmost frames up to the limit are recorded, which keeps throwing
+  // cheap in deep call stacks.
+  const uint32_t limit = runtime.getErrorStackTraceLimit();
+  bool truncated = false;
+
+  if (!skipTopFrame && limit > 0) {
     if (codeBlock) {
       stack->emplace_back(codeBlock, codeBlock->getOffsetOf(ip));
       if (LLVM_UNLIKELY(addDomain(codeBlock) == ExecutionStatus::EXCEPTION)) {
@@ -433,6 +441,10 @@ ExecutionStatus JSError::recordStackTrace(
   // Fill in the call stack.
   // Each stack frame tracks information about the caller.
   for (StackFramePtr cf : runtime.getStackFrames()) {
+    if (stack->size() >= limit) {
+      truncated = true;
+      break;
+    }
     CodeBlock *savedCodeBlock = cf.getSavedCodeBlock();
     const Inst *const savedIP = cf.getSavedIP();
     // Go up one frame and get the callee code block but use the current
@@ -457,8 +469,9 @@ ExecutionStatus JSError::recordStackTrace(
   }
   selfHandle->domains_.set(runtime, domains.get(), runtime.getHeap());
 
-  // Remove the last entry.
-  stack->pop_back();
+  // Remove the last entry, unless the walk stopped before reaching it.
+  if (!truncated)
+    stack->pop_back();
 
   auto funcNames =
       getCallStackFunctionNames(runtime, skipTopFrame, stack->size());
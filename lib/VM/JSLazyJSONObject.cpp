@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/JSLazyJSONObject.h"
+
+#include "hermes/VM/BuildMetadata.h"
+#include "hermes/VM/Runtime-inline.h"
+
+namespace hermes {
+namespace vm {
+
+//===----------------------------------------------------------------------===//
+// class JSLazyJSONObject
+
+const ObjectVTable JSLazyJSONObject::vt{
+    VTable(CellKind::JSLazyJSONObjectKind, cellSize<JSLazyJSONObject>()),
+    JSLazyJSONObject::_getOwnIndexedRangeImpl,
+    JSLazyJSONObject::_haveOwnIndexedImpl,
+    JSLazyJSONObject::_getOwnIndexedPropertyFlagsImpl,
+    JSLazyJSONObject::_getOwnIndexedImpl,
+    JSLazyJSONObject::_setOwnIndexedImpl,
+    JSLazyJSONObject::_deleteOwnIndexedImpl,
+    JSLazyJSONObject::_checkAllOwnIndexedImpl,
+};
+
+void JSLazyJSONObjectBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
+  mb.addJSObjectOverlapSlots(JSObject::numOverlapSlots<JSLazyJSONObject>());
+  JSObjectBuildMeta(cell, mb);
+  const auto *self = static_cast<const JSLazyJSONObject *>(cell);
+  mb.setVTable(&JSLazyJSONObject::vt);
+  mb.addField("source", &self->source_);
+  mb.addField("index", &self->index_);
+}
+
+JSLazyJSONObject::JSLazyJSONObject(
+    Runtime &runtime,
+    Handle<JSObject> parent,
+    Handle<HiddenClass> clazz,
+    Handle<StringPrimitive> source,
+    Handle<JSArrayBuffer> index,
+    uint32_t offset,
+    uint32_t ordinal)
+    : JSObject(runtime, *parent, *clazz),
+      source_(runtime, *source, runtime.getHeap()),
+      index_(runtime, *index, runtime.getHeap()),
+      offset_(offset),
+      ordinal_(ordinal) {
+  assert(source->isExternal() && "lazy JSON source must not move");
+  // The properties are only defined when the object is first used, and may
+  // include index-like keys.
+  flags_.lazyObject = 1;
+  flags_.fastIndexProperties = 0;
+}
+
+PseudoHandle<JSLazyJSONObject> JSLazyJSONObject::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> source,
+    Handle<JSArrayBuffer> index,
+    uint32_t offset,
+    uint32_t ordinal) {
+  auto parentHandle = Handle<JSObject>::vmcast(&runtime.objectPrototype);
+  auto *cell = runtime.makeAFixed<JSLazyJSONObject>(
+      runtime,
+      parentHandle,
+      runtime.getHiddenClassForPrototype(
+          *parentHandle, numOverlapSlots<JSLazyJSONObject>()),
+      source,
+      index,
+      offset,
+      ordinal);
+  return JSObjectInit::initToPseudoHandle(runtime, cell);
+}
+
+} // namespace vm
+} // namespace hermes
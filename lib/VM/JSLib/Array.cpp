@@ -535,12 +535,12 @@ arrayPrototypeToLocaleString(void *, Runtime &runtime, NativeArgs args) {
     return ExecutionStatus::EXCEPTION;
   }
   MutableHandle<StringPrimitive> element{runtime};
-  element = strings->at(runtime, 0).getString(runtime);
+  element = strings->at(runtime, 0).getString();
   builder->appendStringPrim(element);
   for (uint32_t j = 1; j < len; ++j) {
     // Every element after the first needs a separator before it.
     builder->appendCharacter(separator);
-    element = strings->at(runtime, j).getString(runtime);
+    element = strings->at(runtime, j).getString();
     builder->appendStringPrim(element);
   }
   return HermesValue::encodeStringValue(*builder->getStringPrimitive());
@@ -603,11 +603,11 @@ arrayPrototypeAt(void *, Runtime &runtime, NativeArgs args) {
 
   // 7. Return ? Get(O, ! ToString(𝔽(k))).
   if (LLVM_LIKELY(jsArr)) {
-    const SmallHermesValue elm = jsArr->at(runtime, k);
+    const HermesValue elm = jsArr->at(runtime, k);
     if (elm.isEmpty()) {
       return HermesValue::encodeUndefinedValue();
     } else {
-      return elm.unboxToHV(runtime);
+      return elm;
     }
   }
   CallResult<PseudoHandle<>> propRes = JSObject::getComputed_RJS(
@@ -731,15 +731,17 @@ arrayPrototypeConcat(void *, Runtime &runtime, NativeArgs args) {
       // appended to the result array.
       // 5.c.iv. Repeat, while k < len
       for (uint64_t k = 0; k < len; ++k, ++n) {
-        SmallHermesValue subElement = LLVM_LIKELY(arrHandle)
+        HermesValue subElement = LLVM_LIKELY(arrHandle)
             ? arrHandle->at(runtime, k)
-            : SmallHermesValue::encodeEmptyValue();
+            : HermesValue::encodeEmptyValue();
         if (LLVM_LIKELY(!subElement.isEmpty()) &&
             LLVM_LIKELY(n < A->getEndIndex())) {
           // Fast path: quickly set element without making any extra calls.
           // Cast is safe because A->getEndIndex must be in uint32_t range.
+          // Encoding may allocate, so do it before reading A.
+          auto shv = SmallHermesValue::encodeHermesValue(subElement, runtime);
           JSArray::unsafeSetExistingElementAt(
-              A.get(), runtime, static_cast<uint32_t>(n), subElement);
+              A.get(), runtime, static_cast<uint32_t>(n), shv);
         } else {
           // Slow path fallback if there's an empty slot in arr.
           // We have to use getComputedPrimitiveDescriptor because the property
@@ -919,11 +921,11 @@ arrayPrototypeJoin(void *, Runtime &runtime, NativeArgs args) {
     return ExecutionStatus::EXCEPTION;
   }
   MutableHandle<StringPrimitive> element{runtime};
-  element = strings->at(runtime, 0).getString(runtime);
+  element = strings->at(runtime, 0).getString();
   builder->appendStringPrim(element);
   for (size_t i = 1; i < len; ++i) {
     builder->appendStringPrim(sep);
-    element = strings->at(runtime, i).getString(runtime);
+    element = strings->at(runtime, i).getString();
     builder->appendStringPrim(element);
   }
   return HermesValue::encodeStringValue(*builder->getStringPrimitive());
@@ -1013,262 +1015,32 @@ arrayPrototypePush(void *, Runtime &runtime, NativeArgs args) {
 }
 
 namespace {
-/// General object sorting model used by custom sorting routines.
-/// Provides a model by which to less and swap elements, using the [[Get]],
-/// [[Put]], and [[Delete]] internal methods of a supplied Object. Should be
-/// allocated on the stack, because it creates its own internal GCScope, with
-/// reusable MutableHandle<>-s that are used in the less and swap methods.
-/// These allow for quick accesses without allocating a great number of new
-/// handles every time we want to compare different elements.
-/// Usage example:
-///   StandardSortModel sm{runtime, obj, compareFn};
-///   quickSort(sm, 0, length);
-/// Note that this is generic and does nothing different if passed a JSArray.
-class StandardSortModel : public SortModel {
+/// Comparison of the values of an array for Array.prototype.sort. Undefined
+/// values and holes are never compared, because they are set aside before
+/// sorting and go to the end.
+class ArraySortComparator : public SortComparator {
  private:
   /// Runtime to sort in.
   Runtime &runtime_;
 
-  /// Scope to allocate handles in, gets destroyed with this.
-  GCScope gcScope_;
-
   /// JS comparison function, return -1 for less, 0 for equal, 1 for greater.
-  /// If null, then use the built in < operator.
+  /// If null, then compare the string representations of the values.
   Handle<Callable> compareFn_;
 
-  /// Object to sort elements [0, length).
-  Handle<JSObject> obj_;
-
-  /// Temporary handles for property name.
-  MutableHandle<SymbolID> aTmpNameStorage_;
-  MutableHandle<SymbolID> bTmpNameStorage_;
-
-  /// Preallocate handles in the current GCScope so that we don't have to make
-  /// new handles in every method call.
-
-  /// Handles for two indices.
-  MutableHandle<> aHandle_;
-  MutableHandle<> bHandle_;
-
-  /// Handles for the values at two indices.
-  MutableHandle<> aValue_;
-  MutableHandle<> bValue_;
-
-  /// Handles for the objects the values are retrieved from.
-  MutableHandle<JSObject> aDescObjHandle_;
-  MutableHandle<JSObject> bDescObjHandle_;
-
-  /// Marker created after initializing all fields so handles allocated later
-  /// can be flushed.
-  GCScope::Marker gcMarker_;
-
  public:
-  StandardSortModel(
-      Runtime &runtime,
-      Handle<JSObject> obj,
-      Handle<Callable> compareFn)
-      : runtime_(runtime),
-        gcScope_(runtime),
-        compareFn_(compareFn),
-        obj_(obj),
-        aTmpNameStorage_(runtime),
-        bTmpNameStorage_(runtime),
-        aHandle_(runtime),
-        bHandle_(runtime),
-        aValue_(runtime),
-        bValue_(runtime),
-        aDescObjHandle_(runtime),
-        bDescObjHandle_(runtime),
-        gcMarker_(gcScope_.createMarker()) {}
-
-  /// Use getComputed and putComputed to swap the values at obj[a] and obj[b].
-  ExecutionStatus swap(uint32_t a, uint32_t b) override {
-    // Ensure that we don't leave here with any new handles.
-    GCScopeMarkerRAII gcMarker{gcScope_, gcMarker_};
-
-    aHandle_ = HermesValue::encodeDoubleValue(a);
-    bHandle_ = HermesValue::encodeDoubleValue(b);
-
-    ComputedPropertyDescriptor aDesc;
-    JSObject::getComputedPrimitiveDescriptor(
-        obj_, runtime_, aHandle_, aDescObjHandle_, aTmpNameStorage_, aDesc);
-
-    ComputedPropertyDescriptor bDesc;
-    JSObject::getComputedPrimitiveDescriptor(
-        obj_, runtime_, bHandle_, bDescObjHandle_, bTmpNameStorage_, bDesc);
-
-    if (aDescObjHandle_) {
-      if (LLVM_LIKELY(!aDesc.flags.proxyObject)) {
-        auto res = JSObject::getComputedPropertyValue_RJS(
-            obj_,
-            runtime_,
-            aDescObjHandle_,
-            aTmpNameStorage_,
-            aDesc,
-            aDescObjHandle_);
-        if (res == ExecutionStatus::EXCEPTION) {
-          return ExecutionStatus::EXCEPTION;
-        }
-        if (LLVM_LIKELY(!(*res)->isEmpty())) {
-          aValue_ = std::move(*res);
-        }
-      } else {
-        auto keyRes = toPropertyKey(runtime_, aHandle_);
-        if (keyRes == ExecutionStatus::EXCEPTION) {
-          return ExecutionStatus::EXCEPTION;
-        }
-        aHandle_ = keyRes->get();
-        CallResult<bool> hasPropRes = JSProxy::getOwnProperty(
-            aDescObjHandle_, runtime_, aHandle_, aDesc, nullptr);
-        if (hasPropRes == ExecutionStatus::EXCEPTION) {
-          return ExecutionStatus::EXCEPTION;
-        }
-        if (*hasPropRes) {
-          auto res =
-              JSProxy::getComputed(aDescObjHandle_, runtime_, aHandle_, obj_);
-          if (res == ExecutionStatus::EXCEPTION) {
-            return ExecutionStatus::EXCEPTION;
-          }
-          aValue_ = std::move(*res);
-        } else {
-          aDescObjHandle_ = nullptr;
-        }
-      }
-    }
-    if (bDescObjHandle_) {
-      if (LLVM_LIKELY(!bDesc.flags.proxyObject)) {
-        auto res = JSObject::getComputedPropertyValue_RJS(
-            obj_,
-            runtime_,
-            bDescObjHandle_,
-            bTmpNameStorage_,
-            bDesc,
-            bDescObjHandle_);
-        if (res == ExecutionStatus::EXCEPTION) {
-          return ExecutionStatus::EXCEPTION;
-        }
-        if (LLVM_LIKELY(!(*res)->isEmpty())) {
-          bValue_ = std::move(*res);
-        }
-      } else {
-        auto keyRes = toPropertyKey(runtime_, bHandle_);
-        if (keyRes == ExecutionStatus::EXCEPTION) {
-          return ExecutionStatus::EXCEPTION;
-        }
-        bHandle_ = keyRes->get();
-        CallResult<bool> hasPropRes = JSProxy::getOwnProperty(
-            bDescObjHandle_, runtime_, bHandle_, bDesc, nullptr);
-        if (hasPropRes == ExecutionStatus::EXCEPTION) {
-          return ExecutionStatus::EXCEPTION;
-        }
-        if (*hasPropRes) {
-          auto res =
-              JSProxy::getComputed(bDescObjHandle_, runtime_, bHandle_, obj_);
-          if (res == ExecutionStatus::EXCEPTION) {
-            return ExecutionStatus::EXCEPTION;
-          }
-          bValue_ = std::move(*res);
-        } else {
-          bDescObjHandle_ = nullptr;
-        }
-      }
-    }
-
-    if (bDescObjHandle_) {
-      if (LLVM_UNLIKELY(
-              JSObject::putComputed_RJS(
-                  obj_,
-                  runtime_,
-                  aHandle_,
-                  bValue_,
-                  PropOpFlags().plusThrowOnError()) ==
-              ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-    } else {
-      if (LLVM_UNLIKELY(
-              JSObject::deleteComputed(
-                  obj_, runtime_, aHandle_, PropOpFlags().plusThrowOnError()) ==
-              ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-    }
-
-    if (aDescObjHandle_) {
-      if (LLVM_UNLIKELY(
-              JSObject::putComputed_RJS(
-                  obj_,
-                  runtime_,
-                  bHandle_,
-                  aValue_,
-                  PropOpFlags().plusThrowOnError()) ==
-              ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-    } else {
-      if (LLVM_UNLIKELY(
-              JSObject::deleteComputed(
-                  obj_, runtime_, bHandle_, PropOpFlags().plusThrowOnError()) ==
-              ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-    }
+  ArraySortComparator(Runtime &runtime, Handle<Callable> compareFn)
+      : runtime_(runtime), compareFn_(compareFn) {}
 
-    return ExecutionStatus::RETURNED;
-  }
-
-  /// If compareFn isn't null, return compareFn(obj[a], obj[b])
-  /// If compareFn is null, return -1 if obj[a] < obj[b], 1 if obj[a] > obj[b],
-  /// 0 otherwise
-  CallResult<int> compare(uint32_t a, uint32_t b) override {
+  /// If compareFn isn't null, return compareFn(a, b)
+  /// If compareFn is null, return -1 if String(a) < String(b), 1 if
+  /// String(a) > String(b), 0 otherwise
+  CallResult<int> compare(Handle<> a, Handle<> b) override {
     // Ensure that we don't leave here with any new handles.
-    GCScopeMarkerRAII gcMarker{gcScope_, gcMarker_};
-
-    aHandle_ = HermesValue::encodeDoubleValue(a);
-    bHandle_ = HermesValue::encodeDoubleValue(b);
-
-    ComputedPropertyDescriptor aDesc;
-    JSObject::getComputedPrimitiveDescriptor(
-        obj_, runtime_, aHandle_, aDescObjHandle_, aTmpNameStorage_, aDesc);
-    CallResult<PseudoHandle<>> propRes = JSObject::getComputedPropertyValue_RJS(
-        obj_, runtime_, aDescObjHandle_, aTmpNameStorage_, aDesc, aHandle_);
-    if (propRes == ExecutionStatus::EXCEPTION) {
-      return ExecutionStatus::EXCEPTION;
-    }
-    if ((*propRes)->isEmpty()) {
-      // Spec defines empty as greater than everything.
-      return 1;
-    }
-    aValue_ = std::move(*propRes);
-    assert(!aValue_->isEmpty());
+    GCScopeMarkerRAII gcMarker{runtime_};
 
-    ComputedPropertyDescriptor bDesc;
-    JSObject::getComputedPrimitiveDescriptor(
-        obj_, runtime_, bHandle_, bDescObjHandle_, bTmpNameStorage_, bDesc);
-    if ((propRes = JSObject::getComputedPropertyValue_RJS(
-             obj_,
-             runtime_,
-             bDescObjHandle_,
-             bTmpNameStorage_,
-             bDesc,
-             bHandle_)) == ExecutionStatus::EXCEPTION) {
-      return ExecutionStatus::EXCEPTION;
-    }
-    if ((*propRes)->isEmpty()) {
-      // Spec defines empty as greater than everything.
-      return -1;
-    }
-    bValue_ = std::move(*propRes);
-    assert(!bValue_->isEmpty());
-
-    if (aValue_->isUndefined()) {
-      // Spec defines undefined as greater than everything.
-      return 1;
-    }
-    if (bValue_->isUndefined()) {
-      // Spec defines undefined as greater than everything.
-      return -1;
-    }
+    assert(
+        !a->isEmpty() && !a->isUndefined() && !b->isEmpty() &&
+        !b->isUndefined() && "holes and undefined are not sorted");
 
     if (compareFn_) {
       // If we have a compareFn, just use that.
@@ -1276,8 +1048,8 @@ class StandardSortModel : public SortModel {
           compareFn_,
           runtime_,
           Runtime::getUndefinedValue(),
-          aValue_.get(),
-          bValue_.get());
+          a.getHermesValue(),
+          b.getHermesValue());
       if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
@@ -1291,23 +1063,71 @@ class StandardSortModel : public SortModel {
       return (res < 0) ? -1 : (res > 0 ? 1 : 0);
     } else {
       // Convert both arguments to strings and compare
-      auto aValueRes = toString_RJS(runtime_, aValue_);
+      auto aValueRes = toString_RJS(runtime_, a);
       if (LLVM_UNLIKELY(aValueRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
-      aValue_ = aValueRes->getHermesValue();
+      auto aValue = runtime_.makeHandle(std::move(*aValueRes));
 
-      auto bValueRes = toString_RJS(runtime_, bValue_);
+      auto bValueRes = toString_RJS(runtime_, b);
       if (LLVM_UNLIKELY(bValueRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
-      bValue_ = bValueRes->getHermesValue();
 
-      return aValue_->getString()->compare(bValue_->getString());
+      return aValue->compare(bValueRes->get());
     }
   }
 };
 
+/// Add \p value to the values to sort in \p values, or count it in
+/// \p numUndefined if it is undefined.
+ExecutionStatus collectSortValue(
+    Runtime &runtime,
+    MutableHandle<SegmentedArray> &values,
+    uint64_t &numUndefined,
+    Handle<> value) {
+  if (value->isUndefined()) {
+    ++numUndefined;
+    return ExecutionStatus::RETURNED;
+  }
+  return SegmentedArray::push_back(values, runtime, value);
+}
+
+/// Sort \p values and put them back at the start of \p O, followed by
+/// \p numUndefined undefined values.
+ExecutionStatus sortAndPutBack(
+    Runtime &runtime,
+    Handle<JSObject> O,
+    Handle<Callable> compareFn,
+    Handle<SegmentedArray> values,
+    uint64_t numUndefined) {
+  {
+    ArraySortComparator cmp(runtime, compareFn);
+    if (LLVM_UNLIKELY(
+            timSort(runtime, &cmp, values) == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+
+  MutableHandle<> propName{runtime};
+  MutableHandle<> propVal{runtime};
+  GCScopeMarkerRAII gcMarker{runtime};
+  uint32_t numValues = values->size(runtime);
+  for (uint64_t i = 0, e = numValues + numUndefined; i != e; ++i) {
+    gcMarker.flush();
+
+    propVal = i < numValues ? values->at(runtime, i)
+                            : HermesValue::encodeUndefinedValue();
+    propName = HermesValue::encodeNumberValue(i);
+
+    if (JSObject::putComputed_RJS(
+            O, runtime, propName, propVal, PropOpFlags().plusThrowOnError()) ==
+        ExecutionStatus::EXCEPTION) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  return ExecutionStatus::RETURNED;
+}
+
 /// Perform a sort of a sparse object by querying its properties first.
 /// It cannot be a proxy or a host object because they are not guaranteed to
 /// be able to list their properties.
@@ -1329,23 +1149,17 @@ CallResult<HermesValue> sortSparse(
   auto crNames = JSObject::getOwnPropertyNames(O, runtime, false);
   if (crNames == ExecutionStatus::EXCEPTION)
     return ExecutionStatus::EXCEPTION;
-  // Get the underlying storage containing the names.
-  auto names = runtime.makeHandle((*crNames)->getIndexedStorage(runtime));
-  if (!names) {
-    // Indexed storage can be null if there's nothing to store.
-    return O.getHermesValue();
-  }
+  Handle<JSArray> names = *crNames;
 
   // Find out how many sortable numeric properties we have.
-  JSArray::StorageType::size_type numProps = 0;
-  for (JSArray::StorageType::size_type e = names->size(runtime); numProps != e;
-       ++numProps) {
-    SmallHermesValue hv = names->at(runtime, numProps);
+  JSArray::size_type numProps = 0;
+  for (JSArray::size_type e = names->getEndIndex(); numProps != e; ++numProps) {
+    HermesValue hv = names->at(runtime, numProps);
     // Stop at the first non-number.
     if (!hv.isNumber())
       break;
     // Stop if the property name is beyond "len".
-    if (hv.getNumber(runtime) >= len)
+    if (hv.getNumber() >= len)
       break;
   }
 
@@ -1353,27 +1167,23 @@ CallResult<HermesValue> sortSparse(
   if (numProps == 0)
     return O.getHermesValue();
 
-  // Create a new array which we will actually sort.
-  auto crArray = JSArray::create(runtime, numProps, numProps);
-  if (crArray == ExecutionStatus::EXCEPTION)
-    return ExecutionStatus::EXCEPTION;
-  auto array = *crArray;
-  if (JSArray::setStorageEndIndex(array, runtime, numProps) ==
-      ExecutionStatus::EXCEPTION) {
+  // Create a buffer which we will actually sort.
+  auto crValues = SegmentedArray::create(runtime, numProps);
+  if (crValues == ExecutionStatus::EXCEPTION)
     return ExecutionStatus::EXCEPTION;
-  }
+  MutableHandle<SegmentedArray> values{runtime, crValues->get()};
+  uint64_t numUndefined = 0;
 
   MutableHandle<> propName{runtime};
-  MutableHandle<> propVal{runtime};
   GCScopeMarkerRAII gcMarker{gcScope};
 
-  // Copy all sortable properties into the array and delete them from the
+  // Copy all sortable properties into the buffer and delete them from the
   // source. Deleting all sortable properties makes it easy to just copy the
   // sorted result back in the end.
   for (decltype(numProps) i = 0; i != numProps; ++i) {
     gcMarker.flush();
 
-    propName = names->at(runtime, i).unboxToHV(runtime);
+    propName = names->at(runtime, i);
     auto res = JSObject::getComputed_RJS(O, runtime, propName);
     if (res == ExecutionStatus::EXCEPTION)
       return ExecutionStatus::EXCEPTION;
@@ -1381,8 +1191,14 @@ CallResult<HermesValue> sortSparse(
     if (res->getHermesValue().isEmpty())
       continue;
 
-    const auto shv = SmallHermesValue::encodeHermesValue(res->get(), runtime);
-    JSArray::unsafeSetExistingElementAt(*array, runtime, i, shv);
+    if (collectSortValue(
+            runtime,
+            values,
+            numUndefined,
+            runtime.makeHandle(std::move(*res))) ==
+        ExecutionStatus::EXCEPTION) {
+      return ExecutionStatus::EXCEPTION;
+    }
 
     if (JSObject::deleteComputed(
             O, runtime, propName, PropOpFlags().plusThrowOnError()) ==
@@ -1392,39 +1208,20 @@ CallResult<HermesValue> sortSparse(
   }
   gcMarker.flush();
 
-  {
-    StandardSortModel sm(runtime, array, compareFn);
-    if (LLVM_UNLIKELY(
-            quickSort(&sm, 0u, numProps) == ExecutionStatus::EXCEPTION))
-      return ExecutionStatus::EXCEPTION;
-  }
-
-  // Time to copy back the values.
-  for (decltype(numProps) i = 0; i != numProps; ++i) {
-    gcMarker.flush();
-
-    auto hv = array->at(runtime, i).unboxToHV(runtime);
-    assert(
-        !hv.isEmpty() &&
-        "empty values cannot appear in the array out of nowhere");
-    propVal = hv;
-
-    propName = HermesValue::encodeNumberValue(i);
-
-    if (JSObject::putComputed_RJS(
-            O, runtime, propName, propVal, PropOpFlags().plusThrowOnError()) ==
-        ExecutionStatus::EXCEPTION) {
-      return ExecutionStatus::EXCEPTION;
-    }
-  }
+  if (LLVM_UNLIKELY(
+          sortAndPutBack(runtime, O, compareFn, values, numUndefined) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
 
   return O.getHermesValue();
 }
 } // anonymous namespace
 
-/// ES5.1 15.4.4.11.
+/// ES2023 23.1.3.30.
 CallResult<HermesValue>
 arrayPrototypeSort(void *, Runtime &runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+
   // Null if not a callable compareFn.
   auto compareFn = Handle<Callable>::dyn_vmcast(args.getArgHandle(0));
   if (!args.getArg(0).isUndefined() && !compareFn) {
@@ -1454,15 +1251,78 @@ arrayPrototypeSort(void *, Runtime &runtime, NativeArgs args) {
   if (!O->isProxyObject() && !O->isHostObject() && !O->hasFastIndexProperties())
     return sortSparse(runtime, O, compareFn, len);
 
-  // This is the "fast" path. We are sorting an array with indexed storage.
-  StandardSortModel sm(runtime, O, compareFn);
+  // This is the "fast" path. SortIndexedProperties: read all the values into
+  // a buffer once, sort it, and write them back once, so the comparisons and
+  // moves of the sort don't access the object.
+  auto crValues = SegmentedArray::create(
+      runtime, std::min<uint64_t>(len, SegmentedArray::maxElements()));
+  if (LLVM_UNLIKELY(crValues == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  MutableHandle<SegmentedArray> values{runtime, crValues->get()};
+  uint64_t numUndefined = 0;
 
-  // Use our custom sort routine. We can't use std::sort because it performs
-  // optimizations that allow it to bypass calls to std::swap, but our swap
-  // function is special, since it needs to use the internal Object functions.
-  if (LLVM_UNLIKELY(quickSort(&sm, 0u, len) == ExecutionStatus::EXCEPTION))
+  MutableHandle<> k{runtime};
+  MutableHandle<> kValue{runtime};
+  GCScopeMarkerRAII gcMarker{gcScope};
+  for (uint64_t i = 0; i < len; ++i) {
+    gcMarker.flush();
+
+    // Fast path: read the element of a regular array directly. This has to
+    // be checked again every time, because a getter may change the array.
+    auto *arr = dyn_vmcast<JSArray>(O.get());
+    if (LLVM_LIKELY(arr && arr->hasFastIndexProperties()) &&
+        i < arr->getEndIndex()) {
+      HermesValue elem = arr->at(runtime, i);
+      if (LLVM_LIKELY(!elem.isEmpty())) {
+        kValue = elem;
+        if (LLVM_UNLIKELY(
+                collectSortValue(runtime, values, numUndefined, kValue) ==
+                ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        continue;
+      }
+    }
+
+    // Slow path: holes are skipped, but the property may also exist anywhere
+    // in the prototype chain.
+    k = HermesValue::encodeNumberValue(i);
+    auto hasRes = JSObject::hasComputed(O, runtime, k);
+    if (LLVM_UNLIKELY(hasRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (!*hasRes)
+      continue;
+    auto getRes = JSObject::getComputed_RJS(O, runtime, k);
+    if (LLVM_UNLIKELY(getRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    kValue = std::move(*getRes);
+    if (LLVM_UNLIKELY(
+            collectSortValue(runtime, values, numUndefined, kValue) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  gcMarker.flush();
+
+  if (LLVM_UNLIKELY(
+          sortAndPutBack(runtime, O, compareFn, values, numUndefined) ==
+          ExecutionStatus::EXCEPTION))
     return ExecutionStatus::EXCEPTION;
 
+  // Delete the remaining properties, which were holes. A regular array has
+  // no indexed properties past its storage.
+  uint64_t deleteEnd = len;
+  auto *arr = dyn_vmcast<JSArray>(O.get());
+  if (arr && arr->hasFastIndexProperties())
+    deleteEnd = std::min<uint64_t>(len, arr->getEndIndex());
+  for (uint64_t i = values->size(runtime) + numUndefined; i < deleteEnd; ++i) {
+    gcMarker.flush();
+    k = HermesValue::encodeNumberValue(i);
+    if (LLVM_UNLIKELY(
+            JSObject::deleteComputed(
+                O, runtime, k, PropOpFlags().plusThrowOnError()) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+
   return O.getHermesValue();
 }
 
@@ -20,12 +20,16 @@
 #include "hermes/VM/JSArrayBuffer.h"
 #include "hermes/VM/JSLib.h"
 #include "hermes/VM/JSLib/RuntimeCommonStorage.h"
+#include "hermes/VM/JSLib/RuntimeJSONUtils.h"
 #include "hermes/VM/JSTypedArray.h"
 #include "hermes/VM/JSWeakMapImpl.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/StackFrame-inline.h"
 #include "hermes/VM/StringView.h"
 
+#include "llvh/Support/raw_ostream.h"
+
+#include <climits>
 #include <cstring>
 #include <random>
 #pragma GCC diagnostic push
@@ -808,6 +812,95 @@ hermesInternalFuzzilli(void *, Runtime &runtime, NativeArgs args) {
 }
 #endif // HERMES_ENABLE_FUZZILLI
 
+/// HermesInternal.jsonStringifyToArrayBuffer(value, replacer, space)
+/// Like JSON.stringify(), but \return the result encoded as UTF-8 in an
+/// ArrayBuffer, without creating an intermediate string. Returns undefined
+/// when JSON.stringify() would.
+CallResult<HermesValue> hermesInternalJSONStringifyToArrayBuffer(
+    void *,
+    Runtime &runtime,
+    NativeArgs args) {
+  llvh::SmallVector<char, 0> utf8;
+  llvh::raw_svector_ostream os{utf8};
+  auto res = runtimeJSONStringifyTo(
+      runtime,
+      args.getArgHandle(0),
+      args.getArgHandle(1),
+      args.getArgHandle(2),
+      os);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (!*res) {
+    return HermesValue::encodeUndefinedValue();
+  }
+
+  auto buffer = runtime.makeHandle(JSArrayBuffer::create(
+      runtime, Handle<JSObject>::vmcast(&runtime.arrayBufferPrototype)));
+  if (LLVM_UNLIKELY(
+          JSArrayBuffer::createDataBlock(
+              runtime, buffer, utf8.size(), false) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (!utf8.empty())
+    memcpy(buffer->getDataBlock(runtime), utf8.data(), utf8.size());
+  return buffer.getHermesValue();
+}
+
+/// HermesInternal.jsonStringifyToFd(fd, value, replacer, space)
+/// Like JSON.stringify(), but write the result encoded as UTF-8 to the open
+/// file descriptor \p fd as it is produced, so that the whole result is never
+/// held in memory. The descriptor is not closed. If serialization throws, the
+/// output written so far is left in place.
+/// \return the number of bytes written, or undefined when JSON.stringify()
+///   would return undefined.
+CallResult<HermesValue>
+hermesInternalJSONStringifyToFd(void *, Runtime &runtime, NativeArgs args) {
+  double fd = args.getArg(0).isNumber() ? args.getArg(0).getNumber() : -1;
+  if (!(fd >= 0 && fd <= INT_MAX && fd == (int)fd)) {
+    return runtime.raiseTypeError("fd must be a file descriptor");
+  }
+
+  llvh::raw_fd_ostream os{(int)fd, /* shouldClose */ false};
+  uint64_t start = os.tell();
+  auto res = runtimeJSONStringifyTo(
+      runtime,
+      args.getArgHandle(1),
+      args.getArgHandle(2),
+      args.getArgHandle(3),
+      os);
+  os.flush();
+  if (LLVM_UNLIKELY(os.has_error())) {
+    std::string msg = os.error().message();
+    os.clear_error();
+    if (res != ExecutionStatus::EXCEPTION) {
+      return runtime.raiseError(
+          TwineChar16("jsonStringifyToFd: ") + llvh::StringRef(msg));
+    }
+  }
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (!*res) {
+    return HermesValue::encodeUndefinedValue();
+  }
+  return HermesValue::encodeNumberValue(os.tell() - start);
+}
+
+/// HermesInternal.jsonParseLazy(text)
+/// Like JSON.parse() without a reviver, but the properties of each object
+/// are only parsed when the object is first used. The whole text is still
+/// validated up front.
+CallResult<HermesValue>
+hermesInternalJSONParseLazy(void *, Runtime &runtime, NativeArgs args) {
+  auto res = toString_RJS(runtime, args.getArgHandle(0));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return runtimeJSONParseLazy(runtime, runtime.makeHandle(std::move(*res)));
+}
+
 Handle<JSObject> createHermesInternalObject(
     Runtime &runtime,
     const JSLibFlags &flags) {
@@ -907,6 +1000,13 @@ Handle<JSObject> createHermesInternalObject(
   defineInternMethod(P::ttiReached, hermesInternalTTIReached);
   defineInternMethod(P::ttrcReached, hermesInternalTTRCReached);
   defineInternMethod(P::getFunctionLocation, hermesInternalGetFunctionLocation);
+  defineInternMethodAndSymbol(
+      "jsonStringifyToArrayBuffer",
+      hermesInternalJSONStringifyToArrayBuffer,
+      3);
+  defineInternMethodAndSymbol(
+      "jsonStringifyToFd", hermesInternalJSONStringifyToFd, 4);
+  defineInternMethodAndSymbol("jsonParseLazy", hermesInternalJSONParseLazy, 1);
 
   // HermesInternal function that are only meant to be used for testing purpose.
   // They can change language semantics and are security risks.
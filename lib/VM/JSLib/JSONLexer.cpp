@@ -7,11 +7,21 @@
 
 #include "JSONLexer.h"
 
+#include "hermes/Support/Conversions.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "llvh/ADT/ScopeExit.h"
+#include "llvh/Support/MathExtras.h"
 
 #include "dtoa/dtoa.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HERMES_JSON_LEXER_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HERMES_JSON_LEXER_NEON
+#endif
+
 namespace hermes {
 namespace vm {
 
@@ -24,11 +34,128 @@ static bool isJSONWhiteSpace(char16_t ch) {
   return (ch == u'\t' || ch == u'\r' || ch == u'\n' || ch == u' ');
 }
 
-ExecutionStatus JSONLexer::advance() {
-  // Skip whitespaces.
-  while (curCharPtr_.hasChar() && isJSONWhiteSpace(*curCharPtr_)) {
-    ++curCharPtr_;
+/// \return true if \p ch ends a run of characters that can be copied
+/// verbatim into a JSONString: a quote, a backslash or a control character.
+static bool isJSONStringSpecial(char16_t ch) {
+  return ch == u'"' || ch == u'\\' || ch <= u'\u001F';
+}
+
+#if defined(HERMES_JSON_LEXER_SSE2) || defined(HERMES_JSON_LEXER_NEON)
+/// Number of char16_t units compared at once.
+static constexpr size_t kVectorUnits = 8;
+#endif
+
+/// \return the index of the lowest set unit in the 8 x 16-bit comparison
+/// result \p mask, or kVectorUnits if there is none.
+#if defined(HERMES_JSON_LEXER_SSE2)
+static inline size_t firstSetUnit(__m128i mask) {
+  unsigned bits = _mm_movemask_epi8(mask);
+  return bits ? llvh::countTrailingZeros(bits) / 2 : kVectorUnits;
+}
+#elif defined(HERMES_JSON_LEXER_NEON)
+static inline size_t firstSetUnit(uint16x8_t mask) {
+  // Narrow every 16-bit lane to 8 bits, so the mask fits in 64 bits.
+  uint64_t bits =
+      vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(mask, 4)), 0);
+  return bits ? llvh::countTrailingZeros(bits) / 8 : kVectorUnits;
+}
+#endif
+
+/// \return a pointer to the first unit in [cur, end) for which
+/// isJSONStringSpecial() is true, or \p end if there is none.
+static const char16_t *findJSONStringSpecial(
+    const char16_t *cur,
+    const char16_t *end) {
+#if defined(HERMES_JSON_LEXER_SSE2)
+  const __m128i quote = _mm_set1_epi16(u'"');
+  const __m128i backslash = _mm_set1_epi16(u'\\');
+  const __m128i maxControl = _mm_set1_epi16(0x1F);
+  for (; end - cur >= (ptrdiff_t)kVectorUnits; cur += kVectorUnits) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur));
+    // Unsigned v <= 0x1F iff the saturating subtraction is zero.
+    __m128i mask = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi16(v, quote), _mm_cmpeq_epi16(v, backslash)),
+        _mm_cmpeq_epi16(_mm_subs_epu16(v, maxControl), _mm_setzero_si128()));
+    size_t idx = firstSetUnit(mask);
+    if (idx != kVectorUnits)
+      return cur + idx;
+  }
+#elif defined(HERMES_JSON_LEXER_NEON)
+  const uint16x8_t quote = vdupq_n_u16(u'"');
+  const uint16x8_t backslash = vdupq_n_u16(u'\\');
+  const uint16x8_t maxControl = vdupq_n_u16(0x1F);
+  for (; end - cur >= (ptrdiff_t)kVectorUnits; cur += kVectorUnits) {
+    uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t *>(cur));
+    uint16x8_t mask = vorrq_u16(
+        vorrq_u16(vceqq_u16(v, quote), vceqq_u16(v, backslash)),
+        vcleq_u16(v, maxControl));
+    size_t idx = firstSetUnit(mask);
+    if (idx != kVectorUnits)
+      return cur + idx;
+  }
+#endif
+  while (cur != end && !isJSONStringSpecial(*cur))
+    ++cur;
+  return cur;
+}
+
+/// \return a pointer to the first unit in [cur, end) that is not
+/// JSONWhiteSpace, or \p end if there is none.
+static const char16_t *skipJSONWhiteSpace(
+    const char16_t *cur,
+    const char16_t *end) {
+  // Whitespace runs are usually short, so only vectorize once the scalar loop
+  // has seen a few units of indentation.
+  for (size_t i = 0; i < 4; ++i, ++cur) {
+    if (cur == end || !isJSONWhiteSpace(*cur))
+      return cur;
+  }
+#if defined(HERMES_JSON_LEXER_SSE2)
+  const __m128i space = _mm_set1_epi16(u' ');
+  const __m128i tab = _mm_set1_epi16(u'\t');
+  const __m128i cr = _mm_set1_epi16(u'\r');
+  const __m128i lf = _mm_set1_epi16(u'\n');
+  for (; end - cur >= (ptrdiff_t)kVectorUnits; cur += kVectorUnits) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur));
+    __m128i ws = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi16(v, space), _mm_cmpeq_epi16(v, tab)),
+        _mm_or_si128(_mm_cmpeq_epi16(v, cr), _mm_cmpeq_epi16(v, lf)));
+    size_t idx = firstSetUnit(_mm_xor_si128(ws, _mm_set1_epi16(-1)));
+    if (idx != kVectorUnits)
+      return cur + idx;
+  }
+#elif defined(HERMES_JSON_LEXER_NEON)
+  const uint16x8_t space = vdupq_n_u16(u' ');
+  const uint16x8_t tab = vdupq_n_u16(u'\t');
+  const uint16x8_t cr = vdupq_n_u16(u'\r');
+  const uint16x8_t lf = vdupq_n_u16(u'\n');
+  for (; end - cur >= (ptrdiff_t)kVectorUnits; cur += kVectorUnits) {
+    uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t *>(cur));
+    uint16x8_t ws = vorrq_u16(
+        vorrq_u16(vceqq_u16(v, space), vceqq_u16(v, tab)),
+        vorrq_u16(vceqq_u16(v, cr), vceqq_u16(v, lf)));
+    size_t idx = firstSetUnit(vmvnq_u16(ws));
+    if (idx != kVectorUnits)
+      return cur + idx;
+  }
+#endif
+  while (cur != end && isJSONWhiteSpace(*cur))
+    ++cur;
+  return cur;
+}
+
+void JSONLexer::skipWhiteSpace() {
+  while (curCharPtr_.hasChar()) {
+    llvh::ArrayRef<char16_t> buf = curCharPtr_.getBuffered();
+    const char16_t *next = skipJSONWhiteSpace(buf.begin(), buf.end());
+    curCharPtr_ += next - buf.begin();
+    if (next != buf.end())
+      return;
   }
+}
+
+ExecutionStatus JSONLexer::advance() {
+  skipWhiteSpace();
 
   // End of buffer.
   if (!curCharPtr_.hasChar()) {
@@ -67,13 +194,23 @@ ExecutionStatus JSONLexer::advance() {
       return scanNumber();
 
     case u'"':
-      return scanString();
+      return scanString<false>();
 
     default:
       return errorWithChar(u"Unexpected token: ", *curCharPtr_);
   }
 }
 
+ExecutionStatus JSONLexer::advanceStrAsSymbol() {
+  skipWhiteSpace();
+
+  if (curCharPtr_.hasChar() && *curCharPtr_ == u'"') {
+    token_.setFirstChar(u'"');
+    return scanString<true>();
+  }
+  return advance();
+}
+
 CallResult<char16_t> JSONLexer::consumeUnicode() {
   uint16_t val = 0;
   for (unsigned i = 0; i < 4; ++i) {
@@ -125,6 +262,7 @@ ExecutionStatus JSONLexer::scanNumber() {
   return ExecutionStatus::RETURNED;
 }
 
+template <bool ForKey>
 ExecutionStatus JSONLexer::scanString() {
   assert(*curCharPtr_ == '"');
   ++curCharPtr_;
@@ -139,11 +277,33 @@ ExecutionStatus JSONLexer::scanString() {
       llvh::make_scope_exit([this] { curCharPtr_.cancelCapture(); });
 
   while (curCharPtr_.hasChar()) {
+    // Skip the run of characters that need no processing in bulk.
+    llvh::ArrayRef<char16_t> buf = curCharPtr_.getBuffered();
+    const char16_t *special = findJSONStringSpecial(buf.begin(), buf.end());
+    if (hasEscape)
+      tmpStorage.append(buf.begin(), special);
+    curCharPtr_ += special - buf.begin();
+    if (special == buf.end())
+      continue;
+
     if (*curCharPtr_ == '"') {
       // End of string.
       llvh::ArrayRef<char16_t> strRef =
           hasEscape ? tmpStorage.arrayRef() : curCharPtr_.endCapture();
       ++curCharPtr_;
+      if (validateOnly_) {
+        token_.setStringWithoutValue();
+        return ExecutionStatus::RETURNED;
+      }
+      if (ForKey && !toArrayIndex(strRef.begin(), strRef.end())) {
+        auto symRes =
+            runtime_.getIdentifierTable().getSymbolHandle(runtime_, strRef);
+        if (LLVM_UNLIKELY(symRes == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        token_.setSymbol(*symRes);
+        return ExecutionStatus::RETURNED;
+      }
       // If the string exists in the identifier table, use that one.
       if (auto existing =
               runtime_.getIdentifierTable().getExistingStringPrimitiveOrNull(
@@ -160,63 +320,58 @@ ExecutionStatus JSONLexer::scanString() {
     } else if (*curCharPtr_ <= '\u001F') {
       return error(u"U+0000 thru U+001F is not allowed in string");
     }
-    if (*curCharPtr_ == u'\\') {
-      if (!hasEscape) {
-        // This is the first escape character encountered, so append everything
-        // we've seen so far to tmpStorage.
-        tmpStorage.append(curCharPtr_.endCapture());
-      }
-      hasEscape = true;
-      ++curCharPtr_;
-      if (!curCharPtr_.hasChar()) {
-        return error("Unexpected end of input");
-      }
-      switch (*curCharPtr_) {
-        case u'"':
-        case u'/':
-        case u'\\':
-          tmpStorage.push_back(*curCharPtr_);
-          ++curCharPtr_;
-          break;
-
-        case 'b':
-          ++curCharPtr_;
-          tmpStorage.push_back(8);
-          break;
-        case 'f':
-          ++curCharPtr_;
-          tmpStorage.push_back(12);
-          break;
-        case 'n':
-          ++curCharPtr_;
-          tmpStorage.push_back(10);
-          break;
-        case 'r':
-          ++curCharPtr_;
-          tmpStorage.push_back(13);
-          break;
-        case 't':
-          ++curCharPtr_;
-          tmpStorage.push_back(9);
-          break;
-
-        case 'u': {
-          ++curCharPtr_;
-          CallResult<char16_t> cr = consumeUnicode();
-          if (LLVM_UNLIKELY(cr == ExecutionStatus::EXCEPTION)) {
-            return ExecutionStatus::EXCEPTION;
-          }
-          tmpStorage.push_back(*cr);
-          break;
-        }
+    assert(*curCharPtr_ == u'\\' && "unexpected special character");
+    if (!hasEscape) {
+      // This is the first escape character encountered, so append everything
+      // we've seen so far to tmpStorage.
+      tmpStorage.append(curCharPtr_.endCapture());
+    }
+    hasEscape = true;
+    ++curCharPtr_;
+    if (!curCharPtr_.hasChar()) {
+      return error("Unexpected end of input");
+    }
+    switch (*curCharPtr_) {
+      case u'"':
+      case u'/':
+      case u'\\':
+        tmpStorage.push_back(*curCharPtr_);
+        ++curCharPtr_;
+        break;
 
-        default:
-          return errorWithChar(u"Invalid escape sequence: ", *curCharPtr_);
+      case 'b':
+        ++curCharPtr_;
+        tmpStorage.push_back(8);
+        break;
+      case 'f':
+        ++curCharPtr_;
+        tmpStorage.push_back(12);
+        break;
+      case 'n':
+        ++curCharPtr_;
+        tmpStorage.push_back(10);
+        break;
+      case 'r':
+        ++curCharPtr_;
+        tmpStorage.push_back(13);
+        break;
+      case 't':
+        ++curCharPtr_;
+        tmpStorage.push_back(9);
+        break;
+
+      case 'u': {
+        ++curCharPtr_;
+        CallResult<char16_t> cr = consumeUnicode();
+        if (LLVM_UNLIKELY(cr == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        tmpStorage.push_back(*cr);
+        break;
       }
-    } else {
-      if (hasEscape)
-        tmpStorage.push_back(*curCharPtr_);
-      ++curCharPtr_;
+
+      default:
+        return errorWithChar(u"Invalid escape sequence: ", *curCharPtr_);
     }
   }
   return error("Unexpected end of input");
@@ -46,6 +46,11 @@ class JSONToken {
   JSONTokenKind kind_{JSONTokenKind::None};
   double numberValue_{};
   MutableHandle<StringPrimitive> stringValue_;
+  MutableHandle<SymbolID> symbolValue_;
+
+  /// Whether a String token holds its value in symbolValue_ rather than in
+  /// stringValue_.
+  bool isSymbol_{false};
 
   /// The starting character of this token.
   char16_t firstChar_{};
@@ -54,7 +59,8 @@ class JSONToken {
   const JSONToken &operator=(const JSONToken &) = delete;
 
  public:
-  explicit JSONToken(Runtime &runtime) : stringValue_(runtime) {}
+  explicit JSONToken(Runtime &runtime)
+      : stringValue_(runtime), symbolValue_(runtime) {}
 
   JSONTokenKind getKind() const {
     return kind_;
@@ -66,10 +72,21 @@ class JSONToken {
   }
 
   Handle<StringPrimitive> getString() const {
-    assert(getKind() == JSONTokenKind::String);
+    assert(getKind() == JSONTokenKind::String && !isSymbol_);
     return stringValue_;
   }
 
+  /// \return true if this String token was interned as a SymbolID.
+  bool isSymbol() const {
+    assert(getKind() == JSONTokenKind::String);
+    return isSymbol_;
+  }
+
+  Handle<SymbolID> getSymbol() const {
+    assert(getKind() == JSONTokenKind::String && isSymbol_);
+    return symbolValue_;
+  }
+
   char16_t getFirstChar() const {
     return firstChar_;
   }
@@ -94,8 +111,20 @@ class JSONToken {
   }
   void setString(Handle<StringPrimitive> str) {
     kind_ = JSONTokenKind::String;
+    isSymbol_ = false;
     stringValue_ = str.get();
   }
+  void setSymbol(Handle<SymbolID> sym) {
+    kind_ = JSONTokenKind::String;
+    isSymbol_ = true;
+    symbolValue_ = sym.get();
+  }
+  /// A String token that was validated but whose value wasn't created.
+  void setStringWithoutValue() {
+    kind_ = JSONTokenKind::String;
+    isSymbol_ = false;
+    stringValue_ = nullptr;
+  }
 };
 
 class JSONLexer {
@@ -106,6 +135,9 @@ class JSONLexer {
 
   JSONToken token_;
 
+  /// If set, strings are only validated, and String tokens have no value.
+  bool validateOnly_{false};
+
  public:
   JSONLexer(Runtime &runtime, UTF16Stream &&stream)
       : curCharPtr_(std::move(stream)), runtime_(runtime), token_(runtime) {}
@@ -123,6 +155,30 @@ class JSONLexer {
   /// All whitespace is skipped before the new token.
   LLVM_NODISCARD ExecutionStatus advance();
 
+  /// Same as \c advance(), but if the next token is a string that can be
+  /// used as a named property key, intern it and store it as a SymbolID.
+  /// Strings that look like array indices are stored as strings as usual.
+  LLVM_NODISCARD ExecutionStatus advanceStrAsSymbol();
+
+  /// Only validate strings from now on, without creating their values.
+  void setValidateOnly() {
+    validateOnly_ = true;
+  }
+
+  /// \return the position of the next character that hasn't been scanned.
+  /// This is only meaningful if the input is contiguous UTF-16 data.
+  const char16_t *getCurCharPtr() const {
+    return curCharPtr_.getBuffered().begin();
+  }
+
+  /// Skip the next \p n characters without scanning them. The current token
+  /// is left unchanged, so \c advance() must be called next.
+  /// \pre the input is contiguous UTF-16 data with at least \p n characters
+  ///   left.
+  void skip(size_t n) {
+    curCharPtr_ += n;
+  }
+
   /// Raise a JSON parse exception with message \p msg.
   /// token_ will also be invalidated.
   LLVM_NODISCARD ExecutionStatus error(const TwineChar16 &msg) {
@@ -139,10 +195,15 @@ class JSONLexer {
   }
 
  private:
+  /// Advance past any JSONWhiteSpace.
+  void skipWhiteSpace();
+
   /// Parse a JSONNumber.
   LLVM_NODISCARD ExecutionStatus scanNumber();
 
-  /// Parse a JSONString.
+  /// Parse a JSONString. If \p ForKey is true, the string is interned as
+  /// described in \c advanceStrAsSymbol().
+  template <bool ForKey>
   LLVM_NODISCARD ExecutionStatus scanString();
 
   /// Parse a reserved keyword.
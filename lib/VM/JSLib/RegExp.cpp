@@ -444,8 +444,9 @@ static ExecutionStatus createGroupsObject(
         auto groupIdx =
             JSObject::getNamedSlotValueUnsafe(*mappingObj, runtime, desc.slot)
                 .getNumber(runtime);
-        JSObject::setNamedSlotValueUnsafe(
-            *groupsObj, runtime, desc.slot, matchObj->at(runtime, groupIdx));
+        auto shv = SmallHermesValue::encodeHermesValue(
+            matchObj->at(runtime, groupIdx), runtime);
+        JSObject::setNamedSlotValueUnsafe(*groupsObj, runtime, desc.slot, shv);
       });
 
   return JSObject::defineOwnProperty(
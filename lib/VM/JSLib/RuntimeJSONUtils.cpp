@@ -12,10 +12,13 @@
 #include "hermes/Support/Compiler.h"
 #include "hermes/Support/JSON.h"
 #include "hermes/Support/UTF16Stream.h"
+#include "hermes/Support/UTF8.h"
 #include "hermes/VM/ArrayLike.h"
 #include "hermes/VM/ArrayStorage.h"
 #include "hermes/VM/Callable.h"
 #include "hermes/VM/JSArray.h"
+#include "hermes/VM/JSArrayBuffer.h"
+#include "hermes/VM/JSLazyJSONObject.h"
 #include "hermes/VM/JSProxy.h"
 #include "hermes/VM/PrimitiveBox.h"
 
@@ -23,6 +26,7 @@
 
 #include "llvh/ADT/SmallString.h"
 #include "llvh/Support/SaveAndRestore.h"
+#include "llvh/Support/raw_ostream.h"
 
 namespace hermes {
 namespace vm {
@@ -42,6 +46,18 @@ class RuntimeJSONParser {
 #endif
       ;
 
+  /// A document parsed by runtimeJSONParseLazy().
+  struct LazyDocument {
+    /// The source text, an external UTF-16 string.
+    Handle<StringPrimitive> source;
+
+    /// The structural index of source.
+    Handle<JSArrayBuffer> index;
+
+    /// The first character of source.
+    const char16_t *begin;
+  };
+
  private:
   /// The VM runtime.
   Runtime &runtime_;
@@ -63,6 +79,21 @@ class RuntimeJSONParser {
   /// If it drops below 0 while parsing, raise a stack overflow.
   int32_t remainingDepth_{MAX_RECURSION_DEPTH};
 
+  /// The keys of the most recently parsed object at each nesting depth, in
+  /// insertion order. Sibling objects in JSON payloads usually share their
+  /// keys and key order, so while a new object follows this sequence each key
+  /// is known not to exist yet and can be added with a direct hidden class
+  /// transition, without looking it up first.
+  /// Always accessed by index, since parsing a nested value may resize it.
+  std::vector<std::vector<SymbolID>> shapeKeys_{};
+
+  /// If set, nested objects are not parsed but created as JSLazyJSONObjects
+  /// over this document, and skipped using its structural index.
+  const LazyDocument *lazyDoc_{nullptr};
+
+  /// In lazy mode, the index ordinal of the next object in the input.
+  uint32_t nextOrdinal_{0};
+
  public:
   explicit RuntimeJSONParser(
       Runtime &runtime,
@@ -78,6 +109,18 @@ class RuntimeJSONParser {
   /// should be kept inside SourceErrorManager.
   CallResult<HermesValue> parse();
 
+  /// Create nested objects lazily from \p doc, whose structural index must
+  /// describe the input. \p firstOrdinal is the ordinal of the first object
+  /// in the input.
+  void setLazyDocument(const LazyDocument *doc, uint32_t firstOrdinal) {
+    lazyDoc_ = doc;
+    nextOrdinal_ = firstOrdinal;
+  }
+
+  /// Parse the JSON object at the start of the input, defining its
+  /// properties on \p object. Input after the object is ignored.
+  ExecutionStatus parseInto(Handle<JSObject> object);
+
  private:
   /// Parse a JSON value, starting from the current token.
   /// When this function is finished, the current token will be set
@@ -88,9 +131,15 @@ class RuntimeJSONParser {
   /// When this function is finished, the current token must be "]".
   CallResult<HermesValue> parseArray();
 
-  /// Parse a JSON object, starting from the "{" token.
+  /// Parse a JSON object, starting from the "{" token, defining its
+  /// properties on \p object.
+  /// When this function is finished, the current token must be "}".
+  ExecutionStatus parseObject(Handle<JSObject> object);
+
+  /// Create a JSLazyJSONObject for the JSON object starting at the current
+  /// "{" token, and skip its contents.
   /// When this function is finished, the current token must be "}".
-  CallResult<HermesValue> parseObject();
+  CallResult<HermesValue> createLazyObject();
 
   /// Use reviver to filter the result.
   CallResult<HermesValue> revive(Handle<> value);
@@ -107,6 +156,61 @@ class RuntimeJSONParser {
   ExecutionStatus filter(Handle<JSObject> val, Handle<> key);
 };
 
+/// This class validates a JSON document without creating any values, and
+/// builds its structural index for runtimeJSONParseLazy().
+/// Objects are numbered by ordinal in the order of their opening braces. For
+/// the object with ordinal N, entry 2N of the index is the offset just past
+/// its closing brace, and entry 2N+1 is the ordinal of the first object after
+/// it, i.e. one past the ordinals of the objects nested in it.
+class JSONStructuralIndexer {
+  /// The VM runtime.
+  Runtime &runtime_;
+
+  /// The lexer, which only validates strings.
+  JSONLexer lexer_;
+
+  /// The first character of the input.
+  const char16_t *begin_;
+
+  /// The index being built.
+  std::vector<uint32_t> &index_;
+
+  /// How many more nesting levels we allow before error, as in
+  /// RuntimeJSONParser.
+  int32_t remainingDepth_{RuntimeJSONParser::MAX_RECURSION_DEPTH};
+
+ public:
+  JSONStructuralIndexer(
+      Runtime &runtime,
+      UTF16Ref input,
+      std::vector<uint32_t> &index)
+      : runtime_(runtime),
+        lexer_(runtime, UTF16Stream(input)),
+        begin_(input.data()),
+        index_(index) {
+    lexer_.setValidateOnly();
+  }
+
+  /// Validate the whole input and fill in the index.
+  /// Raises the same errors as RuntimeJSONParser::parse().
+  ExecutionStatus build();
+
+ private:
+  /// Validate a JSON value, starting from the current token.
+  /// When this function is finished, the current token will be set
+  /// to the next token after the value.
+  ExecutionStatus indexValue();
+
+  /// Validate a JSON array, starting from the "[" token.
+  /// When this function is finished, the current token must be "]".
+  ExecutionStatus indexArray();
+
+  /// Validate a JSON object, starting from the "{" token, and record its
+  /// index entries.
+  /// When this function is finished, the current token must be "}".
+  ExecutionStatus indexObject();
+};
+
 /// This class wraps the functionality required to stringify an object
 /// as JSON.
 class JSONStringifyer {
@@ -167,6 +271,17 @@ class JSONStringifyer {
   /// The output buffer. The serialization process will append into it.
   llvh::SmallVector<char16_t, 32> output_{};
 
+  /// If set, output_ is periodically converted to UTF-8, written to this
+  /// stream and cleared, so the full result is never held in memory.
+  llvh::raw_ostream *sink_{nullptr};
+
+  /// Scratch buffer for the UTF-8 conversion of output_.
+  std::string utf8Output_{};
+
+  /// Number of UTF-16 units that output_ may hold before it is flushed to
+  /// sink_.
+  static constexpr size_t kSinkFlushThreshold = 64 * 1024;
+
  public:
   explicit JSONStringifyer(Runtime &runtime)
       : runtime_(runtime),
@@ -203,7 +318,32 @@ class JSONStringifyer {
   /// Stringify \p value.
   CallResult<HermesValue> stringify(Handle<> value);
 
+  /// Stringify \p value and write the result to \p os as UTF-8, in chunks as
+  /// it is produced.
+  /// \return false if the result is undefined, in which case nothing is
+  ///   written.
+  CallResult<bool> stringifyTo(Handle<> value, llvh::raw_ostream &os);
+
  private:
+  /// Perform steps 9 to 11 of ES5.1 15.12.3, serializing \p value into
+  /// output_.
+  /// \return whether the result is not undefined.
+  CallResult<bool> serialize(Handle<> value);
+
+  /// If a sink is set and output_ has grown past kSinkFlushThreshold, flush
+  /// it to the sink.
+  /// This must only be called after a complete array element or object
+  /// property has been appended: earlier output can only be rolled back while
+  /// serializing a value that turns out to be undefined, which never recurses
+  /// into operationJA or operationJO.
+  void maybeFlushToSink() {
+    if (sink_ && output_.size() >= kSinkFlushThreshold)
+      flushToSink();
+  }
+
+  /// Convert output_ to UTF-8, write it to sink_ and clear it.
+  void flushToSink();
+
   /// Check the type of replacer, initialize
   /// ReplacerFunction (replacerFunction_) and PropertyList (propertyList_).
   /// Covers step 3 and 4 in ES5.1 15.12.3.
@@ -298,11 +438,19 @@ CallResult<HermesValue> RuntimeJSONParser::parseValue() {
           HermesValue::encodeDoubleValue(lexer_.getCurToken()->getNumber());
       break;
     case JSONTokenKind::LBrace: {
-      auto parRes = parseObject();
-      if (LLVM_UNLIKELY(parRes == ExecutionStatus::EXCEPTION)) {
+      if (LLVM_UNLIKELY(lazyDoc_)) {
+        auto parRes = createLazyObject();
+        if (LLVM_UNLIKELY(parRes == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        returnValue = *parRes;
+        break;
+      }
+      auto object = runtime_.makeHandle(JSObject::create(runtime_));
+      if (LLVM_UNLIKELY(parseObject(object) == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
-      returnValue = *parRes;
+      returnValue = object.getHermesValue();
       break;
     }
     case JSONTokenKind::LSquare: {
@@ -391,19 +539,30 @@ CallResult<HermesValue> RuntimeJSONParser::parseArray() {
   return array.getHermesValue();
 }
 
-CallResult<HermesValue> RuntimeJSONParser::parseObject() {
+ExecutionStatus RuntimeJSONParser::parseObject(Handle<JSObject> object) {
   assert(
       lexer_.getCurToken()->getKind() == JSONTokenKind::LBrace &&
       "Wrong entrance to parseObject");
-  auto object = runtime_.makeHandle(JSObject::create(runtime_));
 
-  if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+  if (LLVM_UNLIKELY(
+          lexer_.advanceStrAsSymbol() == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
   if (lexer_.getCurToken()->getKind() != JSONTokenKind::RBrace) {
     MutableHandle<StringPrimitive> key{runtime_};
+    MutableHandle<SymbolID> keySym{runtime_};
     GCScope gcScope{runtime_};
     auto marker = gcScope.createMarker();
+
+    // parseValue() has already decremented remainingDepth_ for this object.
+    const size_t depth = MAX_RECURSION_DEPTH - 1 - remainingDepth_;
+    if (shapeKeys_.size() <= depth)
+      shapeKeys_.resize(depth + 1);
+    // The properties of object are exactly shapeKeys_[depth][0, numKeys) as
+    // long as followsShape is true.
+    size_t numKeys = 0;
+    bool followsShape = true;
+
     for (;;) {
       gcScope.flushToMarker(marker);
 
@@ -411,7 +570,11 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
               lexer_.getCurToken()->getKind() != JSONTokenKind::String)) {
         return lexer_.error("Expect a string key in JSON object");
       }
-      key = lexer_.getCurToken()->getString().get();
+      const bool isSymbol = lexer_.getCurToken()->isSymbol();
+      if (isSymbol)
+        keySym = lexer_.getCurToken()->getSymbol().get();
+      else
+        key = lexer_.getCurToken()->getString().get();
 
       if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
@@ -430,15 +593,55 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
         return ExecutionStatus::EXCEPTION;
       }
 
-      (void)JSObject::defineOwnComputedPrimitive(
-          object,
-          runtime_,
-          key,
-          DefinePropertyFlags::getDefaultNewPropertyFlags(),
-          runtime_.makeHandle(*parRes));
+      auto value = runtime_.makeHandle(*parRes);
+      std::vector<SymbolID> &keys = shapeKeys_[depth];
+      if (!isSymbol) {
+        // Index-like keys aren't tracked by the shape cache.
+        (void)JSObject::defineOwnComputedPrimitive(
+            object,
+            runtime_,
+            key,
+            DefinePropertyFlags::getDefaultNewPropertyFlags(),
+            value);
+        followsShape = false;
+      } else if (
+          followsShape && numKeys < keys.size() && keys[numKeys] == *keySym) {
+        // The cached keys are distinct, so this one can't be defined yet.
+        if (LLVM_UNLIKELY(
+                JSObject::defineNewOwnProperty(
+                    object,
+                    runtime_,
+                    *keySym,
+                    PropertyFlags::defaultNewNamedPropertyFlags(),
+                    value) == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        ++numKeys;
+      } else {
+        const unsigned numProps =
+            object->getClass(runtime_)->getNumProperties();
+        if (LLVM_UNLIKELY(
+                JSObject::defineOwnProperty(
+                    object,
+                    runtime_,
+                    *keySym,
+                    DefinePropertyFlags::getDefaultNewPropertyFlags(),
+                    value) == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        // A duplicate key only replaces the value, so the object still
+        // follows the cached shape. A new key starts a new shape from here.
+        if (followsShape &&
+            object->getClass(runtime_)->getNumProperties() != numProps) {
+          keys.resize(numKeys);
+          keys.push_back(*keySym);
+          ++numKeys;
+        }
+      }
 
       if (lexer_.getCurToken()->getKind() == JSONTokenKind::Comma) {
-        if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+        if (LLVM_UNLIKELY(
+                lexer_.advanceStrAsSymbol() == ExecutionStatus::EXCEPTION)) {
           return ExecutionStatus::EXCEPTION;
         }
         continue;
@@ -453,9 +656,45 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
         "Unexpected stop for object parse");
   }
 
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<HermesValue> RuntimeJSONParser::createLazyObject() {
+  assert(
+      lexer_.getCurToken()->getKind() == JSONTokenKind::LBrace &&
+      "Wrong entrance to createLazyObject");
+  const uint32_t ordinal = nextOrdinal_;
+  const auto *entries = reinterpret_cast<const uint32_t *>(
+      lazyDoc_->index->getDataBlock(runtime_));
+  const uint32_t end = entries[2 * ordinal];
+  nextOrdinal_ = entries[2 * ordinal + 1];
+
+  // The lexer has just consumed the "{".
+  const uint32_t offset = lexer_.getCurCharPtr() - lazyDoc_->begin - 1;
+  auto object = JSLazyJSONObject::create(
+      runtime_, lazyDoc_->source, lazyDoc_->index, offset, ordinal);
+
+  // Continue with the closing "}", which is the last character of the object.
+  lexer_.skip(end - 1 - (offset + 1));
+  if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  assert(
+      lexer_.getCurToken()->getKind() == JSONTokenKind::RBrace &&
+      "structural index doesn't match the input");
   return object.getHermesValue();
 }
 
+ExecutionStatus RuntimeJSONParser::parseInto(Handle<JSObject> object) {
+  if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  // Account for the nesting level of the object, like parseValue() would.
+  llvh::SaveAndRestore<decltype(remainingDepth_)> oldDepth{
+      remainingDepth_, remainingDepth_ - 1};
+  return parseObject(object);
+}
+
 CallResult<HermesValue> RuntimeJSONParser::revive(Handle<> value) {
   auto root = runtime_.makeHandle(JSObject::create(runtime_));
   auto status = JSObject::defineOwnProperty(
@@ -520,7 +759,7 @@ CallResult<HermesValue> RuntimeJSONParser::operationWalk(
     auto keys = *cr;
     GCScopeMarkerRAII marker(runtime_);
     for (uint32_t index = 0, e = keys->getEndIndex(); index < e; ++index) {
-      tmpHandle = keys->at(runtime_, index).unboxToHV(runtime_);
+      tmpHandle = keys->at(runtime_, index);
       if (LLVM_UNLIKELY(
               filter(scopedObject, tmpHandle) == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
@@ -596,6 +835,209 @@ CallResult<HermesValue> runtimeJSONParseRef(
   return parser.parse();
 }
 
+ExecutionStatus JSONStructuralIndexer::build() {
+  if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (LLVM_UNLIKELY(indexValue() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (LLVM_UNLIKELY(lexer_.getCurToken()->getKind() != JSONTokenKind::Eof)) {
+    return lexer_.errorWithChar(
+        "Unexpected token: ", lexer_.getCurToken()->getFirstChar());
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus JSONStructuralIndexer::indexValue() {
+  llvh::SaveAndRestore<decltype(remainingDepth_)> oldDepth{
+      remainingDepth_, remainingDepth_ - 1};
+  if (remainingDepth_ <= 0) {
+    return runtime_.raiseStackOverflow(Runtime::StackOverflowKind::JSONParser);
+  }
+
+  switch (lexer_.getCurToken()->getKind()) {
+    case JSONTokenKind::String:
+    case JSONTokenKind::Number:
+    case JSONTokenKind::True:
+    case JSONTokenKind::False:
+    case JSONTokenKind::Null:
+      break;
+    case JSONTokenKind::LBrace:
+      if (LLVM_UNLIKELY(indexObject() == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      break;
+    case JSONTokenKind::LSquare:
+      if (LLVM_UNLIKELY(indexArray() == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      break;
+
+    default:
+      if (lexer_.getCurToken()->getKind() == JSONTokenKind::Eof) {
+        return lexer_.error("Unexpected end of input");
+      }
+      return lexer_.errorWithChar(
+          "Unexpected token: ", lexer_.getCurToken()->getFirstChar());
+  }
+
+  return lexer_.advance();
+}
+
+ExecutionStatus JSONStructuralIndexer::indexArray() {
+  assert(
+      lexer_.getCurToken()->getKind() == JSONTokenKind::LSquare &&
+      "Wrong entrance to indexArray");
+  if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (lexer_.getCurToken()->getKind() == JSONTokenKind::RSquare) {
+    return ExecutionStatus::RETURNED;
+  }
+  for (;;) {
+    if (LLVM_UNLIKELY(indexValue() == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (lexer_.getCurToken()->getKind() == JSONTokenKind::Comma) {
+      if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+    } else if (lexer_.getCurToken()->getKind() == JSONTokenKind::RSquare) {
+      return ExecutionStatus::RETURNED;
+    } else {
+      return lexer_.error("Expect ']'");
+    }
+  }
+}
+
+ExecutionStatus JSONStructuralIndexer::indexObject() {
+  assert(
+      lexer_.getCurToken()->getKind() == JSONTokenKind::LBrace &&
+      "Wrong entrance to indexObject");
+  const size_t ordinal = index_.size() / 2;
+  index_.resize(index_.size() + 2);
+
+  if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (lexer_.getCurToken()->getKind() != JSONTokenKind::RBrace) {
+    for (;;) {
+      if (LLVM_UNLIKELY(
+              lexer_.getCurToken()->getKind() != JSONTokenKind::String)) {
+        return lexer_.error("Expect a string key in JSON object");
+      }
+      if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      if (lexer_.getCurToken()->getKind() != JSONTokenKind::Colon) {
+        return lexer_.error("Expect ':' after the key in JSON object");
+      }
+      if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      if (LLVM_UNLIKELY(indexValue() == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      if (lexer_.getCurToken()->getKind() == JSONTokenKind::Comma) {
+        if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+      } else if (lexer_.getCurToken()->getKind() == JSONTokenKind::RBrace) {
+        break;
+      } else {
+        return lexer_.error("Expect '}'");
+      }
+    }
+  }
+
+  // The lexer has just consumed the "}".
+  index_[2 * ordinal] = lexer_.getCurCharPtr() - begin_;
+  index_[2 * ordinal + 1] = index_.size() / 2;
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<HermesValue> runtimeJSONParseLazy(
+    Runtime &runtime,
+    Handle<StringPrimitive> jsonString) {
+  GCScope gcScope{runtime, "runtimeJSONParseLazy"};
+
+  // Lazy objects keep parsing the source after this returns, so it must be
+  // an external UTF-16 string, whose characters don't move during GC. Copying
+  // a document that is too small to be external isn't worth it, so parse it
+  // eagerly instead.
+  MutableHandle<StringPrimitive> source{runtime};
+  if (jsonString->isExternal() && !jsonString->isASCII()) {
+    source = *jsonString;
+  } else if (
+      jsonString->getStringLength() < StringPrimitive::EXTERNAL_STRING_MIN_SIZE) {
+    return runtimeJSONParse(
+        runtime, jsonString, Runtime::makeNullHandle<Callable>());
+  } else {
+    StringView view = StringPrimitive::createStringView(runtime, jsonString);
+    std::u16string copy(view.begin(), view.end());
+    auto strRes = StringPrimitive::createEfficient(runtime, std::move(copy));
+    if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    source = vmcast<StringPrimitive>(*strRes);
+    assert(
+        source->isExternal() && !source->isASCII() &&
+        "copy of the source must be an external UTF-16 string");
+  }
+  UTF16Ref ref = source->getStringRef<char16_t>();
+
+  // Validate the document and build its structural index.
+  std::vector<uint32_t> entries;
+  JSONStructuralIndexer indexer{runtime, ref, entries};
+  if (LLVM_UNLIKELY(indexer.build() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+
+  auto index = runtime.makeHandle(JSArrayBuffer::create(
+      runtime, Handle<JSObject>::vmcast(&runtime.arrayBufferPrototype)));
+  if (LLVM_UNLIKELY(
+          JSArrayBuffer::createDataBlock(
+              runtime, index, entries.size() * sizeof(uint32_t), false) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (!entries.empty()) {
+    std::memcpy(
+        index->getDataBlock(runtime),
+        entries.data(),
+        entries.size() * sizeof(uint32_t));
+  }
+
+  // Parse the top level value, creating its objects lazily.
+  RuntimeJSONParser::LazyDocument doc{source, index, ref.data()};
+  RuntimeJSONParser parser{
+      runtime, UTF16Stream(ref), Runtime::makeNullHandle<Callable>()};
+  parser.setLazyDocument(&doc, 0);
+  return parser.parse();
+}
+
+void runtimeJSONMaterialize(Runtime &runtime, Handle<JSLazyJSONObject> obj) {
+  GCScope gcScope{runtime, "runtimeJSONMaterialize"};
+  auto source = runtime.makeHandle(obj->getSource(runtime));
+  auto index = runtime.makeHandle(obj->getIndex(runtime));
+  assert(source && "lazy JSON object was already materialized");
+  obj->releaseSource(runtime);
+
+  UTF16Ref ref = source->getStringRef<char16_t>();
+  RuntimeJSONParser::LazyDocument doc{source, index, ref.data()};
+  RuntimeJSONParser parser{
+      runtime,
+      UTF16Stream(ref.slice(obj->getOffset())),
+      Runtime::makeNullHandle<Callable>()};
+  parser.setLazyDocument(&doc, obj->getOrdinal() + 1);
+  auto status = parser.parseInto(obj);
+  (void)status;
+  assert(
+      status == ExecutionStatus::RETURNED &&
+      "lazy JSON object was validated when it was parsed");
+}
+
 ExecutionStatus JSONStringifyer::initializeReplacer(Handle<> replacer) {
   if (!vmisa<JSObject>(*replacer))
     return ExecutionStatus::RETURNED;
@@ -665,9 +1107,8 @@ ExecutionStatus JSONStringifyer::initializeReplacer(Handle<> replacer) {
     bool exists = false;
     auto len = propertyList_->getEndIndex();
     for (uint32_t i = 0; i < len; ++i) {
-      if (propertyList_->at(runtime_, i)
-              .getString(runtime_)
-              ->equals(tmpHandle_->getString())) {
+      if (propertyList_->at(runtime_, i).getString()->equals(
+              tmpHandle_->getString())) {
         exists = true;
         break;
       }
@@ -962,6 +1403,7 @@ ExecutionStatus JSONStringifyer::operationJA() {
       // operationStr returns undefined, we need to replace with null.
       appendToOutput(Predefined::getSymbolID(Predefined::null));
     }
+    maybeFlushToSink();
   }
   depthCount_ = stepBack;
 
@@ -1036,7 +1478,7 @@ ExecutionStatus JSONStringifyer::operationJO() {
       indent();
     }
 
-    tmpHandle_ = operationJOK_->at(runtime_, index).unboxToHV(runtime_);
+    tmpHandle_ = operationJOK_->at(runtime_, index);
     if (LLVM_UNLIKELY(!tmpHandle_->isString())) {
       // property may come from getOwnPropertyNames, which may contain numbers.
       // getOwnPropertyNames and propertyList_ are both only populated
@@ -1086,6 +1528,7 @@ ExecutionStatus JSONStringifyer::operationJO() {
       output_.resize(savedLocation);
     } else {
       hasElement = true;
+      maybeFlushToSink();
     }
   }
   // It's important to reset depthCount_ first, because the last
@@ -1141,7 +1584,40 @@ void JSONStringifyer::appendToOutput(const StringPrimitive *str) {
   str->appendUTF16String(output_);
 }
 
+void JSONStringifyer::flushToSink() {
+  assert(sink_ && "no sink to flush to");
+  convertUTF16ToUTF8WithReplacements(utf8Output_, output_);
+  sink_->write(utf8Output_.data(), utf8Output_.size());
+  output_.clear();
+}
+
 CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
+  auto status = serialize(value);
+  if (LLVM_UNLIKELY(status == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (*status) {
+    return StringPrimitive::create(runtime_, output_);
+  } else {
+    return HermesValue::encodeUndefinedValue();
+  }
+}
+
+CallResult<bool> JSONStringifyer::stringifyTo(
+    Handle<> value,
+    llvh::raw_ostream &os) {
+  llvh::SaveAndRestore<llvh::raw_ostream *> savedSink{sink_, &os};
+  auto status = serialize(value);
+  if (LLVM_UNLIKELY(status == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (*status) {
+    flushToSink();
+  }
+  return status;
+}
+
+CallResult<bool> JSONStringifyer::serialize(Handle<> value) {
   // All previous steps have been covered by the constructor.
   // Clear the output buffer.
   output_.clear();
@@ -1160,16 +1636,8 @@ CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
   (void)status;
 
   // Step 11 in ES5.1 15.12.3.
-  status = operationStr(HermesValue::encodeStringValue(
+  return operationStr(HermesValue::encodeStringValue(
       runtime_.getPredefinedString(Predefined::emptyString)));
-  if (LLVM_UNLIKELY(status == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  if (status.getValue()) {
-    return StringPrimitive::create(runtime_, output_);
-  } else {
-    return HermesValue::encodeUndefinedValue();
-  }
 }
 
 CallResult<HermesValue> runtimeJSONStringify(
@@ -1186,5 +1654,20 @@ CallResult<HermesValue> runtimeJSONStringify(
   return stringifyer.stringify(value);
 }
 
+CallResult<bool> runtimeJSONStringifyTo(
+    Runtime &runtime,
+    Handle<> value,
+    Handle<> replacer,
+    Handle<> space,
+    llvh::raw_ostream &os) {
+  GCScope gcScope{runtime, "runtimeJSONStringifyTo"};
+
+  JSONStringifyer stringifyer{runtime};
+  if (stringifyer.init(replacer, space) == ExecutionStatus::EXCEPTION) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return stringifyer.stringifyTo(value, os);
+}
+
 } // namespace vm
 } // namespace hermes
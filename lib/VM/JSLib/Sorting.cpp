@@ -7,17 +7,24 @@
 
 #include "hermes/VM/JSLib/Sorting.h"
 
+#include "hermes/Support/Algorithms.h"
 #include "hermes/Support/Compiler.h"
 
+#include "llvh/ADT/SmallVector.h"
 #include "llvh/Support/MathExtras.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <memory>
 #include <vector>
 
 namespace hermes {
 namespace vm {
 
 SortModel::~SortModel() = default;
+SortComparator::~SortComparator() = default;
 
 namespace {
 
@@ -341,5 +348,818 @@ ExecutionStatus quickSort(SortModel *sm, uint32_t begin, uint32_t end) {
   }
 }
 
+namespace {
+
+/// The state of a TimSort, following the description in Tim Peters'
+/// listsort.txt and the layout of the OpenJDK implementation. Runs are found
+/// left to right, extended to a minimum length with a binary insertion sort,
+/// and pushed on a stack whose lengths are kept decreasing faster than the
+/// Fibonacci numbers by merging, so the stack stays logarithmic and merges
+/// stay balanced. Merges copy the shorter run to a temporary array and switch
+/// to galloping while one run keeps winning.
+///
+/// Values to compare are copied into handles before calling the comparator,
+/// which can run arbitrary JavaScript and trigger a GC.
+class TimSort {
+ public:
+  TimSort(Runtime &runtime, SortComparator *cmp, Handle<SegmentedArray> a)
+      : runtime_(runtime),
+        cmp_(cmp),
+        a_(a),
+        tmp_(runtime),
+        key_(runtime),
+        x_(runtime),
+        y_(runtime) {}
+
+  ExecutionStatus sort();
+
+ private:
+  /// Below this length, a whole array is sorted with a binary insertion sort.
+  /// It is also the bound of the minimum run length.
+  static constexpr uint32_t MIN_MERGE = 32;
+
+  /// Number of consecutive wins of a run after which a merge starts
+  /// galloping.
+  static constexpr uint32_t MIN_GALLOP = 7;
+
+  Runtime &runtime_;
+  SortComparator *cmp_;
+
+  /// The values being sorted.
+  Handle<SegmentedArray> a_;
+
+  /// Temporary storage for merges, allocated on demand.
+  MutableHandle<SegmentedArray> tmp_;
+
+  /// The value being searched for by a gallop or an insertion.
+  MutableHandle<> key_;
+
+  /// The values passed to the comparator.
+  MutableHandle<> x_;
+  MutableHandle<> y_;
+
+  /// Current galloping threshold, adjusted as merges go.
+  uint32_t minGallop_{MIN_GALLOP};
+
+  /// A run waiting to be merged.
+  struct Run {
+    uint32_t base;
+    uint32_t len;
+  };
+  llvh::SmallVector<Run, 40> runs_;
+
+  /// \return the comparison of \p x and \p y.
+  CallResult<int> compare(HermesValue x, HermesValue y) {
+    x_ = x;
+    y_ = y;
+    return cmp_->compare(x_, y_);
+  }
+
+  /// \return the comparison of key_ and \p arr[i].
+  CallResult<int> compareKey(Handle<SegmentedArray> arr, int64_t i) {
+    return compare(key_.get(), arr->at(runtime_, i));
+  }
+
+  /// Set \p dst[i] to \p src[j].
+  void move(
+      Handle<SegmentedArray> dst,
+      int64_t i,
+      Handle<SegmentedArray> src,
+      int64_t j) {
+    dst->set(runtime_, i, src->at(runtime_, j));
+  }
+
+  /// Copy \p len values from \p src starting at \p srcPos to \p dst starting
+  /// at \p dstPos. The ranges can overlap.
+  void copy(
+      Handle<SegmentedArray> src,
+      int64_t srcPos,
+      Handle<SegmentedArray> dst,
+      int64_t dstPos,
+      int64_t len) {
+    if (src.get() == dst.get() && dstPos > srcPos) {
+      for (int64_t i = len - 1; i >= 0; --i)
+        move(dst, dstPos + i, src, srcPos + i);
+    } else {
+      for (int64_t i = 0; i < len; ++i)
+        move(dst, dstPos + i, src, srcPos + i);
+    }
+  }
+
+  /// Make sure the temporary array has room for \p minCapacity values.
+  ExecutionStatus ensureCapacity(uint32_t minCapacity);
+
+  /// Sort [lo, hi) with a binary insertion sort, given that [lo, start) is
+  /// already sorted.
+  ExecutionStatus binarySort(uint32_t lo, uint32_t hi, uint32_t start);
+
+  /// \return the length of the run starting at \p lo and ending at most at
+  /// \p hi. A strictly descending run is reversed in place, so the run is
+  /// always ascending afterwards.
+  CallResult<uint32_t> countRunAndMakeAscending(uint32_t lo, uint32_t hi);
+
+  /// \return the minimum run length for an array of length \p n.
+  static uint32_t minRunLength(uint32_t n) {
+    uint32_t r = 0;
+    while (n >= MIN_MERGE) {
+      r |= n & 1;
+      n >>= 1;
+    }
+    return n + r;
+  }
+
+  /// Locate the position at which to insert key_ in the sorted range of
+  /// \p len values of \p arr starting at \p base, starting the search at
+  /// \p hint. gallopLeft() \return the leftmost such position and
+  /// gallopRight() the rightmost.
+  CallResult<uint32_t> gallopLeft(
+      Handle<SegmentedArray> arr,
+      uint32_t base,
+      uint32_t len,
+      uint32_t hint);
+  CallResult<uint32_t> gallopRight(
+      Handle<SegmentedArray> arr,
+      uint32_t base,
+      uint32_t len,
+      uint32_t hint);
+
+  /// Merge runs until the invariants of the run stack hold again.
+  ExecutionStatus mergeCollapse();
+
+  /// Merge all the runs on the stack.
+  ExecutionStatus mergeForceCollapse();
+
+  /// Merge the runs at \p i and i + 1 on the stack.
+  ExecutionStatus mergeAt(size_t i);
+
+  /// Merge two adjacent runs, given that the first value of the second run
+  /// is smaller than the first value of the first run, and that the last
+  /// value of the first run is larger than all the values of the second run.
+  /// mergeLo() is used when the first run is the shortest, and mergeHi()
+  /// otherwise.
+  ExecutionStatus
+  mergeLo(uint32_t base1, uint32_t len1, uint32_t base2, uint32_t len2);
+  ExecutionStatus
+  mergeHi(uint32_t base1, uint32_t len1, uint32_t base2, uint32_t len2);
+};
+
+ExecutionStatus TimSort::ensureCapacity(uint32_t minCapacity) {
+  if (tmp_ && tmp_->size(runtime_) >= minCapacity)
+    return ExecutionStatus::RETURNED;
+  // Grow geometrically, but never beyond what a merge can need.
+  uint32_t capacity = std::max(
+      minCapacity,
+      std::min<uint32_t>(
+          llvh::NextPowerOf2(minCapacity), a_->size(runtime_) / 2));
+  auto arrRes = SegmentedArray::create(runtime_, capacity, capacity);
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  tmp_ = arrRes->get();
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus TimSort::binarySort(uint32_t lo, uint32_t hi, uint32_t start) {
+  if (start == lo)
+    ++start;
+  for (; start < hi; ++start) {
+    key_ = a_->at(runtime_, start);
+    uint32_t left = lo;
+    uint32_t right = start;
+    while (left < right) {
+      uint32_t mid = left + (right - left) / 2;
+      auto res = compareKey(a_, mid);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res < 0)
+        right = mid;
+      else
+        left = mid + 1;
+    }
+    copy(a_, left, a_, left + 1, start - left);
+    a_->set(runtime_, left, key_.get());
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<uint32_t> TimSort::countRunAndMakeAscending(
+    uint32_t lo,
+    uint32_t hi) {
+  uint32_t runHi = lo + 1;
+  if (runHi == hi)
+    return 1;
+
+  auto res = compare(a_->at(runtime_, runHi), a_->at(runtime_, lo));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  ++runHi;
+  // The run must be strictly descending to be reversed, which keeps the sort
+  // stable.
+  bool descending = *res < 0;
+  for (; runHi < hi; ++runHi) {
+    res = compare(a_->at(runtime_, runHi), a_->at(runtime_, runHi - 1));
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (descending != (*res < 0))
+      break;
+  }
+  if (descending) {
+    for (uint32_t i = lo, j = runHi - 1; i < j; ++i, --j) {
+      HermesValue tmp = a_->at(runtime_, i);
+      move(a_, i, a_, j);
+      a_->set(runtime_, j, tmp);
+    }
+  }
+  return runHi - lo;
+}
+
+CallResult<uint32_t> TimSort::gallopLeft(
+    Handle<SegmentedArray> arr,
+    uint32_t base,
+    uint32_t len,
+    uint32_t hint) {
+  assert(len > 0 && hint < len && "invalid gallop");
+  int64_t lastOfs = 0;
+  int64_t ofs = 1;
+  auto res = compareKey(arr, base + hint);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  if (*res > 0) {
+    // Gallop right until arr[base+hint+lastOfs] < key <= arr[base+hint+ofs].
+    int64_t maxOfs = len - hint;
+    while (ofs < maxOfs) {
+      res = compareKey(arr, base + hint + ofs);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res <= 0)
+        break;
+      lastOfs = ofs;
+      ofs = (ofs << 1) + 1;
+    }
+    ofs = std::min(ofs, maxOfs);
+    lastOfs += hint;
+    ofs += hint;
+  } else {
+    // Gallop left until arr[base+hint-ofs] < key <= arr[base+hint-lastOfs].
+    int64_t maxOfs = hint + 1;
+    while (ofs < maxOfs) {
+      res = compareKey(arr, base + hint - ofs);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res > 0)
+        break;
+      lastOfs = ofs;
+      ofs = (ofs << 1) + 1;
+    }
+    ofs = std::min(ofs, maxOfs);
+    int64_t tmp = lastOfs;
+    lastOfs = hint - ofs;
+    ofs = hint - tmp;
+  }
+
+  // Now arr[base+lastOfs] < key <= arr[base+ofs], so the position is in
+  // (lastOfs, ofs]. Find it with a binary search.
+  ++lastOfs;
+  while (lastOfs < ofs) {
+    int64_t m = lastOfs + ((ofs - lastOfs) >> 1);
+    res = compareKey(arr, base + m);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (*res > 0)
+      lastOfs = m + 1;
+    else
+      ofs = m;
+  }
+  return ofs;
+}
+
+CallResult<uint32_t> TimSort::gallopRight(
+    Handle<SegmentedArray> arr,
+    uint32_t base,
+    uint32_t len,
+    uint32_t hint) {
+  assert(len > 0 && hint < len && "invalid gallop");
+  int64_t lastOfs = 0;
+  int64_t ofs = 1;
+  auto res = compareKey(arr, base + hint);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  if (*res < 0) {
+    // Gallop left until arr[base+hint-ofs] <= key < arr[base+hint-lastOfs].
+    int64_t maxOfs = hint + 1;
+    while (ofs < maxOfs) {
+      res = compareKey(arr, base + hint - ofs);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res >= 0)
+        break;
+      lastOfs = ofs;
+      ofs = (ofs << 1) + 1;
+    }
+    ofs = std::min(ofs, maxOfs);
+    int64_t tmp = lastOfs;
+    lastOfs = hint - ofs;
+    ofs = hint - tmp;
+  } else {
+    // Gallop right until arr[base+hint+lastOfs] <= key < arr[base+hint+ofs].
+    int64_t maxOfs = len - hint;
+    while (ofs < maxOfs) {
+      res = compareKey(arr, base + hint + ofs);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res < 0)
+        break;
+      lastOfs = ofs;
+      ofs = (ofs << 1) + 1;
+    }
+    ofs = std::min(ofs, maxOfs);
+    lastOfs += hint;
+    ofs += hint;
+  }
+
+  // Now arr[base+lastOfs] <= key < arr[base+ofs], so the position is in
+  // (lastOfs, ofs]. Find it with a binary search.
+  ++lastOfs;
+  while (lastOfs < ofs) {
+    int64_t m = lastOfs + ((ofs - lastOfs) >> 1);
+    res = compareKey(arr, base + m);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (*res < 0)
+      ofs = m;
+    else
+      lastOfs = m + 1;
+  }
+  return ofs;
+}
+
+ExecutionStatus TimSort::mergeCollapse() {
+  // Keep, for the top runs A, B, C, D of the stack (D the most recent):
+  // A > B + C, B > C + D and C > D. Checking A as well as B is needed for the
+  // invariant to hold for the whole stack.
+  while (runs_.size() > 1) {
+    size_t n = runs_.size() - 2;
+    auto len = [this](size_t i) -> uint64_t { return runs_[i].len; };
+    if ((n > 0 && len(n - 1) <= len(n) + len(n + 1)) ||
+        (n > 1 && len(n - 2) <= len(n - 1) + len(n))) {
+      if (len(n - 1) < len(n + 1))
+        --n;
+    } else if (len(n) > len(n + 1)) {
+      break;
+    }
+    if (LLVM_UNLIKELY(mergeAt(n) == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus TimSort::mergeForceCollapse() {
+  while (runs_.size() > 1) {
+    size_t n = runs_.size() - 2;
+    if (n > 0 && runs_[n - 1].len < runs_[n + 1].len)
+      --n;
+    if (LLVM_UNLIKELY(mergeAt(n) == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus TimSort::mergeAt(size_t i) {
+  uint32_t base1 = runs_[i].base;
+  uint32_t len1 = runs_[i].len;
+  uint32_t base2 = runs_[i + 1].base;
+  uint32_t len2 = runs_[i + 1].len;
+  assert(base1 + len1 == base2 && "runs must be adjacent");
+
+  runs_[i].len = len1 + len2;
+  runs_.erase(runs_.begin() + i + 1);
+
+  // Values of the first run that are not greater than the first value of the
+  // second run are already in place.
+  key_ = a_->at(runtime_, base2);
+  auto k = gallopRight(a_, base1, len1, 0);
+  if (LLVM_UNLIKELY(k == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  base1 += *k;
+  len1 -= *k;
+  if (len1 == 0)
+    return ExecutionStatus::RETURNED;
+
+  // Values of the second run that are not smaller than the last value of the
+  // first run are already in place.
+  key_ = a_->at(runtime_, base1 + len1 - 1);
+  auto newLen2 = gallopLeft(a_, base2, len2, len2 - 1);
+  if (LLVM_UNLIKELY(newLen2 == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  len2 = *newLen2;
+  if (len2 == 0)
+    return ExecutionStatus::RETURNED;
+
+  return len1 <= len2 ? mergeLo(base1, len1, base2, len2)
+                      : mergeHi(base1, len1, base2, len2);
+}
+
+ExecutionStatus
+TimSort::mergeLo(uint32_t base1, uint32_t len1, uint32_t base2, uint32_t len2) {
+  assert(len1 > 0 && len2 > 0 && base1 + len1 == base2 && "invalid merge");
+  if (LLVM_UNLIKELY(ensureCapacity(len1) == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  Handle<SegmentedArray> tmp = tmp_;
+  copy(a_, base1, tmp, 0, len1);
+
+  // The first run is merged from tmp[cursor1] and the second from
+  // a[cursor2], into a[dest].
+  int64_t cursor1 = 0;
+  int64_t cursor2 = base2;
+  int64_t dest = base1;
+
+  move(a_, dest++, a_, cursor2++);
+  if (--len2 == 0) {
+    copy(tmp, cursor1, a_, dest, len1);
+    return ExecutionStatus::RETURNED;
+  }
+  if (len1 == 1) {
+    copy(a_, cursor2, a_, dest, len2);
+    move(a_, dest + len2, tmp, cursor1);
+    return ExecutionStatus::RETURNED;
+  }
+
+  uint32_t minGallop = minGallop_;
+  for (;;) {
+    // Number of times in a row that each run won.
+    uint32_t count1 = 0;
+    uint32_t count2 = 0;
+
+    // Merge one value at a time until one run starts winning consistently.
+    bool done = false;
+    do {
+      auto res = compare(a_->at(runtime_, cursor2), tmp->at(runtime_, cursor1));
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res < 0) {
+        move(a_, dest++, a_, cursor2++);
+        ++count2;
+        count1 = 0;
+        if (--len2 == 0) {
+          done = true;
+          break;
+        }
+      } else {
+        move(a_, dest++, tmp, cursor1++);
+        ++count1;
+        count2 = 0;
+        if (--len1 == 1) {
+          done = true;
+          break;
+        }
+      }
+    } while ((count1 | count2) < minGallop);
+    if (done)
+      break;
+
+    // Gallop until neither run wins consistently anymore.
+    do {
+      key_ = a_->at(runtime_, cursor2);
+      auto gallopRes = gallopRight(tmp, cursor1, len1, 0);
+      if (LLVM_UNLIKELY(gallopRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      count1 = *gallopRes;
+      if (count1 != 0) {
+        copy(tmp, cursor1, a_, dest, count1);
+        dest += count1;
+        cursor1 += count1;
+        len1 -= count1;
+        // len1 can only reach 0 with an inconsistent comparison.
+        if (len1 <= 1) {
+          done = true;
+          break;
+        }
+      }
+      move(a_, dest++, a_, cursor2++);
+      if (--len2 == 0) {
+        done = true;
+        break;
+      }
+
+      key_ = tmp->at(runtime_, cursor1);
+      gallopRes = gallopLeft(a_, cursor2, len2, 0);
+      if (LLVM_UNLIKELY(gallopRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      count2 = *gallopRes;
+      if (count2 != 0) {
+        copy(a_, cursor2, a_, dest, count2);
+        dest += count2;
+        cursor2 += count2;
+        len2 -= count2;
+        if (len2 == 0) {
+          done = true;
+          break;
+        }
+      }
+      move(a_, dest++, tmp, cursor1++);
+      if (--len1 == 1) {
+        done = true;
+        break;
+      }
+      if (minGallop > 0)
+        --minGallop;
+    } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+    if (done)
+      break;
+    // Penalize leaving gallop mode.
+    minGallop += 2;
+  }
+  minGallop_ = std::max(minGallop, 1u);
+
+  if (len1 == 1) {
+    copy(a_, cursor2, a_, dest, len2);
+    move(a_, dest + len2, tmp, cursor1);
+  } else if (len1 != 0) {
+    assert(len2 == 0 && "merge ended early");
+    copy(tmp, cursor1, a_, dest, len1);
+  }
+  // Otherwise the comparison was inconsistent, and the rest of the second
+  // run is already in place.
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus
+TimSort::mergeHi(uint32_t base1, uint32_t len1, uint32_t base2, uint32_t len2) {
+  assert(len1 > 0 && len2 > 0 && base1 + len1 == base2 && "invalid merge");
+  if (LLVM_UNLIKELY(ensureCapacity(len2) == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  Handle<SegmentedArray> tmp = tmp_;
+  copy(a_, base2, tmp, 0, len2);
+
+  // The first run is merged from a[cursor1] and the second from
+  // tmp[cursor2], into a[dest], going right to left. The cursors can go one
+  // past the start of their run.
+  int64_t cursor1 = base1 + len1 - 1;
+  int64_t cursor2 = len2 - 1;
+  int64_t dest = base2 + len2 - 1;
+
+  move(a_, dest--, a_, cursor1--);
+  if (--len1 == 0) {
+    copy(tmp, 0, a_, dest - (len2 - 1), len2);
+    return ExecutionStatus::RETURNED;
+  }
+  if (len2 == 1) {
+    dest -= len1;
+    cursor1 -= len1;
+    copy(a_, cursor1 + 1, a_, dest + 1, len1);
+    move(a_, dest, tmp, cursor2);
+    return ExecutionStatus::RETURNED;
+  }
+
+  uint32_t minGallop = minGallop_;
+  for (;;) {
+    // Number of times in a row that each run won.
+    uint32_t count1 = 0;
+    uint32_t count2 = 0;
+
+    // Merge one value at a time until one run starts winning consistently.
+    bool done = false;
+    do {
+      auto res = compare(tmp->at(runtime_, cursor2), a_->at(runtime_, cursor1));
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (*res < 0) {
+        move(a_, dest--, a_, cursor1--);
+        ++count1;
+        count2 = 0;
+        if (--len1 == 0) {
+          done = true;
+          break;
+        }
+      } else {
+        move(a_, dest--, tmp, cursor2--);
+        ++count2;
+        count1 = 0;
+        if (--len2 == 1) {
+          done = true;
+          break;
+        }
+      }
+    } while ((count1 | count2) < minGallop);
+    if (done)
+      break;
+
+    // Gallop until neither run wins consistently anymore.
+    do {
+      key_ = tmp->at(runtime_, cursor2);
+      auto gallopRes = gallopRight(a_, base1, len1, len1 - 1);
+      if (LLVM_UNLIKELY(gallopRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      count1 = len1 - *gallopRes;
+      if (count1 != 0) {
+        dest -= count1;
+        cursor1 -= count1;
+        len1 -= count1;
+        copy(a_, cursor1 + 1, a_, dest + 1, count1);
+        if (len1 == 0) {
+          done = true;
+          break;
+        }
+      }
+      move(a_, dest--, tmp, cursor2--);
+      if (--len2 == 1) {
+        done = true;
+        break;
+      }
+
+      key_ = a_->at(runtime_, cursor1);
+      gallopRes = gallopLeft(tmp, 0, len2, len2 - 1);
+      if (LLVM_UNLIKELY(gallopRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      count2 = len2 - *gallopRes;
+      if (count2 != 0) {
+        dest -= count2;
+        cursor2 -= count2;
+        len2 -= count2;
+        copy(tmp, cursor2 + 1, a_, dest + 1, count2);
+        // len2 can only reach 0 with an inconsistent comparison.
+        if (len2 <= 1) {
+          done = true;
+          break;
+        }
+      }
+      move(a_, dest--, a_, cursor1--);
+      if (--len1 == 0) {
+        done = true;
+        break;
+      }
+      if (minGallop > 0)
+        --minGallop;
+    } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+    if (done)
+      break;
+    // Penalize leaving gallop mode.
+    minGallop += 2;
+  }
+  minGallop_ = std::max(minGallop, 1u);
+
+  if (len2 == 1) {
+    dest -= len1;
+    cursor1 -= len1;
+    copy(a_, cursor1 + 1, a_, dest + 1, len1);
+    move(a_, dest, tmp, cursor2);
+  } else if (len2 != 0) {
+    assert(len1 == 0 && "merge ended early");
+    copy(tmp, 0, a_, dest - (len2 - 1), len2);
+  }
+  // Otherwise the comparison was inconsistent, and the rest of the first run
+  // is already in place.
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus TimSort::sort() {
+  uint32_t lo = 0;
+  uint32_t hi = a_->size(runtime_);
+  uint32_t remaining = hi;
+  if (remaining < 2)
+    return ExecutionStatus::RETURNED;
+
+  // Small arrays are sorted without merging.
+  if (remaining < MIN_MERGE) {
+    auto runRes = countRunAndMakeAscending(lo, hi);
+    if (LLVM_UNLIKELY(runRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    return binarySort(lo, hi, lo + *runRes);
+  }
+
+  uint32_t minRun = minRunLength(remaining);
+  do {
+    auto runRes = countRunAndMakeAscending(lo, hi);
+    if (LLVM_UNLIKELY(runRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    uint32_t runLen = *runRes;
+
+    // Extend a short run to the minimum run length.
+    if (runLen < minRun) {
+      uint32_t force = std::min(remaining, minRun);
+      if (LLVM_UNLIKELY(
+              binarySort(lo, lo + force, lo + runLen) ==
+              ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      runLen = force;
+    }
+
+    runs_.push_back({lo, runLen});
+    if (LLVM_UNLIKELY(mergeCollapse() == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+
+    lo += runLen;
+    remaining -= runLen;
+  } while (remaining != 0);
+
+  return mergeForceCollapse();
+}
+
+} // namespace
+
+ExecutionStatus
+timSort(Runtime &runtime, SortComparator *cmp, Handle<SegmentedArray> values) {
+  TimSort ts{runtime, cmp, values};
+  return ts.sort();
+}
+
+namespace {
+
+/// Below this length, integers are sorted with pdqSort instead of a radix
+/// sort, whose fixed cost of clearing and scanning counters would dominate.
+constexpr size_t kRadixSortThreshold = 256;
+
+/// Sort integers of 8 bits by counting each value.
+template <typename T>
+void countingSort(T *begin, T *end) {
+  static_assert(sizeof(T) == 1, "counting sort is only for bytes");
+  using U = typename std::make_unsigned<T>::type;
+  // Flip the sign bit of signed values, so their unsigned order is correct.
+  constexpr U signFlip = std::is_signed<T>::value ? 0x80 : 0;
+  std::array<size_t, 256> counts{};
+  for (T *it = begin; it != end; ++it)
+    ++counts[(U)*it ^ signFlip];
+  T *dst = begin;
+  for (unsigned digit = 0; digit < 256; ++digit) {
+    std::memset(dst, (U)digit ^ signFlip, counts[digit]);
+    dst += counts[digit];
+  }
+}
+
+/// Sort integers of 16 or 32 bits with a least significant digit radix sort,
+/// one byte at a time. The counts of all the bytes are collected in a single
+/// pass, and the bytes that are the same in all the values are skipped.
+template <typename T>
+void radixSort(T *begin, T *end) {
+  using U = typename std::make_unsigned<T>::type;
+  constexpr unsigned kBytes = sizeof(T);
+  // Flip the sign bit of signed values, so their unsigned order is correct.
+  constexpr U signFlip = std::is_signed<T>::value ? (U)1 << (kBytes * 8 - 1)
+                                                  : 0;
+  auto digit = [](T value, unsigned byte) -> unsigned {
+    return (((U)value ^ signFlip) >> (byte * 8)) & 0xff;
+  };
+
+  size_t len = end - begin;
+  std::array<std::array<size_t, 256>, kBytes> counts{};
+  for (T *it = begin; it != end; ++it) {
+    for (unsigned byte = 0; byte < kBytes; ++byte)
+      ++counts[byte][digit(*it, byte)];
+  }
+
+  std::unique_ptr<T[]> buffer{new T[len]};
+  T *src = begin;
+  T *dst = buffer.get();
+  for (unsigned byte = 0; byte < kBytes; ++byte) {
+    std::array<size_t, 256> &offsets = counts[byte];
+    if (offsets[digit(*src, byte)] == len)
+      continue;
+    // Turn the counts into the offset of each digit in the output.
+    size_t offset = 0;
+    for (size_t &count : offsets) {
+      size_t next = offset + count;
+      count = offset;
+      offset = next;
+    }
+    for (T *it = src, *e = src + len; it != e; ++it)
+      dst[offsets[digit(*it, byte)]++] = *it;
+    std::swap(src, dst);
+  }
+  if (src != begin)
+    std::memcpy(begin, src, len * sizeof(T));
+}
+
+} // namespace
+
+template <typename T>
+void sortTypedArrayElements(T *begin, T *end) {
+  if constexpr (std::is_floating_point<T>::value) {
+    // NaN is greater than everything, and isn't ordered by <, so move all the
+    // NaNs to the end first.
+    T *nans = std::partition(begin, end, [](T x) { return !std::isnan(x); });
+    pdqSort(begin, nans);
+    // -0 and +0 are equal to <, so they are now together, in any order. Put
+    // the -0s first.
+    T *zeros = std::lower_bound(begin, nans, (T)0);
+    T *zerosEnd = std::upper_bound(zeros, nans, (T)0);
+    size_t negativeZeros =
+        std::count_if(zeros, zerosEnd, [](T x) { return std::signbit(x); });
+    std::fill(zeros, zeros + negativeZeros, -(T)0);
+    std::fill(zeros + negativeZeros, zerosEnd, (T)0);
+  } else if constexpr (sizeof(T) > 4) {
+    pdqSort(begin, end);
+  } else if ((size_t)(end - begin) < kRadixSortThreshold) {
+    pdqSort(begin, end);
+  } else if constexpr (sizeof(T) == 1) {
+    countingSort(begin, end);
+  } else {
+    radixSort(begin, end);
+  }
+}
+
+#define TYPED_ARRAY_NO_CLAMP
+#define TYPED_ARRAY(name, type) \
+  template void sortTypedArrayElements<type>(type *, type *);
+#include "hermes/VM/TypedArrays.def"
+
 } // namespace vm
 } // namespace hermes
@@ -13,6 +13,7 @@
 #include "JSLibInternal.h"
 
 #include "hermes/Platform/Unicode/PlatformUnicode.h"
+#include "hermes/Support/UTF8.h"
 #include "hermes/VM/JSLib/RuntimeCommonStorage.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/PrimitiveBox.h"
@@ -837,11 +838,46 @@ stringPrototypeSubstring(void *, Runtime &runtime, NativeArgs args) {
   return StringPrimitive::slice(runtime, S, from, to > from ? to - from : 0);
 }
 
+/// Convert the ASCII string \p S to upper case if \p upperCase is true, or to
+/// lower case otherwise.
+static CallResult<HermesValue> convertASCIICase(
+    Runtime &runtime,
+    Handle<StringPrimitive> S,
+    const bool upperCase) {
+  ASCIIRef str = S->getStringRef<char>();
+  uint32_t firstChange =
+      findASCIICaseChange(str.begin(), str.end(), upperCase) - str.begin();
+  if (firstChange == str.size()) {
+    // We don't have to allocate anything.
+    return S.getHermesValue();
+  }
+  if (str.size() == 1) {
+    // Use the Runtime stored representations of single-character strings.
+    return runtime.getCharacterString(str[0] ^ 0x20).getHermesValue();
+  }
+
+  SafeUInt32 len(str.size());
+  auto builder = StringBuilder::createStringBuilder(runtime, len, true);
+  if (builder == ExecutionStatus::EXCEPTION) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  // The allocation may have moved S.
+  str = S->getStringRef<char>();
+  builder->appendASCIIRef(str.take_front(firstChange));
+  builder->appendASCIIRefConvertingCase(
+      str.drop_front(firstChange), upperCase);
+  return HermesValue::encodeStringValue(*builder->getStringPrimitive());
+}
+
 static CallResult<HermesValue> convertCase(
     Runtime &runtime,
     Handle<StringPrimitive> S,
     const bool upperCase,
     const bool useCurrentLocale) {
+  if (!useCurrentLocale && S->isASCII()) {
+    return convertASCIICase(runtime, S, upperCase);
+  }
+
   // Copying is unavoidable in this function, do it early on.
   SmallU16String<32> buff;
   // Must copy instead of just getting the reference, because later operations
@@ -1033,30 +1069,34 @@ stringPrototypeSubstr(void *, Runtime &runtime, NativeArgs args) {
   }
 }
 
-/// \return the number of characters to trim from the begin iterator.
-static size_t trimStart(
-    StringView::const_iterator begin,
-    StringView::const_iterator end) {
-  size_t toTrim = 0;
-  while (begin != end &&
-         (isWhiteSpaceChar(*begin) || isLineTerminatorChar(*begin))) {
-    ++begin;
-    ++toTrim;
-  }
-  return toTrim;
+/// \return the number of characters to trim from the start of \p str.
+static size_t trimStart(const StringView &str) {
+  if (str.isASCII()) {
+    const char *begin = str.castToCharPtr();
+    return skipASCIIWhiteSpace(begin, begin + str.length()) - begin;
+  }
+  const char16_t *begin = str.castToChar16Ptr();
+  const char16_t *end = begin + str.length();
+  const char16_t *cur = begin;
+  while (cur != end && (isWhiteSpaceChar(*cur) || isLineTerminatorChar(*cur)))
+    ++cur;
+  return cur - begin;
 }
 
-/// \return the number of characters to trim from the end iterator.
-static size_t trimEnd(
-    StringView::const_iterator begin,
-    StringView::const_iterator end) {
-  size_t toTrim = 0;
-  while (begin != end &&
-         (isWhiteSpaceChar(*(end - 1)) || isLineTerminatorChar(*(end - 1)))) {
-    --end;
-    ++toTrim;
-  }
-  return toTrim;
+/// \return the number of characters to trim from the end of \p str.
+static size_t trimEnd(const StringView &str) {
+  if (str.isASCII()) {
+    const char *begin = str.castToCharPtr();
+    const char *end = begin + str.length();
+    return end - skipASCIIWhiteSpaceBackward(begin, end);
+  }
+  const char16_t *begin = str.castToChar16Ptr();
+  const char16_t *end = begin + str.length();
+  const char16_t *cur = end;
+  while (cur != begin &&
+         (isWhiteSpaceChar(cur[-1]) || isLineTerminatorChar(cur[-1])))
+    --cur;
+  return end - cur;
 }
 
 CallResult<HermesValue>
@@ -1076,11 +1116,8 @@ stringPrototypeTrim(void *, Runtime &runtime, NativeArgs args) {
   size_t beginIdx = 0, endIdx = S->getStringLength();
   {
     auto str = StringPrimitive::createStringView(runtime, S);
-    auto begin = str.begin();
-    auto end = str.end();
-    beginIdx = trimStart(begin, end);
-    begin += beginIdx;
-    endIdx -= trimEnd(begin, end);
+    beginIdx = trimStart(str);
+    endIdx -= trimEnd(str.slice(beginIdx));
   }
 
   return StringPrimitive::slice(runtime, S, beginIdx, endIdx - beginIdx);
@@ -1103,9 +1140,7 @@ stringPrototypeTrimStart(void *, Runtime &runtime, NativeArgs args) {
   size_t beginIdx = 0;
   {
     auto str = StringPrimitive::createStringView(runtime, S);
-    auto begin = str.begin();
-    auto end = str.end();
-    beginIdx = trimStart(begin, end);
+    beginIdx = trimStart(str);
   }
 
   return StringPrimitive::slice(
@@ -1129,9 +1164,7 @@ stringPrototypeTrimEnd(void *, Runtime &runtime, NativeArgs args) {
   size_t endIdx = S->getStringLength();
   {
     auto str = StringPrimitive::createStringView(runtime, S);
-    auto begin = str.begin();
-    auto end = str.end();
-    endIdx -= trimEnd(begin, end);
+    endIdx -= trimEnd(str);
   }
 
   return StringPrimitive::slice(runtime, S, 0, endIdx);
@@ -1515,8 +1548,6 @@ static CallResult<HermesValue> stringDirectedIndexOf(
   // Let start be min(max(pos, 0), len).
   uint32_t start = static_cast<uint32_t>(std::min(std::max(pos, 0.), len));
 
-  // TODO: good candidate for Boyer-Moore on large needles/haystacks
-  // TODO: good candidate for memchr on length-1 needles
   auto SView = StringPrimitive::createStringView(runtime, S);
   auto searchStrView = StringPrimitive::createStringView(runtime, searchStr);
   double ret = -1;
@@ -1524,23 +1555,15 @@ static CallResult<HermesValue> stringDirectedIndexOf(
     // lastIndexOf
     uint32_t lastPossibleMatchEnd =
         std::min(SView.length(), start + searchStrView.length());
-    auto foundIter = std::search(
-        SView.rbegin() + (SView.length() - lastPossibleMatchEnd),
-        SView.rend(),
-        searchStrView.rbegin(),
-        searchStrView.rend());
-    if (foundIter != SView.rend() || searchStrView.empty()) {
-      ret = SView.rend() - foundIter - searchStrView.length();
+    auto found = SView.slice(0, lastPossibleMatchEnd).findLast(searchStrView);
+    if (found) {
+      ret = *found;
     }
   } else {
     // indexOf
-    auto foundIter = std::search(
-        SView.begin() + start,
-        SView.end(),
-        searchStrView.begin(),
-        searchStrView.end());
-    if (foundIter != SView.end() || searchStrView.empty()) {
-      ret = foundIter - SView.begin();
+    auto found = SView.slice(start).find(searchStrView);
+    if (found) {
+      ret = start + *found;
     }
   }
   return HermesValue::encodeDoubleValue(ret);
@@ -2023,11 +2046,10 @@ stringPrototypeReplace(void *, Runtime &runtime, NativeArgs args) {
   auto strView = StringPrimitive::createStringView(runtime, string);
   if (!strView.empty()) {
     auto searchView = StringPrimitive::createStringView(runtime, searchString);
-    auto searchResult = std::search(
-        strView.begin(), strView.end(), searchView.begin(), searchView.end());
+    auto searchResult = strView.find(searchView);
 
-    if (searchResult != strView.end()) {
-      pos = searchResult - strView.begin();
+    if (searchResult) {
+      pos = *searchResult;
     } else {
       return string.getHermesValue();
     }
@@ -2331,12 +2353,10 @@ static OptValue<uint32_t> splitMatch(
   auto SStr = StringPrimitive::createStringView(runtime, S);
   auto RStr = StringPrimitive::createStringView(runtime, R);
 
-  auto sliced = SStr.slice(q);
-  auto searchResult =
-      std::search(sliced.begin(), sliced.end(), RStr.begin(), RStr.end());
+  auto searchResult = SStr.slice(q).find(RStr);
 
-  if (searchResult != sliced.end()) {
-    return q + (searchResult - sliced.begin()) + r;
+  if (searchResult) {
+    return q + *searchResult + r;
   }
   return llvh::None;
 }
@@ -2642,15 +2662,8 @@ CallResult<HermesValue> stringPrototypeIncludesOrStartsWith(
   // k, return false.
   auto SView = StringPrimitive::createStringView(runtime, S);
   auto searchStrView = StringPrimitive::createStringView(runtime, searchStr);
-  auto foundIter = std::search(
-      SView.begin() + start,
-      SView.end(),
-      searchStrView.begin(),
-      searchStrView.end());
-  // Note: searchStrView.empty check is needed in the special case that S is
-  // empty, searchStr is empty, and start = 0
   return HermesValue::encodeBoolValue(
-      foundIter != SView.end() || searchStrView.empty());
+      SView.slice(static_cast<uint32_t>(start)).find(searchStrView).hasValue());
 }
 
 CallResult<HermesValue>
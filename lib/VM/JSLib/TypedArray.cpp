@@ -340,105 +340,37 @@ CallResult<HermesValue> mapFilterLoop(
   return HermesValue::encodeNumberValue(insert);
 }
 
-/// This is the sort model for use with TypedArray.prototype.sort.
-/// template param \p WithCompareFn should be true if the compare function is
-/// a valid callback to call, and false if it is null or undefined.
-template <bool WithCompareFn>
-class TypedArraySortModel : public SortModel {
+/// This is the comparison for use with TypedArray.prototype.sort with a
+/// compare function. Without one, sortTypedArrayElements() is used instead.
+class TypedArraySortComparator : public SortComparator {
  protected:
   /// Runtime to sort in.
   Runtime &runtime_;
 
-  /// Scope to allocate handles in, gets destroyed with this.
-  GCScope gcScope_;
-
   /// JS comparison function, return -1 for less, 0 for equal, 1 for greater.
-  /// If null, then use the built in < operator.
   Handle<Callable> compareFn_;
 
-  /// Object to sort.
+  /// Object being sorted.
   Handle<JSTypedArrayBase> self_;
 
-  MutableHandle<HermesValue> aHandle_;
-  MutableHandle<HermesValue> bHandle_;
-
-  /// Marker created after initializing all fields so handles allocated later
-  /// can be flushed.
-  GCScope::Marker gcMarker_;
-
  public:
-  TypedArraySortModel(
+  TypedArraySortComparator(
       Runtime &runtime,
       Handle<JSTypedArrayBase> obj,
       Handle<Callable> compareFn)
-      : runtime_(runtime),
-        gcScope_(runtime),
-        compareFn_(compareFn),
-        self_(obj),
-        aHandle_(runtime),
-        bHandle_(runtime),
-        gcMarker_(gcScope_.createMarker()) {}
-
-  // Swap elements at indices a and b.
-  virtual ExecutionStatus swap(uint32_t a, uint32_t b) override {
-    aHandle_ =
-        JSObject::getOwnIndexed(createPseudoHandle(self_.get()), runtime_, a);
-    bHandle_ =
-        JSObject::getOwnIndexed(createPseudoHandle(self_.get()), runtime_, b);
-    if (JSObject::setOwnIndexed(self_, runtime_, a, bHandle_) ==
-        ExecutionStatus::EXCEPTION) {
-      return ExecutionStatus::EXCEPTION;
-    }
-    if (JSObject::setOwnIndexed(self_, runtime_, b, aHandle_) ==
-        ExecutionStatus::EXCEPTION) {
-      return ExecutionStatus::EXCEPTION;
-    }
-    return ExecutionStatus::RETURNED;
-  }
-
-  // Compare elements at index a and at index b.
-  virtual CallResult<int> compare(uint32_t a, uint32_t b) override {
-    GCScopeMarkerRAII gcMarker{gcScope_, gcMarker_};
-
-    CallResult<PseudoHandle<HermesValue>> callRes{ExecutionStatus::EXCEPTION};
-    {
-      Handle<> aValHandle = runtime_.makeHandle(JSObject::getOwnIndexed(
-          createPseudoHandle(self_.get()), runtime_, a));
-      // To avoid the need to create a handle for bVal a NoAllocScope is created
-      // below, to ensure no memory allocation will happen.
-      HermesValue bVal =
-          JSObject::getOwnIndexed(createPseudoHandle(self_.get()), runtime_, b);
-
-      // N.B.: aVal needs to be initialized after bVal's initialization -- i.e.,
-      // after no more allocations are expected for a while.
-      HermesValue aVal = *aValHandle;
-
-      {
-        NoAllocScope noAllocs{runtime_};
-        if (!WithCompareFn) {
-          if (LLVM_UNLIKELY(aVal.isBigInt())) {
-            return aVal.getBigInt()->compare(bVal.getBigInt());
-          } else {
-            double a = aVal.getNumber();
-            double b = bVal.getNumber();
-            if (LLVM_UNLIKELY(a == 0) && LLVM_UNLIKELY(b == 0) &&
-                LLVM_UNLIKELY(std::signbit(a)) &&
-                LLVM_UNLIKELY(!std::signbit(b))) {
-              // -0 < +0, according to the spec.
-              return -1;
-            }
-            return (a < b) ? -1 : (a > b ? 1 : 0);
-          }
-          assert(
-              compareFn_ && "Cannot use this version if the compareFn is null");
-        }
-      }
-      // ES7 22.2.3.26 2a.
-      // Let v be toNumber_RJS(Call(comparefn, undefined, x, y)).
-      callRes = Callable::executeCall2(
-          compareFn_, runtime_, Runtime::getUndefinedValue(), aVal, bVal);
-    }
-
+      : runtime_(runtime), compareFn_(compareFn), self_(obj) {}
+
+  // Compare values a and b.
+  virtual CallResult<int> compare(Handle<> a, Handle<> b) override {
+    GCScopeMarkerRAII gcMarker{runtime_};
+    // ES7 22.2.3.26 2a.
+    // Let v be toNumber_RJS(Call(comparefn, undefined, x, y)).
+    auto callRes = Callable::executeCall2(
+        compareFn_,
+        runtime_,
+        Runtime::getUndefinedValue(),
+        a.getHermesValue(),
+        b.getHermesValue());
     if (callRes == ExecutionStatus::EXCEPTION) {
       return ExecutionStatus::EXCEPTION;
     }
@@ -1283,7 +1215,7 @@ typedArrayPrototypeMapFilter(void *ctx, Runtime &runtime, NativeArgs args) {
   MutableHandle<> storage(runtime);
   auto marker = gcScope.createMarker();
   for (JSTypedArrayBase::size_type i = 0; i < insert; ++i) {
-    storage = values->at(runtime, i).unboxToHV(runtime);
+    storage = values->at(runtime, i);
     if (JSObject::setOwnIndexed(TA, runtime, i, storage) ==
         ExecutionStatus::EXCEPTION) {
       return ExecutionStatus::EXCEPTION;
@@ -1376,12 +1308,12 @@ typedArrayPrototypeJoin(void *, Runtime &runtime, NativeArgs args) {
     return ExecutionStatus::EXCEPTION;
   }
   MutableHandle<StringPrimitive> element{runtime};
-  element = strings->at(runtime, 0).getString(runtime);
+  element = strings->at(runtime, 0).getString();
   builder->appendStringPrim(element);
   // Copy the strings.
   for (decltype(len) i = 1; i < len; ++i) {
     builder->appendStringPrim(sep);
-    element = strings->at(runtime, i).getString(runtime);
+    element = strings->at(runtime, i).getString();
     builder->appendStringPrim(element);
   }
   return HermesValue::encodeStringValue(*builder->getStringPrimitive());
@@ -1499,18 +1431,55 @@ typedArrayPrototypeSort(void *, Runtime &runtime, NativeArgs args) {
     return runtime.raiseTypeError("TypedArray sort argument must be callable");
   }
 
-  // Use our custom sort routine. We can't use std::sort because it performs
-  // optimizations that allow it to bypass calls to std::swap, but our swap
-  // function is special, since it needs to use the internal Object functions.
-  if (compareFn) {
-    TypedArraySortModel<true> sm(runtime, self, compareFn);
-    if (LLVM_UNLIKELY(quickSort(&sm, 0, len) == ExecutionStatus::EXCEPTION))
+  if (!compareFn) {
+    // Without a comparator, nothing can observe the sort, so sort the
+    // elements in place with an algorithm specialized for their type.
+    switch (self->getKind()) {
+#define TYPED_ARRAY(name, type)                                              \
+  case CellKind::name##ArrayKind: {                                          \
+    auto *arr = vmcast<JSTypedArray<type, CellKind::name##ArrayKind>>(*self); \
+    sortTypedArrayElements(arr->begin(runtime), arr->end(runtime));          \
+    break;                                                                   \
+  }
+#include "hermes/VM/TypedArrays.def"
+      default:
+        llvm_unreachable("Invalid TypedArray after ValidateTypedArray call");
+    }
+    return self.getHermesValue();
+  }
+
+  // Read all the values into a buffer, sort it, and write them back.
+  auto crValues = SegmentedArray::create(runtime, len);
+  if (LLVM_UNLIKELY(crValues == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  MutableHandle<SegmentedArray> values{runtime, crValues->get()};
+  MutableHandle<> val{runtime};
+  GCScopeMarkerRAII marker{runtime};
+  for (JSTypedArrayBase::size_type i = 0; i < len; ++i) {
+    marker.flush();
+    val = JSObject::getOwnIndexed(createPseudoHandle(self.get()), runtime, i);
+    if (LLVM_UNLIKELY(
+            SegmentedArray::push_back(values, runtime, val) ==
+            ExecutionStatus::EXCEPTION))
       return ExecutionStatus::EXCEPTION;
-  } else {
-    TypedArraySortModel<false> sm(runtime, self, compareFn);
-    if (LLVM_UNLIKELY(quickSort(&sm, 0, len) == ExecutionStatus::EXCEPTION))
+  }
+  marker.flush();
+
+  {
+    TypedArraySortComparator cmp(runtime, self, compareFn);
+    if (LLVM_UNLIKELY(
+            timSort(runtime, &cmp, values) == ExecutionStatus::EXCEPTION))
       return ExecutionStatus::EXCEPTION;
   }
+
+  for (JSTypedArrayBase::size_type i = 0; i < len; ++i) {
+    marker.flush();
+    val = values->at(runtime, i);
+    if (JSObject::setOwnIndexed(self, runtime, i, val) ==
+        ExecutionStatus::EXCEPTION) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
   return self.getHermesValue();
 }
 
@@ -1729,13 +1698,13 @@ typedArrayPrototypeToLocaleString(void *, Runtime &runtime, NativeArgs args) {
     return ExecutionStatus::EXCEPTION;
   }
   MutableHandle<StringPrimitive> element{runtime};
-  element = strings->at(runtime, 0).getString(runtime);
+  element = strings->at(runtime, 0).getString();
   builder->appendStringPrim(element);
 
   for (uint32_t i = 1; i < len; ++i) {
     // Every element after the first needs a separator before it.
     builder->appendASCIIRef(separator);
-    element = strings->at(runtime, i).getString(runtime);
+    element = strings->at(runtime, i).getString();
     builder->appendStringPrim(element);
   }
   return HermesValue::encodeStringValue(*builder->getStringPrimitive());
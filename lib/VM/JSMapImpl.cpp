@@ -74,7 +74,7 @@ void JSMapIteratorImpl<C>::MapOrSetIteratorBuildMeta(
   JSObjectBuildMeta(cell, mb);
   const auto *self = static_cast<const JSMapIteratorImpl<C> *>(cell);
   mb.addField("data", &self->data_);
-  mb.addField("itr", &self->itr_);
+  mb.addField("itrTable", &self->itrTable_);
 }
 
 void JSMapIteratorBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
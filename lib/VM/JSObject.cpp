@@ -12,6 +12,8 @@
 #include "hermes/VM/HostModel.h"
 #include "hermes/VM/InternalProperty.h"
 #include "hermes/VM/JSArray.h"
+#include "hermes/VM/JSLazyJSONObject.h"
+#include "hermes/VM/JSLib/RuntimeJSONUtils.h"
 #include "hermes/VM/JSProxy.h"
 #include "hermes/VM/NativeState.h"
 #include "hermes/VM/Operations.h"
@@ -130,7 +132,13 @@ void JSObject::initializeLazyObject(
   // object is now assumed to be a regular object.
   lazyObject->flags_.lazyObject = 0;
 
-  // only functions can be lazy.
+  if (vmisa<JSLazyJSONObject>(lazyObject.get())) {
+    runtimeJSONMaterialize(
+        runtime, Handle<JSLazyJSONObject>::vmcast(lazyObject));
+    return;
+  }
+
+  // Otherwise only functions can be lazy.
   assert(vmisa<Callable>(lazyObject.get()) && "unexpected lazy object");
   Callable::defineLazyProperties(Handle<Callable>::vmcast(lazyObject), runtime);
 }
@@ -564,7 +572,7 @@ CallResult<Handle<JSArray>> JSObject::getOwnPropertyKeys(
        last != numIndexed;) {
     --last;
     --toLast;
-    tmpHandle = array->at(runtime, last).unboxToHV(runtime);
+    tmpHandle = array->at(runtime, last);
     JSArray::setElementAt(array, runtime, toLast, tmpHandle);
   }
 
@@ -577,7 +585,7 @@ CallResult<Handle<JSArray>> JSObject::getOwnPropertyKeys(
        toLast != 0;) {
     if (numIndexed) {
       uint32_t a =
-          (uint32_t)array->at(runtime, numIndexed - 1).getNumber(runtime);
+          (uint32_t)array->at(runtime, numIndexed - 1).getNumber();
       uint32_t b;
 
       if (indexNamesLast && (b = indexNames[indexNamesLast - 1]) > a) {
@@ -2549,6 +2557,10 @@ CallResult<bool> JSObject::preventExtensions(
   if (LLVM_UNLIKELY(selfHandle->isProxyObject())) {
     return JSProxy::preventExtensions(selfHandle, runtime, opFlags);
   }
+  // Lazy properties must be defined before the object stops being extensible.
+  if (LLVM_UNLIKELY(selfHandle->isLazy())) {
+    JSObject::initializeLazyObject(runtime, selfHandle);
+  }
   JSObject::preventExtensions(*selfHandle);
   return true;
 }
@@ -3040,7 +3052,7 @@ CallResult<uint32_t> appendAllPropertyNames(
     auto marker = gcScope.createMarker();
     for (unsigned i = 0, e = enumerableProps->getEndIndex(); i < e; ++i) {
       gcScope.flushToMarker(marker);
-      prop = enumerableProps->at(runtime, i).unboxToHV(runtime);
+      prop = enumerableProps->at(runtime, i);
       if (!needDedup) {
         // If no dedup is needed, add it directly.
         if (LLVM_UNLIKELY(
@@ -3182,6 +3194,11 @@ CallResult<Handle<BigStorage>> getForInPropertyNames(
     Handle<JSObject> obj,
     uint32_t &beginIndex,
     uint32_t &endIndex) {
+  // A lazy object shares its class with other objects until it is
+  // initialized, so the cache of that class doesn't describe it.
+  if (LLVM_UNLIKELY(obj->isLazy())) {
+    JSObject::initializeLazyObject(runtime, obj);
+  }
   Handle<HiddenClass> clazz(runtime, obj->getClass(runtime));
 
   // Fast case: Check the cache.
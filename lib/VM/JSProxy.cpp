@@ -1307,12 +1307,12 @@ CallResult<PseudoHandle<JSArray>> filterKeys(
   GCScopeMarkerRAII marker{runtime};
   for (uint32_t i = 0; i < len; ++i) {
     marker.flush();
-    SmallHermesValue elem = keys->at(runtime, i);
+    HermesValue elem = keys->at(runtime, i);
     if (elem.isSymbol() ? !okFlags.getIncludeSymbols()
                         : !okFlags.getIncludeNonSymbols()) {
       continue;
     }
-    elemHandle = elem.unboxToHV(runtime);
+    elemHandle = elem;
     if (!okFlags.getIncludeNonEnumerable()) {
       ComputedPropertyDescriptor desc;
       CallResult<bool> propRes = JSProxy::getOwnProperty(
@@ -1474,7 +1474,7 @@ CallResult<PseudoHandle<JSArray>> JSProxy::ownPropertyKeys(
     CallResult<bool> descRes = JSObject::getOwnComputedDescriptor(
         target,
         runtime,
-        runtime.makeHandle(targetKeys->at(runtime, i).unboxToHV(runtime)),
+        runtime.makeHandle(targetKeys->at(runtime, i)),
         tmpPropNameStorage,
         desc);
     if (descRes == ExecutionStatus::EXCEPTION) {
@@ -1502,14 +1502,14 @@ CallResult<PseudoHandle<JSArray>> JSProxy::ownPropertyKeys(
     for (uint32_t j = 0, len = JSArray::getLength(*trapResult, runtime);
          j < len;
          ++j) {
-      if (isSameValue(value, trapResult->at(runtime, j).unboxToHV(runtime))) {
+      if (isSameValue(value, trapResult->at(runtime, j))) {
         return true;
       }
     }
     return false;
   };
   for (auto i : nonConfigurable) {
-    if (!inTrapResult(targetKeys->at(runtime, i).unboxToHV(runtime))) {
+    if (!inTrapResult(targetKeys->at(runtime, i))) {
       return runtime.raiseTypeError(
           "ownKeys target key is non-configurable but not present in trap result");
     }
@@ -1526,7 +1526,7 @@ CallResult<PseudoHandle<JSArray>> JSProxy::ownPropertyKeys(
     if (nonConfigurable.count(i) > 0) {
       continue;
     }
-    if (!inTrapResult(targetKeys->at(runtime, i).unboxToHV(runtime))) {
+    if (!inTrapResult(targetKeys->at(runtime, i))) {
       return runtime.raiseTypeError(
           "ownKeys target is non-extensible but key is missing from trap result");
     }
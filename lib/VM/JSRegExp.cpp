@@ -337,6 +337,9 @@ void JSRegExp::_finalizeImpl(GCCell *cell, GC &gc) {
   JSRegExp *self = vmcast<JSRegExp>(cell);
   if (self->bytecode_) {
     gc.getIDTracker().untrackNative(self->bytecode_);
+    gc.deferFinalization(
+        [](void *bytecode) { free(bytecode); },
+        std::exchange(self->bytecode_, nullptr));
   }
   self->~JSRegExp();
 }
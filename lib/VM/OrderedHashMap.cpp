@@ -14,27 +14,6 @@
 
 namespace hermes {
 namespace vm {
-//===----------------------------------------------------------------------===//
-// class HashMapEntry
-
-const VTable HashMapEntry::vt{
-    CellKind::HashMapEntryKind,
-    cellSize<HashMapEntry>()};
-
-void HashMapEntryBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
-  const auto *self = static_cast<const HashMapEntry *>(cell);
-  mb.setVTable(&HashMapEntry::vt);
-  mb.addField("key", &self->key);
-  mb.addField("value", &self->value);
-  mb.addField("prevIterationEntry", &self->prevIterationEntry);
-  mb.addField("nextIterationEntry", &self->nextIterationEntry);
-  mb.addField("nextEntryInBucket", &self->nextEntryInBucket);
-}
-
-CallResult<PseudoHandle<HashMapEntry>> HashMapEntry::create(Runtime &runtime) {
-  return createPseudoHandle(runtime.makeAFixed<HashMapEntry>());
-}
-
 //===----------------------------------------------------------------------===//
 // class OrderedHashMap
 
@@ -45,155 +24,106 @@ const VTable OrderedHashMap::vt{
 void OrderedHashMapBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
   const auto *self = static_cast<const OrderedHashMap *>(cell);
   mb.setVTable(&OrderedHashMap::vt);
-  mb.addField("hashTable", &self->hashTable_);
-  mb.addField("firstIterationEntry", &self->firstIterationEntry_);
-  mb.addField("lastIterationEntry", &self->lastIterationEntry_);
+  mb.addField("table", &self->table_);
 }
 
 OrderedHashMap::OrderedHashMap(
     Runtime &runtime,
-    Handle<ArrayStorageSmall> hashTableStorage)
-    : hashTable_(runtime, hashTableStorage.get(), runtime.getHeap()) {}
+    Handle<SegmentedArraySmall> table)
+    : table_(runtime, table.get(), runtime.getHeap()) {}
 
 CallResult<PseudoHandle<OrderedHashMap>> OrderedHashMap::create(
     Runtime &runtime) {
-  auto arrRes =
-      ArrayStorageSmall::create(runtime, INITIAL_CAPACITY, INITIAL_CAPACITY);
+  const uint32_t size = tableSize(INITIAL_BUCKETS);
+  auto arrRes = SegmentedArraySmall::create(runtime, size, size);
   if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto hashTableStorage = runtime.makeHandle<ArrayStorageSmall>(*arrRes);
+  auto table = runtime.makeHandle(std::move(*arrRes));
 
-  return createPseudoHandle(
-      runtime.makeAFixed<OrderedHashMap>(runtime, hashTableStorage));
+  return createPseudoHandle(runtime.makeAFixed<OrderedHashMap>(runtime, table));
 }
 
-void OrderedHashMap::removeLinkedListNode(
+uint32_t OrderedHashMap::lookup(
     Runtime &runtime,
-    HashMapEntry *entry,
-    GC &gc) {
-  assert(
-      entry != lastIterationEntry_.get(runtime) &&
-      "Cannot remove the last entry");
-  if (entry->prevIterationEntry) {
-    entry->prevIterationEntry.getNonNull(runtime)->nextIterationEntry.set(
-        runtime, entry->nextIterationEntry, gc);
-  }
-  if (entry->nextIterationEntry) {
-    entry->nextIterationEntry.getNonNull(runtime)->prevIterationEntry.set(
-        runtime, entry->prevIterationEntry, gc);
-  }
-  if (entry == firstIterationEntry_.get(runtime)) {
-    firstIterationEntry_.set(runtime, entry->nextIterationEntry, gc);
+    uint32_t keyHash,
+    HermesValue key) const {
+  const SegmentedArraySmall *table = table_.getNonNull(runtime);
+  uint32_t linkSlot = bucketSlot(numBuckets_, keyHash & (numBuckets_ - 1));
+  for (;;) {
+    SmallHermesValue next = table->at(runtime, linkSlot);
+    if (next.isEmpty()) {
+      return NOT_FOUND;
+    }
+    uint32_t index = decodeIndex(runtime, next);
+    if (isSameValueZero(
+            table->at(runtime, keySlot(index)).unboxToHV(runtime), key)) {
+      return index;
+    }
+    linkSlot = chainSlot(index);
   }
-  entry->prevIterationEntry.setNull(runtime.getHeap());
 }
 
-static HashMapEntry *castToMapEntry(SmallHermesValue shv, PointerBase &base) {
-  if (shv.isEmpty())
-    return nullptr;
-  return vmcast<HashMapEntry>(shv.getObject(base));
-}
-
-HashMapEntry *OrderedHashMap::lookupInBucket(
+ExecutionStatus OrderedHashMap::rehash(
+    Handle<OrderedHashMap> self,
     Runtime &runtime,
-    uint32_t bucket,
-    HermesValue key) {
+    uint32_t newBuckets) {
   assert(
-      hashTable_.getNonNull(runtime)->size() == capacity_ &&
-      "Inconsistent capacity");
-  auto *entry =
-      castToMapEntry(hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  while (entry && !isSameValueZero(entry->key, key)) {
-    entry = entry->nextEntryInBucket.get(runtime);
-  }
-  return entry;
-}
-
-ExecutionStatus OrderedHashMap::rehashIfNecessary(
-    Handle<OrderedHashMap> self,
-    Runtime &runtime) {
-  uint32_t newCapacity = self->capacity_;
-  // NOTE: we have ensured that self->capacity_ * 4 never overflows uint32_t by
-  // setting MAX_CAPACITY to the appropriate value. self->size_ is always <=
-  // self->capacity_, so this applies to self->size_ as well.
-  static_assert(
-      MAX_CAPACITY < UINT32_MAX / 4,
-      "Avoid overflow checks on multiplying capacity by 4");
-  if (self->size_ * 4 > self->capacity_ * 3) {
-    // Load factor is more than 0.75, need to increase the capacity.
-    newCapacity = self->capacity_ * 2;
-    if (LLVM_UNLIKELY(newCapacity > MAX_CAPACITY)) {
-      // We maintain the invariant that the capacity_ is a power of two.
-      // Therefore, if doubling would exceed the max, we revert to the
-      // previous value.  (Assert the invariant to make it clear.)
-      assert(
-          (self->capacity_ & (self->capacity_ - 1)) == 0 &&
-          "capacity_ must be power of 2");
-      newCapacity = self->capacity_;
-    }
-  } else if (
-      self->size_ * 4 < self->capacity_ && self->capacity_ > INITIAL_CAPACITY) {
-    // Load factor is less than 0.25, and we are not at initial cap.
-    newCapacity = self->capacity_ / 2;
-  }
-  if (newCapacity == self->capacity_) {
-    // No need to rehash.
-    return ExecutionStatus::RETURNED;
+      (newBuckets & (newBuckets - 1)) == 0 &&
+      "newBuckets must be a power of 2");
+  if (LLVM_UNLIKELY(newBuckets > maxBuckets())) {
+    return runtime.raiseRangeError("Too many elements in Map or Set");
   }
   assert(
-      self->size_ && self->firstIterationEntry_ && self->lastIterationEntry_ &&
-      "We should never be rehashing when there are no elements");
-
-  // Set new capacity first to update the hash function.
-  self->capacity_ = newCapacity;
+      self->size_ <= newBuckets * ENTRIES_PER_BUCKET &&
+      "New table is too small");
 
-  // Create a new hash table.
-  auto arrRes = ArrayStorageSmall::create(runtime, newCapacity, newCapacity);
+  const uint32_t size = tableSize(newBuckets);
+  auto arrRes = SegmentedArraySmall::create(runtime, size, size);
   if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto newHashTable = runtime.makeHandle<ArrayStorageSmall>(*arrRes);
-
-  // Now re-add all entries to the hash table.
-  MutableHandle<HashMapEntry> entry{runtime};
-  MutableHandle<HashMapEntry> oldNextInBucket{runtime};
+  auto newTable = runtime.makeHandle(std::move(*arrRes));
+  auto oldTable = runtime.makeHandle<SegmentedArraySmall>(self->table_);
+
+  // Copy the alive entries in order. The old entries' chain slots are
+  // overwritten with the index at which iteration continues in the new table,
+  // which is the number of alive entries before them.
+  const uint32_t oldUsed = self->usedEntries_;
+  uint32_t newUsed = 0;
   MutableHandle<> keyHandle{runtime};
   GCScopeMarkerRAII marker{runtime};
-  for (unsigned i = 0, len = self->hashTable_.getNonNull(runtime)->size();
-       i < len;
-       ++i) {
-    entry =
-        castToMapEntry(self->hashTable_.getNonNull(runtime)->at(i), runtime);
-    while (entry) {
-      marker.flush();
-      keyHandle = entry->key;
-      uint32_t bucket = hashToBucket(self, runtime, keyHandle);
-      oldNextInBucket = entry->nextEntryInBucket.get(runtime);
-      if (newHashTable->at(bucket).isEmpty()) {
-        // Empty bucket.
-        entry->nextEntryInBucket.setNull(runtime.getHeap());
-      } else {
-        // There are already a bucket head.
-        entry->nextEntryInBucket.set(
-            runtime,
-            vmcast<HashMapEntry>(newHashTable->at(bucket).getObject(runtime)),
-            runtime.getHeap());
-      }
-      // Update bucket head to the new entry.
-      newHashTable->set(
-          bucket,
-          SmallHermesValue::encodeObjectValue(*entry, runtime),
-          runtime.getHeap());
-
-      entry = *oldNextInBucket;
+  for (uint32_t i = 0; i < oldUsed; ++i) {
+    marker.flush();
+    const uint32_t forward = newUsed;
+    SmallHermesValue key = oldTable->at(runtime, keySlot(i));
+    if (!key.isEmpty()) {
+      keyHandle = key.unboxToHV(runtime);
+      uint32_t bucketSl =
+          bucketSlot(newBuckets, hash(runtime, keyHandle) & (newBuckets - 1));
+      newTable->set(
+          runtime, keySlot(newUsed), oldTable->at(runtime, keySlot(i)));
+      newTable->set(
+          runtime, valueSlot(newUsed), oldTable->at(runtime, valueSlot(i)));
+      newTable->set(
+          runtime, chainSlot(newUsed), newTable->at(runtime, bucketSl));
+      setIndex(runtime, newTable, bucketSl, newUsed);
+      ++newUsed;
     }
+    setIndex(runtime, oldTable, chainSlot(i), forward);
   }
-
-  self->hashTable_.setNonNull(runtime, newHashTable.get(), runtime.getHeap());
-  assert(
-      self->hashTable_.getNonNull(runtime)->size() == self->capacity_ &&
-      "Inconsistent capacity");
+  assert(newUsed == self->size_ && "Inconsistent size");
+
+  setIndex(runtime, oldTable, FORWARDED_ENTRIES_SLOT, oldUsed);
+  setIndex(runtime, oldTable, FORWARDED_LIVE_SLOT, newUsed);
+  oldTable->set(
+      runtime,
+      NEXT_TABLE_SLOT,
+      SmallHermesValue::encodeObjectValue(newTable.get(), runtime));
+
+  self->table_.setNonNull(runtime, newTable.get(), runtime.getHeap());
+  self->numBuckets_ = newBuckets;
+  self->usedEntries_ = newUsed;
   return ExecutionStatus::RETURNED;
 }
 
@@ -201,27 +131,20 @@ bool OrderedHashMap::has(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  auto bucket = hashToBucket(self, runtime, key);
-  return self->lookupInBucket(runtime, bucket, key.getHermesValue());
-}
-
-HashMapEntry *OrderedHashMap::find(
-    Handle<OrderedHashMap> self,
-    Runtime &runtime,
-    Handle<> key) {
-  auto bucket = hashToBucket(self, runtime, key);
-  return self->lookupInBucket(runtime, bucket, key.getHermesValue());
+  const uint32_t keyHash = hash(runtime, key);
+  return self->lookup(runtime, keyHash, *key) != NOT_FOUND;
 }
 
 HermesValue OrderedHashMap::get(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  auto *entry = find(self, runtime, key);
-  if (!entry) {
+  const uint32_t keyHash = hash(runtime, key);
+  uint32_t index = self->lookup(runtime, keyHash, *key);
+  if (index == NOT_FOUND) {
     return HermesValue::encodeUndefinedValue();
   }
-  return entry->value;
+  return self->iteratorValue(runtime, index);
 }
 
 ExecutionStatus OrderedHashMap::insert(
@@ -229,162 +152,154 @@ ExecutionStatus OrderedHashMap::insert(
     Runtime &runtime,
     Handle<> key,
     Handle<> value) {
-  uint32_t bucket = hashToBucket(self, runtime, key);
-  if (auto *entry =
-          self->lookupInBucket(runtime, bucket, key.getHermesValue())) {
+  const uint32_t keyHash = hash(runtime, key);
+  uint32_t index = self->lookup(runtime, keyHash, *key);
+  if (index != NOT_FOUND) {
     // Element already exists, update value and return.
-    entry->value.set(value.get(), runtime.getHeap());
+    auto shv = SmallHermesValue::encodeHermesValue(*value, runtime);
+    self->table_.getNonNull(runtime)->set(runtime, valueSlot(index), shv);
     return ExecutionStatus::RETURNED;
   }
-  // Create a new entry, set the key and value.
-  auto crtRes = HashMapEntry::create(runtime);
-  if (LLVM_UNLIKELY(crtRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto newMapEntry = runtime.makeHandle(std::move(*crtRes));
-  newMapEntry->key.set(key.get(), runtime.getHeap());
-  newMapEntry->value.set(value.get(), runtime.getHeap());
-  auto *curBucketFront =
-      castToMapEntry(self->hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  if (curBucketFront) {
-    // If the bucket we are inserting to is not empty, we maintain the
-    // linked list properly.
-    newMapEntry->nextEntryInBucket.set(
-        runtime, curBucketFront, runtime.getHeap());
-  }
-  // Set the newly inserted entry as the front of this bucket chain.
-  self->hashTable_.getNonNull(runtime)->set(
-      bucket,
-      SmallHermesValue::encodeObjectValue(*newMapEntry, runtime),
-      runtime.getHeap());
-
-  if (!self->firstIterationEntry_) {
-    // If we are inserting the first ever element, update
-    // first iteration entry pointer.
-    self->firstIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-    self->lastIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-  } else {
-    // Connect the new entry with the last entry.
-    self->lastIterationEntry_.getNonNull(runtime)->nextIterationEntry.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-    newMapEntry->prevIterationEntry.set(
-        runtime, self->lastIterationEntry_, runtime.getHeap());
-
-    HashMapEntry *previousLastEntry = self->lastIterationEntry_.get(runtime);
-    self->lastIterationEntry_.set(
-        runtime, newMapEntry.get(), runtime.getHeap());
-
-    if (previousLastEntry && previousLastEntry->isDeleted()) {
-      // If the last entry was a deleted entry, we no longer need to keep it.
-      self->removeLinkedListNode(runtime, previousLastEntry, runtime.getHeap());
+
+  if (self->usedEntries_ == self->entryCapacity()) {
+    // The table is full. Grow it if most entries are alive, otherwise just
+    // drop the deleted ones.
+    uint32_t newBuckets = self->size_ >= self->entryCapacity() / 2
+        ? self->numBuckets_ * 2
+        : self->numBuckets_;
+    if (LLVM_UNLIKELY(
+            rehash(self, runtime, newBuckets) == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
     }
   }
 
+  // Append the new entry. Encoding the key and value may allocate, so store
+  // each of them as soon as it's encoded, and fetch the table every time.
+  index = self->usedEntries_;
+  auto keySHV = SmallHermesValue::encodeHermesValue(*key, runtime);
+  self->table_.getNonNull(runtime)->set(runtime, keySlot(index), keySHV);
+  auto valueSHV = SmallHermesValue::encodeHermesValue(*value, runtime);
+  self->table_.getNonNull(runtime)->set(runtime, valueSlot(index), valueSHV);
+
+  // Make the new entry the head of its bucket's chain.
+  uint32_t bucketSl =
+      bucketSlot(self->numBuckets_, keyHash & (self->numBuckets_ - 1));
+  auto table = runtime.makeHandle<SegmentedArraySmall>(self->table_);
+  table->set(runtime, chainSlot(index), table->at(runtime, bucketSl));
+  setIndex(runtime, table, bucketSl, index);
+
+  self->usedEntries_++;
   self->size_++;
-  return self->rehashIfNecessary(self, runtime);
+  return ExecutionStatus::RETURNED;
 }
 
 bool OrderedHashMap::erase(
     Handle<OrderedHashMap> self,
     Runtime &runtime,
     Handle<> key) {
-  uint32_t bucket = hashToBucket(self, runtime, key);
-  HashMapEntry *prevEntry = nullptr;
-  auto *entry =
-      castToMapEntry(self->hashTable_.getNonNull(runtime)->at(bucket), runtime);
-  while (entry && !isSameValueZero(entry->key, key.getHermesValue())) {
-    prevEntry = entry;
-    entry = entry->nextEntryInBucket.get(runtime);
-  }
-  if (!entry) {
-    // Element does not exist.
-    return false;
-  }
-
-  if (prevEntry) {
-    // The entry we are deleting has a previous entry, update the link.
-    prevEntry->nextEntryInBucket.set(
-        runtime, entry->nextEntryInBucket, runtime.getHeap());
-  } else {
-    // The entry we are erasing is the front entry in the bucket, we need
-    // to update the bucket head to the next entry in the bucket, if not
-    // any, set to empty value.
-    self->hashTable_.getNonNull(runtime)->set(
-        bucket,
-        entry->nextEntryInBucket
-            ? SmallHermesValue::encodeObjectValue(entry->nextEntryInBucket)
-            : SmallHermesValue::encodeEmptyValue(),
-        runtime.getHeap());
+  const uint32_t keyHash = hash(runtime, key);
+  SegmentedArraySmall *table = self->table_.getNonNull(runtime);
+  // Find the entry, along with the slot that links to it.
+  uint32_t linkSlot =
+      bucketSlot(self->numBuckets_, keyHash & (self->numBuckets_ - 1));
+  uint32_t index;
+  for (;;) {
+    SmallHermesValue next = table->at(runtime, linkSlot);
+    if (next.isEmpty()) {
+      // Element does not exist.
+      return false;
+    }
+    index = decodeIndex(runtime, next);
+    if (isSameValueZero(
+            table->at(runtime, keySlot(index)).unboxToHV(runtime), *key)) {
+      break;
+    }
+    linkSlot = chainSlot(index);
   }
 
-  entry->markDeleted(runtime);
+  // Unlink the entry from its chain, and leave a tombstone in its place so
+  // that the indices of the following entries don't change.
+  table->set(runtime, linkSlot, table->at(runtime, chainSlot(index)));
+  table->setNonPtr(
+      runtime, keySlot(index), SmallHermesValue::encodeEmptyValue());
+  table->setNonPtr(
+      runtime, valueSlot(index), SmallHermesValue::encodeEmptyValue());
+  table->setNonPtr(
+      runtime, chainSlot(index), SmallHermesValue::encodeEmptyValue());
   self->size_--;
 
-  // Now delete the entry from the iteration linked list.
-  // If we are deleting the last entry, don't remove it from the list yet.
-  // This will ensure that if any iterator out there is currently pointing to
-  // this entry, it will be able to follow on if we add new entries in the
-  // future.
-  if (entry != self->lastIterationEntry_.get(runtime)) {
-    self->removeLinkedListNode(runtime, entry, runtime.getHeap());
+  // Shrink the table if it is mostly empty. A smaller table always fits, so
+  // this can't fail.
+  if (self->size_ < self->entryCapacity() / 4 &&
+      self->numBuckets_ > INITIAL_BUCKETS) {
+    auto status = rehash(self, runtime, self->numBuckets_ / 2);
+    (void)status;
+    assert(status == ExecutionStatus::RETURNED && "Shrinking cannot fail");
   }
 
-  self->rehashIfNecessary(self, runtime);
-
   return true;
 }
 
-HashMapEntry *OrderedHashMap::iteratorNext(
+bool OrderedHashMap::iteratorNext(
     Runtime &runtime,
-    HashMapEntry *entry) const {
-  if (entry == nullptr) {
+    SegmentedArraySmall *&table,
+    uint32_t &index) const {
+  SegmentedArraySmall *current = table_.getNonNull(runtime);
+  if (!table) {
     // Starting a new iteration from the first entry.
-    entry = firstIterationEntry_.get(runtime);
-  } else {
-    // Advance to the next entry.
-    entry = entry->nextIterationEntry.get(runtime);
+    table = current;
+    index = 0;
   }
 
-  // Make sure the entry we returned (if not nullptr) must not be deleted.
-  while (entry && entry->isDeleted()) {
-    entry = entry->nextIterationEntry.get(runtime);
+  // Carry the position over from tables that have since been replaced.
+  while (table != current) {
+    SmallHermesValue next = table->at(runtime, NEXT_TABLE_SLOT);
+    assert(next.isObject() && "Out of date table must have a successor");
+    uint32_t forwardedEntries =
+        decodeIndex(runtime, table->at(runtime, FORWARDED_ENTRIES_SLOT));
+    index = index < forwardedEntries
+        ? decodeIndex(runtime, table->at(runtime, chainSlot(index)))
+        : decodeIndex(runtime, table->at(runtime, FORWARDED_LIVE_SLOT));
+    table = vmcast<SegmentedArraySmall>(next.getObject(runtime));
   }
-  return entry;
+
+  // Skip over the deleted entries.
+  while (index < usedEntries_ &&
+         table->at(runtime, keySlot(index)).isEmpty()) {
+    ++index;
+  }
+  return index < usedEntries_;
 }
 
-void OrderedHashMap::clear(Runtime &runtime) {
-  if (!firstIterationEntry_) {
+ExecutionStatus OrderedHashMap::clear(
+    Handle<OrderedHashMap> self,
+    Runtime &runtime) {
+  if (!self->usedEntries_) {
     // Empty set.
-    return;
+    return ExecutionStatus::RETURNED;
   }
 
-  // Clear the hash table.
-  for (unsigned i = 0; i < capacity_; ++i) {
-    auto entry = castToMapEntry(hashTable_.getNonNull(runtime)->at(i), runtime);
-    // Delete every element reachable from the hash table.
-    while (entry) {
-      entry->markDeleted(runtime);
-      entry = entry->nextEntryInBucket.get(runtime);
-    }
-    // Clear every element in the hash table.
-    hashTable_.getNonNull(runtime)->setNonPtr(
-        i, SmallHermesValue::encodeEmptyValue(), runtime.getHeap());
+  const uint32_t size = tableSize(INITIAL_BUCKETS);
+  auto arrRes = SegmentedArraySmall::create(runtime, size, size);
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
   }
-  // Resize the hash table to the initial size.
-  ArrayStorageSmall::resizeWithinCapacity(
-      hashTable_.getNonNull(runtime), runtime, INITIAL_CAPACITY);
-  capacity_ = INITIAL_CAPACITY;
-
-  // After clearing, we will still keep the last deleted entry
-  // in case there is an iterator out there
-  // pointing to the middle of the iteration chain. We need it to be
-  // able to merge back eventually.
-  firstIterationEntry_.set(runtime, lastIterationEntry_, runtime.getHeap());
-  firstIterationEntry_.getNonNull(runtime)->prevIterationEntry.setNull(
-      runtime.getHeap());
-  size_ = 0;
+  auto newTable = runtime.makeHandle(std::move(*arrRes));
+
+  // Every position in the old table continues at the start of the new one.
+  auto oldTable = runtime.makeHandle<SegmentedArraySmall>(self->table_);
+  setIndex(runtime, oldTable, FORWARDED_ENTRIES_SLOT, 0);
+  setIndex(runtime, oldTable, FORWARDED_LIVE_SLOT, 0);
+  oldTable->set(
+      runtime,
+      NEXT_TABLE_SLOT,
+      SmallHermesValue::encodeObjectValue(newTable.get(), runtime));
+
+  self->table_.setNonNull(runtime, newTable.get(), runtime.getHeap());
+  self->numBuckets_ = INITIAL_BUCKETS;
+  self->usedEntries_ = 0;
+  self->size_ = 0;
+  return ExecutionStatus::RETURNED;
 }
 
 } // namespace vm
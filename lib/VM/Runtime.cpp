@@ -129,23 +129,40 @@ class Runtime::StackRuntime {
 
 /* static */
 std::shared_ptr<Runtime> Runtime::create(const RuntimeConfig &runtimeConfig) {
-#if defined(HERMESVM_CONTIGUOUS_HEAP)
-  uint64_t maxHeapSize = runtimeConfig.getGCConfig().getMaxHeapSize();
+  const GCConfig &gcConfig = runtimeConfig.getGCConfig();
+  const bool hugePages = gcConfig.getHugePages();
+  const bool numaLocal = gcConfig.getNUMALocalSegments();
   // Allow some extra segments for the runtime, and as a buffer for the GC.
   uint64_t providerSize =
-      std::min<uint64_t>(1ULL << 32, maxHeapSize + AlignedStorage::size() * 4);
+      gcConfig.getMaxHeapSize() + AlignedStorage::size() * 4;
+#if defined(HERMESVM_CONTIGUOUS_HEAP)
+  providerSize = std::min<uint64_t>(1ULL << 32, providerSize);
   std::shared_ptr<StorageProvider> sp =
-      StorageProvider::contiguousVAProvider(providerSize);
+      StorageProvider::contiguousVAProvider(providerSize, hugePages, numaLocal);
   auto rt = HeapRuntime<Runtime>::create(sp);
   new (rt.get()) Runtime(std::move(sp), runtimeConfig);
   return rt;
-#elif defined(HERMES_FACEBOOK_BUILD) && !defined(HERMES_FBCODE_BUILD)
+#else
+  // Placement hints need a reservation to apply them to, so use a contiguous
+  // provider when they are requested.
+  if (hugePages || numaLocal) {
+    return std::shared_ptr<Runtime>{new Runtime(
+        StorageProvider::contiguousVAProvider(
+            providerSize, hugePages, numaLocal),
+        runtimeConfig)};
+  }
+  if (unsigned poolSize = gcConfig.getSegmentPoolSize()) {
+    return std::shared_ptr<Runtime>{new Runtime(
+        StorageProvider::pooledProvider(poolSize), runtimeConfig)};
+  }
+#if defined(HERMES_FACEBOOK_BUILD) && !defined(HERMES_FBCODE_BUILD)
   // TODO (T84179835): Disable this once it is no longer useful for debugging.
   return StackRuntime::create(runtimeConfig);
 #else
   return std::shared_ptr<Runtime>{
       new Runtime(StorageProvider::mmapProvider(), runtimeConfig)};
 #endif
+#endif
 }
 
 CallResult<PseudoHandle<>> Runtime::getNamed(
@@ -234,6 +251,7 @@ Runtime::Runtime(
       shouldRandomizeMemoryLayout_(runtimeConfig.getRandomizeMemoryLayout()),
       bytecodeWarmupPercent_(runtimeConfig.getBytecodeWarmupPercent()),
       trackIO_(runtimeConfig.getTrackIO()),
+      errorStackTraceLimit_(runtimeConfig.getErrorStackTraceLimit()),
       vmExperimentFlags_(runtimeConfig.getVMExperimentFlags()),
       commonStorage_(
           createRuntimeCommonStorage(runtimeConfig.getTraceEnabled())),
@@ -813,7 +831,11 @@ void Runtime::printArrayCensus(llvh::raw_ostream &os) {
   arraySizeToCountAndWastedSlots.clear();
   getHeap().forAllObjs([&arraySizeToCountAndWastedSlots, this](GCCell *cell) {
     if (JSArray *arr = dyn_vmcast<JSArray>(cell)) {
-      JSArray::StorageType *storage = arr->getIndexedStorage(*this);
+      // Only generic storage has slots to count.
+      JSArray::StorageType *storage =
+          arr->getElementKind(*this) == JSArray::ElementKind::Generic
+          ? arr->getIndexedStorage(*this)
+          : nullptr;
       const auto capacity = storage ? storage->totalCapacityOfSpine() : 0;
       const auto sz = storage ? storage->size(*this) : 0;
       const auto key = std::make_pair(capacity, arr->getAllocatedSize());
@@ -18,6 +18,7 @@
 
 #include <cassert>
 #include <limits>
+#include <mutex>
 #include <random>
 #include <stack>
 #pragma GCC diagnostic push
@@ -50,16 +51,104 @@ void *getMmapHint() {
   return alignAlloc(reinterpret_cast<void *>(addr));
 }
 
+/// Map a new, separate region of AlignedStorage::size() bytes named \p name.
+llvh::ErrorOr<void *> vmAllocateStorage(const char *name) {
+  assert(AlignedStorage::size() % oscompat::page_size() == 0);
+  // Allocate the space, hoping it will be the correct alignment.
+  auto result = oscompat::vm_allocate_aligned(
+      AlignedStorage::size(), AlignedStorage::size(), getMmapHint());
+  if (!result) {
+    return result;
+  }
+  void *mem = *result;
+  assert(isAligned(mem));
+  (void)isAligned;
+#ifdef HERMESVM_ALLOW_HUGE_PAGES
+  oscompat::vm_hugepage(mem, AlignedStorage::size());
+#endif
+
+  // Name the memory region on platforms that support naming.
+  oscompat::vm_name(mem, AlignedStorage::size(), name);
+  return mem;
+}
+
 class VMAllocateStorageProvider final : public StorageProvider {
  public:
   llvh::ErrorOr<void *> newStorageImpl(const char *name) override;
   void deleteStorageImpl(void *storage) override;
 };
 
+/// A process-wide cache of free storages, shared by all PooledStorageProviders
+/// so that runtimes can reuse each other's segments without going back to the
+/// OS.
+class StoragePool {
+ public:
+  /// \return the pool for this process. It is intentionally never destroyed,
+  ///   so that runtimes torn down during static destruction can still use it.
+  static StoragePool &get() {
+    static StoragePool *pool = new StoragePool();
+    return *pool;
+  }
+
+  /// \return a free storage from the pool, or null if it is empty.
+  void *take() {
+    std::lock_guard<std::mutex> lk{mtx_};
+    if (storages_.empty())
+      return nullptr;
+    return storages_.pop_back_val();
+  }
+
+  /// Add \p storage to the pool, unless it already holds \p limit storages.
+  /// \return true if the pool took ownership of \p storage.
+  bool give(void *storage, size_t limit) {
+    std::lock_guard<std::mutex> lk{mtx_};
+    if (storages_.size() >= limit)
+      return false;
+    storages_.push_back(storage);
+    return true;
+  }
+
+ private:
+  std::mutex mtx_;
+  llvh::SmallVector<void *, 0> storages_;
+};
+
+class PooledStorageProvider final : public StorageProvider {
+ public:
+  explicit PooledStorageProvider(size_t maxPooled) : maxPooled_(maxPooled) {}
+
+  llvh::ErrorOr<void *> newStorageImpl(const char *name) override {
+    if (void *storage = StoragePool::get().take()) {
+      oscompat::vm_name(storage, AlignedStorage::size(), name);
+      return storage;
+    }
+    return vmAllocateStorage(name);
+  }
+
+  void deleteStorageImpl(void *storage) override {
+    if (!storage) {
+      return;
+    }
+    // Keep the mapping, but let the OS reclaim the pages until the storage is
+    // reused.
+    oscompat::vm_unused(storage, AlignedStorage::size());
+    oscompat::vm_name(storage, AlignedStorage::size(), kFreeRegionName);
+    if (!StoragePool::get().give(storage, maxPooled_))
+      oscompat::vm_free_aligned(storage, AlignedStorage::size());
+  }
+
+ private:
+  static constexpr const char *kFreeRegionName = "hermes-pooled-heap";
+  /// The pool size up to which storage deleted by this provider is pooled.
+  size_t maxPooled_;
+};
+
 class ContiguousVAStorageProvider final : public StorageProvider {
  public:
-  ContiguousVAStorageProvider(size_t size)
-      : size_(llvh::alignTo<AlignedStorage::size()>(size)) {
+  ContiguousVAStorageProvider(size_t size, bool hugePages, bool numaLocal)
+      : size_(llvh::alignTo<AlignedStorage::size()>(size)),
+        hugePages_(hugePages),
+        numaLocal_(numaLocal) {
     auto result = oscompat::vm_reserve_aligned(
         size_, AlignedStorage::size(), getMmapHint());
     if (!result)
@@ -84,6 +173,12 @@ class ContiguousVAStorageProvider final : public StorageProvider {
     auto res = oscompat::vm_commit(storage, AlignedStorage::size());
     if (res) {
       oscompat::vm_name(storage, AlignedStorage::size(), name);
+      // Committing replaces the mapping, so the hints have to be applied
+      // every time, before any of the pages are touched.
+      if (hugePages_)
+        oscompat::vm_hugepage(storage, AlignedStorage::size());
+      if (numaLocal_)
+        oscompat::vm_bind_to_local_node(storage, AlignedStorage::size());
     }
     return res;
   }
@@ -101,6 +196,10 @@ class ContiguousVAStorageProvider final : public StorageProvider {
  private:
   static constexpr const char *kFreeRegionName = "hermes-free-heap";
   size_t size_;
+  /// Whether committed storage should be advised to use huge pages.
+  bool hugePages_;
+  /// Whether committed storage should be placed on the local NUMA node.
+  bool numaLocal_;
   char *start_;
   char *level_;
   llvh::SmallVector<void *, 0> freelist_;
@@ -120,23 +219,7 @@ class MallocStorageProvider final : public StorageProvider {
 
 llvh::ErrorOr<void *> VMAllocateStorageProvider::newStorageImpl(
     const char *name) {
-  assert(AlignedStorage::size() % oscompat::page_size() == 0);
-  // Allocate the space, hoping it will be the correct alignment.
-  auto result = oscompat::vm_allocate_aligned(
-      AlignedStorage::size(), AlignedStorage::size(), getMmapHint());
-  if (!result) {
-    return result;
-  }
-  void *mem = *result;
-  assert(isAligned(mem));
-  (void)isAligned;
-#ifdef HERMESVM_ALLOW_HUGE_PAGES
-  oscompat::vm_hugepage(mem, AlignedStorage::size());
-#endif
-
-  // Name the memory region on platforms that support naming.
-  oscompat::vm_name(mem, AlignedStorage::size(), name);
-  return mem;
+  return vmAllocateStorage(name);
 }
 
 void VMAllocateStorageProvider::deleteStorageImpl(void *storage) {
@@ -177,8 +260,17 @@ std::unique_ptr<StorageProvider> StorageProvider::mmapProvider() {
 
 /* static */
 std::unique_ptr<StorageProvider> StorageProvider::contiguousVAProvider(
-    size_t size) {
-  return std::make_unique<ContiguousVAStorageProvider>(size);
+    size_t size,
+    bool hugePages,
+    bool numaLocal) {
+  return std::make_unique<ContiguousVAStorageProvider>(
+      size, hugePages, numaLocal);
+}
+
+/* static */
+std::unique_ptr<StorageProvider> StorageProvider::pooledProvider(
+    size_t maxPooled) {
+  return std::make_unique<PooledStorageProvider>(maxPooled);
 }
 
 /* static */
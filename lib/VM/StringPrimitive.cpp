@@ -8,6 +8,7 @@
 #include "hermes/VM/StringPrimitive.h"
 
 #include "hermes/Support/Algorithms.h"
+#include "hermes/Support/CheckedMalloc.h"
 #include "hermes/Support/UTF8.h"
 #include "hermes/VM/BuildMetadata.h"
 #include "hermes/VM/FillerCell.h"
@@ -15,6 +16,7 @@
 #include "hermes/VM/HermesValue-inline.h"
 #include "hermes/VM/StringBuilder.h"
 #include "hermes/VM/StringView.h"
+#include "llvh/ADT/SmallVector.h"
 #include "llvh/Support/ConvertUTF.h"
 #pragma GCC diagnostic push
 
@@ -255,6 +257,24 @@ int StringPrimitive::compare(const StringPrimitive *other) const {
   return stringRefCompare(castToUTF16Ref(), other->castToUTF16Ref());
 }
 
+Handle<StringPrimitive> StringPrimitive::ensureFlat(
+    Runtime &runtime,
+    Handle<StringPrimitive> self) {
+  // Flattening a rope doesn't allocate in the JS heap yet, but callers must
+  // be prepared for it. Move the heap here.
+  runtime.potentiallyMoveHeap();
+  if (LLVM_UNLIKELY(isRopeStringPrimitive(self.get()))) {
+    if (self->isASCII()) {
+      vmcast<RopeASCIIStringPrimitive>(self.get())
+          ->flattenAndReleaseOperands(runtime.getHeap());
+    } else {
+      vmcast<RopeUTF16StringPrimitive>(self.get())
+          ->flattenAndReleaseOperands(runtime.getHeap());
+    }
+  }
+  return self;
+}
+
 CallResult<HermesValue> StringPrimitive::concat(
     Runtime &runtime,
     Handle<StringPrimitive> xHandle,
@@ -308,6 +328,18 @@ CallResult<HermesValue> StringPrimitive::slice(
   assert(
       start + length <= str->getStringLength() && "Invalid length for slice");
 
+  if (length == str->getStringLength())
+    return str.getHermesValue();
+  if (length >= SLICED_STRING_MIN_LENGTH) {
+    if (str->isASCII()) {
+      return SlicedASCIIStringPrimitive::create(runtime, str, start, length)
+          .getHermesValue();
+    } else {
+      return SlicedUTF16StringPrimitive::create(runtime, str, start, length)
+          .getHermesValue();
+    }
+  }
+
   SafeUInt32 safeLen(length);
 
   auto builder =
@@ -697,6 +729,18 @@ PseudoHandle<StringPrimitive> BufferedStringPrimitive<T>::append(
       runtime, storage->contents_.size(), runtime.makeHandle(storage));
 }
 
+/// \return whether the concatenation of \p left and \p right, which can't be
+/// appended to the concatenation buffer of \p left, should create a rope
+/// instead of copying both strings.
+static bool shouldCreateRope(StringPrimitive *left, StringPrimitive *right) {
+  if (right->getStringLength() < StringPrimitive::ROPE_MIN_RIGHT_LENGTH)
+    return false;
+  uint32_t depth = std::max(
+      RopeUTF16StringPrimitive::getDepth(left),
+      RopeUTF16StringPrimitive::getDepth(right));
+  return depth < StringPrimitive::MAX_ROPE_DEPTH;
+}
+
 PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
     Runtime &runtime,
     Handle<StringPrimitive> leftHnd,
@@ -705,6 +749,7 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
   auto *right = rightHnd.get();
 
   assertValidLength(left, right);
+  bool rope = shouldCreateRope(left, right);
 
   if (left->isASCII() && right->isASCII()) {
     if (auto *bufLeft = dyn_vmcast<BufferedASCIIStringPrimitive>(left)) {
@@ -715,6 +760,8 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
             runtime,
             rightHnd);
     }
+    if (rope)
+      return RopeASCIIStringPrimitive::create(runtime, leftHnd, rightHnd);
     return BufferedASCIIStringPrimitive::create(runtime, leftHnd, rightHnd);
   } else {
     if (auto *bufLeft = dyn_vmcast<BufferedUTF16StringPrimitive>(left)) {
@@ -726,6 +773,8 @@ PseudoHandle<StringPrimitive> internalConcatStringPrimitives(
             rightHnd);
       }
     }
+    if (rope)
+      return RopeUTF16StringPrimitive::create(runtime, leftHnd, rightHnd);
     return BufferedUTF16StringPrimitive::create(runtime, leftHnd, rightHnd);
   }
 }
@@ -746,5 +795,210 @@ void BufferedStringPrimitive<T>::_snapshotAddNodesImpl(
 
 template class BufferedStringPrimitive<char16_t>;
 template class BufferedStringPrimitive<char>;
+
+//===----------------------------------------------------------------------===//
+// RopeStringPrimitive<T>
+
+void RopeASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const RopeASCIIStringPrimitive *>(cell);
+  mb.setVTable(&RopeASCIIStringPrimitive::vt);
+  mb.addField("left", &self->leftHV_);
+  mb.addField("right", &self->rightHV_);
+}
+void RopeUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const RopeUTF16StringPrimitive *>(cell);
+  mb.setVTable(&RopeUTF16StringPrimitive::vt);
+  mb.addField("left", &self->leftHV_);
+  mb.addField("right", &self->rightHV_);
+}
+
+template <typename T>
+PseudoHandle<StringPrimitive> RopeStringPrimitive<T>::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> left,
+    Handle<StringPrimitive> right) {
+  assertValidLength(left.get(), right.get());
+  assert(
+      (std::is_same<T, char16_t>::value ||
+       (left->isASCII() && right->isASCII())) &&
+      "ASCII rope must have ASCII operands");
+  uint32_t depth = 1 + std::max(getDepth(left.get()), getDepth(right.get()));
+  assert(depth <= MAX_ROPE_DEPTH && "rope is too deep");
+  // We have to use a variable sized alloc here even though the size is already
+  // known, because RopeStringPrimitive is derived from VariableSizeRuntimeCell.
+  auto *cell =
+      runtime.makeAVariable<RopeStringPrimitive<T>, HasFinalizer::Yes>(
+          sizeof(RopeStringPrimitive<T>), runtime, left, right, depth);
+  return createPseudoHandle<StringPrimitive>(cell);
+}
+
+template <typename T>
+uint32_t RopeStringPrimitive<T>::getDepth(const StringPrimitive *str) {
+  if (!isRopeStringPrimitive(str))
+    return 0;
+  return str->isASCII() ? vmcast<RopeASCIIStringPrimitive>(str)->depth_
+                        : vmcast<RopeUTF16StringPrimitive>(str)->depth_;
+}
+
+/// If \p str is a rope that hasn't been flattened, push its operands onto
+/// \p stack so that the left one is popped first, and return true.
+static bool pushUnflattenedRopeOperands(
+    const StringPrimitive *str,
+    llvh::SmallVectorImpl<const StringPrimitive *> &stack) {
+  if (!isRopeStringPrimitive(str))
+    return false;
+  if (str->isASCII()) {
+    auto *rope = vmcast<RopeASCIIStringPrimitive>(str);
+    if (rope->isFlattened())
+      return false;
+    stack.push_back(rope->getRight());
+    stack.push_back(rope->getLeft());
+  } else {
+    auto *rope = vmcast<RopeUTF16StringPrimitive>(str);
+    if (rope->isFlattened())
+      return false;
+    stack.push_back(rope->getRight());
+    stack.push_back(rope->getLeft());
+  }
+  return true;
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::flatten() const {
+  assert(!flat_ && "rope is already flat");
+  T *flat = static_cast<T *>(checkedMalloc2(getStringLength(), sizeof(T)));
+  T *out = flat;
+
+  // Visit the leaves from left to right. Operands that are flat ropes are
+  // copied directly. The stack is bounded by the depth of the rope.
+  llvh::SmallVector<const StringPrimitive *, 16> stack;
+  pushUnflattenedRopeOperands(this, stack);
+  while (!stack.empty()) {
+    const StringPrimitive *str = stack.pop_back_val();
+    if (pushUnflattenedRopeOperands(str, stack))
+      continue;
+    uint32_t len = str->getStringLength();
+    if (str->isASCII()) {
+      out = std::copy(
+          str->castToASCIIPointer(), str->castToASCIIPointer() + len, out);
+    } else {
+      assert(
+          (std::is_same<T, char16_t>::value) &&
+          "ASCII rope must have ASCII operands");
+      const char16_t *chars = str->castToUTF16Pointer();
+      out = std::copy(chars, chars + len, out);
+    }
+  }
+  assert(out == flat + getStringLength() && "rope length mismatch");
+  flat_ = flat;
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::flattenAndReleaseOperands(GC &gc) {
+  if (!flat_)
+    flatten();
+  if (!leftHV_.isUndefined()) {
+    leftHV_.setNonPtr(HermesValue::encodeUndefinedValue(), gc);
+    rightHV_.setNonPtr(HermesValue::encodeUndefinedValue(), gc);
+  }
+}
+
+template <typename T>
+void RopeStringPrimitive<T>::_finalizeImpl(GCCell *cell, GC &gc) {
+  auto *self = vmcast<RopeStringPrimitive<T>>(cell);
+  if (self->flat_) {
+    gc.deferFinalization(
+        [](void *flat) { free(flat); }, std::exchange(self->flat_, nullptr));
+  }
+  self->~RopeStringPrimitive<T>();
+}
+
+template <typename T>
+size_t RopeStringPrimitive<T>::_mallocSizeImpl(GCCell *cell) {
+  auto *self = vmcast<RopeStringPrimitive<T>>(cell);
+  return self->flat_ ? self->getStringLength() * sizeof(T) : 0;
+}
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+template <typename T>
+void RopeStringPrimitive<T>::_snapshotAddEdgesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {}
+
+template <typename T>
+void RopeStringPrimitive<T>::_snapshotAddNodesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {}
+#endif
+
+template class RopeStringPrimitive<char16_t>;
+template class RopeStringPrimitive<char>;
+
+//===----------------------------------------------------------------------===//
+// SlicedStringPrimitive<T>
+
+void SlicedASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedASCIIStringPrimitive *>(cell);
+  mb.setVTable(&SlicedASCIIStringPrimitive::vt);
+  mb.addField("parent", &self->parentHV_);
+}
+void SlicedUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedUTF16StringPrimitive *>(cell);
+  mb.setVTable(&SlicedUTF16StringPrimitive::vt);
+  mb.addField("parent", &self->parentHV_);
+}
+
+template <typename T>
+PseudoHandle<StringPrimitive> SlicedStringPrimitive<T>::create(
+    Runtime &runtime,
+    Handle<StringPrimitive> str,
+    uint32_t start,
+    uint32_t length) {
+  assert(
+      start + length <= str->getStringLength() && "Invalid length for slice");
+  assert(
+      str->isASCII() == (std::is_same<T, char>::value) &&
+      "slice must have the character type of its parent");
+  // Refer to the parent of a slice directly, so that reading the characters
+  // never goes through more than one slice.
+  Handle<StringPrimitive> parent = str;
+  if (auto *sliced = dyn_vmcast<SlicedStringPrimitive<T>>(str.get())) {
+    start += sliced->getOffset();
+    parent = runtime.makeHandle(sliced->getParent());
+  }
+  // We have to use a variable sized alloc here even though the size is already
+  // known, because SlicedStringPrimitive is derived from
+  // VariableSizeRuntimeCell.
+  auto *cell = runtime.makeAVariable<SlicedStringPrimitive<T>>(
+      sizeof(SlicedStringPrimitive<T>), runtime, parent, start, length);
+  return createPseudoHandle<StringPrimitive>(cell);
+}
+
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+template <typename T>
+void SlicedStringPrimitive<T>::_snapshotAddEdgesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {}
+
+template <typename T>
+void SlicedStringPrimitive<T>::_snapshotAddNodesImpl(
+    GCCell *cell,
+    GC &gc,
+    HeapSnapshot &snap) {}
+#endif
+
+template class SlicedStringPrimitive<char16_t>;
+template class SlicedStringPrimitive<char>;
 } // namespace vm
 } // namespace hermes
@@ -6,6 +6,8 @@
  */
 
 #include "hermes/VM/StringView.h"
+
+#include "hermes/Support/StringSearch.h"
 #pragma GCC diagnostic push
 
 #ifdef HERMES_COMPILER_SUPPORTS_WSHORTEN_64_TO_32
@@ -32,6 +34,36 @@ UTF16Ref StringView::getUTF16Ref(
   return UTF16Ref(ptr, length());
 }
 
+OptValue<uint32_t> StringView::find(const StringView &needle) const {
+  if (isASCII()) {
+    ASCIIRef hay(castToCharPtr(), length());
+    return needle.isASCII()
+        ? findSubstring(hay, ASCIIRef(needle.castToCharPtr(), needle.length()))
+        : findSubstring(
+              hay, UTF16Ref(needle.castToChar16Ptr(), needle.length()));
+  }
+  UTF16Ref hay(castToChar16Ptr(), length());
+  return needle.isASCII()
+      ? findSubstring(hay, ASCIIRef(needle.castToCharPtr(), needle.length()))
+      : findSubstring(hay, UTF16Ref(needle.castToChar16Ptr(), needle.length()));
+}
+
+OptValue<uint32_t> StringView::findLast(const StringView &needle) const {
+  if (isASCII()) {
+    ASCIIRef hay(castToCharPtr(), length());
+    return needle.isASCII()
+        ? findLastSubstring(
+              hay, ASCIIRef(needle.castToCharPtr(), needle.length()))
+        : findLastSubstring(
+              hay, UTF16Ref(needle.castToChar16Ptr(), needle.length()));
+  }
+  UTF16Ref hay(castToChar16Ptr(), length());
+  return needle.isASCII()
+      ? findLastSubstring(hay, ASCIIRef(needle.castToCharPtr(), needle.length()))
+      : findLastSubstring(
+            hay, UTF16Ref(needle.castToChar16Ptr(), needle.length()));
+}
+
 llvh::raw_ostream &operator<<(llvh::raw_ostream &os, const StringView &sv) {
   if (sv.isASCII()) {
     return os << llvh::StringRef(sv.castToCharPtr(), sv.length());
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/VM/UnboxedArrayStorage.h"
+
+#include "hermes/VM/BuildMetadata.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace hermes {
+namespace vm {
+
+template <typename T>
+const VTable UnboxedArrayStorage<T>::vt(
+    UnboxedArrayStorage<T>::getCellKind(),
+    0,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr
+#ifdef HERMES_MEMORY_INSTRUMENTATION
+    ,
+    VTable::HeapSnapshotMetadata {
+      HeapSnapshot::NodeType::Array, nullptr, nullptr, nullptr, nullptr
+    }
+#endif
+);
+
+void ArrayStorageInt32BuildMeta(const GCCell *cell, Metadata::Builder &mb) {
+  mb.setVTable(&ArrayStorageInt32::vt);
+}
+
+void ArrayStorageDoubleBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
+  mb.setVTable(&ArrayStorageDouble::vt);
+}
+
+template <typename T>
+void UnboxedArrayStorage<T>::grow(
+    MutableHandle<UnboxedArrayStorage<T>> &selfHandle,
+    Runtime &runtime) {
+  const size_type sz = selfHandle->size();
+  assert(sz < maxElements() && "UnboxedArrayStorage is already full");
+  // Double the capacity, but start with room for at least 4 elements.
+  const size_type newCapacity = std::min<uint64_t>(
+      std::max<uint64_t>((uint64_t)selfHandle->capacity() * 2, 4),
+      maxElements());
+  auto *newSelf = create(runtime, newCapacity);
+  std::memcpy(newSelf->data(), selfHandle->data(), sz * sizeof(T));
+  newSelf->size_ = sz;
+  selfHandle = newSelf;
+}
+
+template class UnboxedArrayStorage<int32_t>;
+template class UnboxedArrayStorage<double>;
+
+} // namespace vm
+} // namespace hermes
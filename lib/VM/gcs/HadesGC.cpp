@@ -17,9 +17,11 @@
 #include "hermes/VM/GCPointer.h"
 #include "hermes/VM/RootAndSlotAcceptorDefault.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <functional>
-#include <stack>
+#include <numeric>
 
 #pragma GCC diagnostic push
 
@@ -138,6 +140,55 @@ void HadesGC::OldGen::addCellToFreelistFromSweep(
   __asan_poison_memory_region(newCell + 1, newCellSize - sizeof(FreelistCell));
 }
 
+GCCell *HadesGC::OldGen::allocFromCache(uint32_t sz) {
+  assert(sz < kMinSizeForLargeBlock && "Only small cells refill the cache");
+  if (GCCell *cell = carveFromAllocCache(sz))
+    return cell;
+  // Put the remainder back and take the first free cell from the smallest
+  // bucket that is large enough.
+  flushAllocCache();
+  const size_t bucket = freelistBucketBitArray_.findNextSetBitFrom(
+      getFreelistBucket(kMinAllocCacheSize));
+  if (bucket >= kNumFreelistBuckets)
+    return nullptr;
+  allocCache_ = removeCellFromFreelist(bucket, buckets_[bucket].next);
+  __asan_poison_memory_region(
+      allocCache_ + 1, allocCache_->getAllocatedSize() - sizeof(FreelistCell));
+  return carveFromAllocCache(sz);
+}
+
+GCCell *HadesGC::OldGen::carveFromAllocCache(uint32_t sz) {
+  if (!allocCache_)
+    return nullptr;
+  const uint32_t cacheSize = allocCache_->getAllocatedSize();
+  if (cacheSize == sz) {
+    FreelistCell *cell = allocCache_;
+    allocCache_ = nullptr;
+    __asan_unpoison_memory_region(cell + 1, sz - sizeof(FreelistCell));
+    return finishAlloc(cell, sz);
+  }
+  if (cacheSize < sz + minAllocationSize())
+    return nullptr;
+  GCCell *newCell = allocCache_->carve(sz);
+  __asan_unpoison_memory_region(newCell, sz);
+  return finishAlloc(newCell, sz);
+}
+
+void HadesGC::OldGen::flushAllocCache() {
+  if (!allocCache_)
+    return;
+  auto it = std::find_if(
+      segments_.begin(), segments_.end(), [this](const HeapSegment &seg) {
+        return seg.contains(allocCache_);
+      });
+  assert(it != segments_.end() && "Cache must be in an OG segment");
+  addCellToFreelist(
+      allocCache_,
+      &segmentBuckets_[it - segments_.begin()]
+                      [getFreelistBucket(allocCache_->getAllocatedSize())]);
+  allocCache_ = nullptr;
+}
+
 HadesGC::OldGen::FreelistCell *HadesGC::OldGen::removeCellFromFreelist(
     size_t bucket,
     SegmentBucket *segBucket) {
@@ -296,6 +347,11 @@ class HadesGC::CollectionStats final {
         Clock::now() - beginTime_);
   }
 
+  std::chrono::microseconds getElapsedTimeMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - beginTime_);
+  }
+
   /// Record this amount of CPU time was taken.
   /// Call begin/end in each thread that does work to correctly count CPU time.
   /// NOTE: Can only be used by one thread at a time.
@@ -479,6 +535,8 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
     std::memcpy(newCell, cell, cellSize);
     assert(newCell->isValid() && "Cell was copied incorrectly");
     evacuatedBytes_ += cellSize;
+    if (LLVM_UNLIKELY(gc.pretenure_) && gc.inYoungGen(cell))
+      gc.recordPromotion(newCell, cellSize);
     CopyListCell *const copyCell = static_cast<CopyListCell *>(cell);
     // Set the forwarding pointer in the old spot
     copyCell->setMarkedForwardingPointer(
@@ -580,6 +638,124 @@ class HadesGC::EvacAcceptor final : public RootAndSlotAcceptor,
   }
 };
 
+/// A fixed set of threads that run the parallel portions of a collection. The
+/// thread that calls run() acts as worker 0, so a pool of N workers owns N - 1
+/// threads.
+class HadesGC::WorkerPool {
+ public:
+  WorkerPool(unsigned numWorkers, const char *name) : numWorkers_(numWorkers) {
+    assert(numWorkers > 1 && "Use the calling thread for a single worker.");
+    for (unsigned i = 1; i < numWorkers; ++i)
+      threads_.emplace_back([this, i, name] { worker(i, name); });
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      shutdown_ = true;
+      workCV_.notify_all();
+    }
+    for (auto &thread : threads_)
+      thread.join();
+  }
+
+  unsigned numWorkers() const {
+    return numWorkers_;
+  }
+
+  /// Call \p fn with the index of each worker, on that worker, and block until
+  /// all of them have returned.
+  /// \return the time spent in \p fn, summed over all workers.
+  std::chrono::steady_clock::duration run(
+      const std::function<void(unsigned)> &fn) {
+    {
+      std::lock_guard<std::mutex> lk(mtx_);
+      task_ = &fn;
+      pending_ = threads_.size();
+      busyTime_ = {};
+      ++generation_;
+      workCV_.notify_all();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    fn(0);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    std::unique_lock<std::mutex> lk(mtx_);
+    doneCV_.wait(lk, [this] { return pending_ == 0; });
+    task_ = nullptr;
+    return busyTime_ + elapsed;
+  }
+
+ private:
+  void worker(unsigned idx, const char *name) {
+    oscompat::set_thread_name(name);
+    uint64_t seenGeneration = 0;
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (true) {
+      workCV_.wait(lk, [this, seenGeneration] {
+        return shutdown_ || generation_ != seenGeneration;
+      });
+      if (shutdown_)
+        return;
+      seenGeneration = generation_;
+      const std::function<void(unsigned)> &fn = *task_;
+      lk.unlock();
+      const auto start = std::chrono::steady_clock::now();
+      fn(idx);
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+      lk.lock();
+      busyTime_ += elapsed;
+      if (--pending_ == 0)
+        doneCV_.notify_one();
+    }
+  }
+
+  const unsigned numWorkers_;
+  std::mutex mtx_;
+  std::condition_variable workCV_;
+  std::condition_variable doneCV_;
+  /// The function being run by the workers. Only valid while pending_ > 0.
+  const std::function<void(unsigned)> *task_{nullptr};
+  /// Incremented every time run() is called, so that workers can tell new
+  /// tasks apart from spurious wakeups.
+  uint64_t generation_{0};
+  /// The number of helper threads that have not yet finished task_.
+  size_t pending_{0};
+  std::chrono::steady_clock::duration busyTime_{};
+  bool shutdown_{false};
+  std::vector<std::thread> threads_;
+};
+
+/// The workers that scan dirty cards during a YG collection, along with the
+/// slots each of them found.
+class HadesGC::EvacWorkers final : public WorkerPool {
+ public:
+  /// The kinds of slots that may contain a pointer into the YG/compactee.
+  enum class SlotKind : uint8_t {
+    Pointer,
+    HermesValue,
+    SmallHermesValue,
+  };
+
+  /// A slot found by a worker that the EvacAcceptor needs to update.
+  struct Slot {
+    void *loc;
+    SlotKind kind;
+  };
+
+  explicit EvacWorkers(unsigned numWorkers)
+      : WorkerPool(numWorkers, "hades-yg"), slots_(numWorkers) {}
+
+  /// \return the slots recorded by the worker with index \p worker.
+  std::vector<Slot> &slots(unsigned worker) {
+    return slots_[worker];
+  }
+
+ private:
+  /// Slots recorded by each worker. Kept across collections to reuse their
+  /// capacity.
+  std::vector<std::vector<Slot>> slots_;
+};
+
 class MarkWorklist {
  private:
   /// Like std::vector but has a fixed capacity specified by N to reduce memory
@@ -688,6 +864,108 @@ class MarkWorklist {
   llvh::SmallVector<GCCell *, 0> worklist_;
 };
 
+/// Marking work shared between the threads of a parallel mark. A marker that
+/// has work while others are idle gives some of it away, and idle markers take
+/// it from here. Marking ends when every marker is idle and no work is left, or
+/// when any marker asks the others to stop.
+class HadesGC::SharedMarkStack {
+ public:
+  explicit SharedMarkStack(unsigned numMarkers) : numMarkers_(numMarkers) {}
+
+  /// Prepare for a new round of parallel marking.
+  void begin() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    numIdle_.store(0, std::memory_order_relaxed);
+    stop_ = false;
+  }
+
+  /// \return true if some marker is waiting for work that nobody has given
+  /// yet.
+  bool hasIdleMarkers() const {
+    return numIdle_.load(std::memory_order_relaxed) >
+        numChunks_.load(std::memory_order_relaxed);
+  }
+
+  /// Make \p work available to the other markers.
+  void give(std::vector<GCCell *> &&work) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    chunks_.push_back(std::move(work));
+    numChunks_.store(chunks_.size(), std::memory_order_relaxed);
+    cv_.notify_one();
+  }
+
+  /// Move some shared work into the empty \p worklist, waiting for another
+  /// marker to give some if necessary.
+  /// \return false if this round of marking is over.
+  bool take(std::vector<GCCell *> &worklist) {
+    assert(worklist.empty() && "Only idle markers should take work");
+    std::unique_lock<std::mutex> lk(mtx_);
+    numIdle_.fetch_add(1, std::memory_order_relaxed);
+    while (true) {
+      if (stop_)
+        return false;
+      if (!chunks_.empty()) {
+        worklist = std::move(chunks_.back());
+        chunks_.pop_back();
+        numChunks_.store(chunks_.size(), std::memory_order_relaxed);
+        numIdle_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+      // Every marker is out of work, and only a running marker can produce
+      // more, so marking is complete. Leave numIdle_ as is so that the other
+      // waiting markers exit as well.
+      if (numIdle_.load(std::memory_order_relaxed) == numMarkers_) {
+        cv_.notify_all();
+        return false;
+      }
+      cv_.wait(lk);
+    }
+  }
+
+  /// End this round of marking early, for instance to let the mutator acquire
+  /// the GC lock. Work that has not been processed stays in the stack.
+  void stop(std::vector<GCCell *> &&work) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (!work.empty()) {
+      chunks_.push_back(std::move(work));
+      numChunks_.store(chunks_.size(), std::memory_order_relaxed);
+    }
+    stop_ = true;
+    cv_.notify_all();
+  }
+
+  bool stopped() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return stop_;
+  }
+
+  /// Move all of the remaining work into \p worklist. Only called when no
+  /// marking round is in progress.
+  void drainInto(std::vector<GCCell *> &worklist) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    for (auto &chunk : chunks_)
+      worklist.insert(worklist.end(), chunk.begin(), chunk.end());
+    chunks_.clear();
+    numChunks_.store(0, std::memory_order_relaxed);
+  }
+
+  bool empty() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return chunks_.empty();
+  }
+
+ private:
+  const unsigned numMarkers_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::vector<std::vector<GCCell *>> chunks_;
+  /// The number of markers waiting in take(), and the size of chunks_. Atomic
+  /// so that running markers can cheaply check whether to share their work.
+  std::atomic<unsigned> numIdle_{0};
+  std::atomic<size_t> numChunks_{0};
+  bool stop_{false};
+};
+
 class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
                                     public WeakRefAcceptor {
  public:
@@ -695,7 +973,15 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
       : gc{gc},
         pointerBase_{gc.getPointerBase()},
         markedSymbols_{gc.gcCallbacks_.getSymbolsEnd()},
-        writeBarrierMarkedSymbols_{gc.gcCallbacks_.getSymbolsEnd()} {}
+        writeBarrierMarkedSymbols_{gc.gcCallbacks_.getSymbolsEnd()} {
+    if (gc.ogWorkers_) {
+      const unsigned numMarkers = gc.ogWorkers_->numWorkers();
+      ownedSharedStack_ = std::make_unique<SharedMarkStack>(numMarkers);
+      sharedStack_ = ownedSharedStack_.get();
+      for (unsigned i = 1; i < numMarkers; ++i)
+        helpers_.emplace_back(new MarkAcceptor{gc, *sharedStack_});
+    }
+  }
 
   void acceptHeap(GCCell *cell, const void *heapLoc) {
     assert(cell && "Cannot pass null pointer to acceptHeap");
@@ -835,9 +1121,10 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
   /// \c setDrainRate or kConcurrentMarkLimit.
   /// \return true if there is any remaining work in the local worklist.
   bool drainSomeWork() {
+    if (sharedStack_)
+      return drainInParallel();
     // See the comment in setDrainRate for why the drain rate isn't used for
     // concurrent collections.
-    constexpr size_t kConcurrentMarkLimit = 8192;
     return drainSomeWork(kConcurrentGC ? kConcurrentMarkLimit : byteDrainRate_);
   }
 
@@ -851,27 +1138,16 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
   /// \return true if there is any remaining work in the local worklist.
   bool drainSomeWork(const size_t markLimit) {
     assert(gc.gcMutex_ && "Must hold the GC lock while accessing mark bits.");
-    // Pull any new items off the global worklist.
-    auto cells = globalWorklist_.drain();
-    for (GCCell *cell : cells) {
-      assert(
-          cell->isValid() && "Invalid cell received off the global worklist");
-      assert(
-          !gc.inYoungGen(cell) &&
-          "Shouldn't ever traverse a YG object in this loop");
-      HERMES_SLOW_ASSERT(
-          gc.dbgContains(cell) && "Non-heap cell found in global worklist");
-      if (!HeapSegment::getCellMarkBit(cell)) {
-        // Cell has not yet been marked.
-        push(cell);
-      }
-    }
+    // Take back any work left over from parallel marking.
+    if (sharedStack_)
+      sharedStack_->drainInto(localWorklist_);
+    pullGlobalWorklist();
 
     size_t numMarkedBytes = 0;
     assert(markLimit && "markLimit must be non-zero!");
     while (!localWorklist_.empty() && numMarkedBytes < markLimit) {
-      GCCell *const cell = localWorklist_.top();
-      localWorklist_.pop();
+      GCCell *const cell = localWorklist_.back();
+      localWorklist_.pop_back();
       assert(cell->isValid() && "Invalid cell in marking");
       assert(HeapSegment::getCellMarkBit(cell) && "Discovered unmarked object");
       assert(
@@ -903,19 +1179,34 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
   llvh::BitVector &markedSymbols() {
     assert(gc.gcMutex_ && "Cannot call markedSymbols without a lock");
     markedSymbols_ |= writeBarrierMarkedSymbols_;
+    for (auto &helper : helpers_)
+      markedSymbols_ |= helper->markedSymbols_;
     // No need to clear writeBarrierMarkedSymbols_, or'ing it again won't change
     // the bit vector.
     return markedSymbols_;
   }
 
  private:
+  /// Limit on the bytes marked between checks for whether the mutator wants
+  /// the GC lock back.
+  static constexpr size_t kConcurrentMarkLimit = 8192;
+
+  /// Create a helper for a parallel mark, which shares work through
+  /// \p sharedStack.
+  MarkAcceptor(HadesGC &gc, SharedMarkStack &sharedStack)
+      : gc{gc},
+        pointerBase_{gc.getPointerBase()},
+        markedSymbols_{gc.gcCallbacks_.getSymbolsEnd()},
+        sharedStack_{&sharedStack} {}
+
   HadesGC &gc;
   PointerBase &pointerBase_;
 
   /// A worklist local to the marking thread, that is only pushed onto by the
   /// marking thread. If this is empty, the global worklist must be consulted
-  /// to ensure that pointers modified in write barriers are handled.
-  std::stack<GCCell *, std::vector<GCCell *>> localWorklist_;
+  /// to ensure that pointers modified in write barriers are handled. Used as
+  /// a stack.
+  std::vector<GCCell *> localWorklist_;
 
   /// A worklist that other threads may add to as objects to be marked and
   /// considered alive. These objects will *not* have their mark bits set,
@@ -947,14 +1238,121 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
   /// The number of bytes that have been marked so far.
   uint64_t markedBytes_{0};
 
+  /// Work shared between the markers of a parallel mark. Null if marking is
+  /// done on a single thread.
+  SharedMarkStack *sharedStack_{nullptr};
+  std::unique_ptr<SharedMarkStack> ownedSharedStack_;
+
+  /// The markers run by the other ogWorkers_. Only the marker owned by
+  /// the GC has helpers.
+  std::vector<std::unique_ptr<MarkAcceptor>> helpers_;
+
+  /// Move the cells enqueued by write barriers onto the local worklist.
+  void pullGlobalWorklist() {
+    auto cells = globalWorklist_.drain();
+    for (GCCell *cell : cells) {
+      assert(
+          cell->isValid() && "Invalid cell received off the global worklist");
+      assert(
+          !gc.inYoungGen(cell) &&
+          "Shouldn't ever traverse a YG object in this loop");
+      HERMES_SLOW_ASSERT(
+          gc.dbgContains(cell) && "Non-heap cell found in global worklist");
+      if (!HeapSegment::getCellMarkBit(cell)) {
+        // Cell has not yet been marked.
+        push(cell);
+      }
+    }
+  }
+
+  /// Mark on all of the ogWorkers_, until either there is no work left or
+  /// the mutator asks for the GC lock.
+  /// \return true if there is any remaining work.
+  bool drainInParallel() {
+    assert(gc.gcMutex_ && "Must hold the GC lock while accessing mark bits.");
+    assert(kConcurrentGC && "Parallel marking requires a concurrent GC.");
+    pullGlobalWorklist();
+    sharedStack_->drainInto(localWorklist_);
+    sharedStack_->begin();
+    auto &workers = *gc.ogWorkers_;
+    const auto start = std::chrono::steady_clock::now();
+    const auto busyTime = workers.run([this](unsigned worker) {
+      (worker ? *helpers_[worker - 1] : *this).markInParallel();
+    });
+    gc.ogParallelBusyTime_ += busyTime;
+    gc.ogParallelAvailableTime_ +=
+        (std::chrono::steady_clock::now() - start) * workers.numWorkers();
+    // Collect the results of the helpers, so that the rest of the collection
+    // only has to look at this marker.
+    for (auto &helper : helpers_) {
+      assert(
+          helper->localWorklist_.empty() &&
+          "Helpers must give away their work when they finish");
+      markedBytes_ += helper->markedBytes_;
+      helper->markedBytes_ = 0;
+      reachableWeakMaps_.insert(
+          reachableWeakMaps_.end(),
+          helper->reachableWeakMaps_.begin(),
+          helper->reachableWeakMaps_.end());
+      helper->reachableWeakMaps_.clear();
+    }
+    assert(localWorklist_.empty() && "Marker finished with work left");
+    return !sharedStack_->empty();
+  }
+
+  /// The loop run by each marker in a parallel mark. Cells reachable from the
+  /// local worklist are marked, work is shared with idle markers, and more is
+  /// taken once the local worklist runs out.
+  void markInParallel() {
+    size_t bytesSinceCheck = 0;
+    do {
+      while (!localWorklist_.empty()) {
+        if (bytesSinceCheck >= kConcurrentMarkLimit) {
+          bytesSinceCheck = 0;
+          // Stop all of the markers if the mutator is waiting to acquire the
+          // GC lock from the thread that started this mark.
+          if (gc.ogPaused_.load(std::memory_order_relaxed) ||
+              sharedStack_->stopped()) {
+            sharedStack_->stop(std::move(localWorklist_));
+            localWorklist_.clear();
+            return;
+          }
+        }
+        if (localWorklist_.size() > 1 && sharedStack_->hasIdleMarkers()) {
+          // Give away the oldest half of the worklist, which is likely to
+          // lead to more work than the newest cells.
+          const auto mid = localWorklist_.begin() + localWorklist_.size() / 2;
+          sharedStack_->give({localWorklist_.begin(), mid});
+          localWorklist_.erase(localWorklist_.begin(), mid);
+        }
+        GCCell *const cell = localWorklist_.back();
+        localWorklist_.pop_back();
+        assert(cell->isValid() && "Invalid cell in marking");
+        assert(
+            HeapSegment::getCellMarkBit(cell) && "Discovered unmarked object");
+        const auto sz = cell->getAllocatedSize();
+        bytesSinceCheck += sz;
+        markedBytes_ += sz;
+        gc.markCell(cell, *this);
+      }
+    } while (sharedStack_->take(localWorklist_));
+  }
+
   void push(GCCell *cell) {
-    assert(
-        !HeapSegment::getCellMarkBit(cell) &&
-        "A marked object should never be pushed onto a worklist");
     assert(
         !gc.inYoungGen(cell) &&
         "Shouldn't ever push a YG object onto the worklist");
-    HeapSegment::setCellMarkBit(cell);
+    if (sharedStack_) {
+      // Several markers may find the same cell at once. Only the one that
+      // sets its mark bit pushes it.
+      if (!HeapSegment::setCellMarkBitAtomic(cell))
+        return;
+    } else {
+      assert(
+          !HeapSegment::getCellMarkBit(cell) &&
+          "A marked object should never be pushed onto a worklist");
+      HeapSegment::setCellMarkBit(cell);
+    }
     // There could be a race here: however, the mutator will never change a
     // cell's kind after initialization. The GC thread might to a free cell, but
     // only during sweeping, not concurrently with this operation. Therefore
@@ -962,7 +1360,7 @@ class HadesGC::MarkAcceptor final : public RootAndSlotAcceptor,
     if (vmisa<JSWeakMap>(cell)) {
       reachableWeakMaps_.push_back(vmcast<JSWeakMap>(cell));
     } else {
-      localWorklist_.push(cell);
+      localWorklist_.push_back(cell);
     }
   }
 
@@ -1043,7 +1441,8 @@ class HadesGC::MarkWeakRootsAcceptor final : public WeakRootAcceptor {
 
 class HadesGC::Executor {
  public:
-  Executor() : thread_([this] { worker(); }) {}
+  explicit Executor(const char *name = "hades")
+      : name_(name), thread_([this] { worker(); }) {}
   ~Executor() {
     {
       std::lock_guard<std::mutex> lk(mtx_);
@@ -1073,7 +1472,7 @@ class HadesGC::Executor {
 
  private:
   void worker() {
-    oscompat::set_thread_name("hades");
+    oscompat::set_thread_name(name_);
     std::unique_lock<std::mutex> lk(mtx_);
     while (!shutdown_) {
       cv_.wait(lk, [this]() { return !queue_.empty() || shutdown_; });
@@ -1091,50 +1490,113 @@ class HadesGC::Executor {
   std::condition_variable cv_;
   std::deque<std::function<void()>> queue_;
   bool shutdown_{false};
+  const char *const name_;
   std::thread thread_;
 };
 
-bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
-  // Check if there are any more segments to sweep. Note that in the case where
-  // OG has zero segments, this also skips updating the stats and survival ratio
-  // at the end of this function, since they are not required.
-  if (!sweepIterator_.segNumber)
-    return false;
-  assert(gc_.gcMutex_ && "gcMutex_ must be held while sweeping.");
+/// Finds the slots in the OG that point into the YG/compactee, without
+/// modifying the heap. This allows several recorders to run concurrently on
+/// disjoint card ranges, leaving the actual evacuation to the EvacAcceptor.
+template <bool CompactionEnabled>
+class HadesGC::DirtySlotRecorder final {
+ public:
+  using Slot = EvacWorkers::Slot;
+  using SlotKind = EvacWorkers::SlotKind;
 
-  sweepIterator_.segNumber--;
+  DirtySlotRecorder(HadesGC &gc, std::vector<Slot> &slots)
+      : gc_{gc}, slots_{slots} {}
 
-  const bool isTracking = gc_.isTrackingIDs();
-  // Re-evaluate this start point each time, as releasing the gcMutex_ allows
-  // allocations into the old gen, which might boost the credited memory.
-  const uint64_t externalBytesBefore = externalBytes();
+  void accept(GCPointerBase &ptr) {
+    if (shouldForward(ptr))
+      slots_.push_back({&ptr, SlotKind::Pointer});
+  }
 
-  auto &segBuckets = segmentBuckets_[sweepIterator_.segNumber];
+  void accept(GCHermesValue &hv) {
+    if (hv.isPointer() && shouldForward(hv.getPointer()))
+      slots_.push_back({&hv, SlotKind::HermesValue});
+  }
 
-  // Clear the head pointers and remove this segment from the segment level
-  // freelists, so that we can construct a new freelist. The
-  // freelistBucketBitArray_ will be updated after the segment is swept. The
-  // bits will be inconsistent with the actual freelist for the duration of
-  // sweeping, but this is fine because gcMutex_ is held during the entire
-  // period.
-  for (size_t bucket = 0; bucket < kNumFreelistBuckets; bucket++) {
-    auto *segBucket = &segBuckets[bucket];
-    if (segBucket->head) {
-      segBucket->removeFromFreelist();
-      segBucket->head = nullptr;
+  void accept(GCSmallHermesValue &hv) {
+    if (hv.isPointer() && shouldForward(hv.getPointer()))
+      slots_.push_back({&hv, SlotKind::SmallHermesValue});
+  }
+
+  void accept(const GCSymbolID &sym) {}
+
+  /// Pass each of the recorded \p slots to \p acceptor.
+  static void apply(
+      EvacAcceptor<CompactionEnabled> &acceptor,
+      const std::vector<Slot> &slots) {
+    for (const Slot &slot : slots) {
+      switch (slot.kind) {
+        case SlotKind::Pointer:
+          acceptor.accept(*static_cast<GCPointerBase *>(slot.loc));
+          break;
+        case SlotKind::HermesValue:
+          acceptor.accept(*static_cast<GCHermesValue *>(slot.loc));
+          break;
+        case SlotKind::SmallHermesValue:
+          acceptor.accept(*static_cast<GCSmallHermesValue *>(slot.loc));
+          break;
+      }
     }
   }
 
+ private:
+  HadesGC &gc_;
+  std::vector<Slot> &slots_;
+
+  // Pointers into the compactee that is not being evacuated yet are not
+  // recorded. The EvacAcceptor would only dirty the card containing them, and
+  // that card is necessarily already dirty since it is being scanned.
+  bool shouldForward(const void *ptr) const {
+    return gc_.inYoungGen(ptr) ||
+        (CompactionEnabled && gc_.compactee_.evacContains(ptr));
+  }
+  bool shouldForward(CompressedPointer ptr) const {
+    return gc_.inYoungGen(ptr) ||
+        (CompactionEnabled && gc_.compactee_.evacContains(ptr));
+  }
+};
+
+struct HadesGC::OldGen::SegmentSweep {
+  /// A range of consecutive dead cells, [start, end), that becomes a single
+  /// free cell. \c merged is true if it combines several cells.
+  struct FreeRange {
+    char *start;
+    char *end;
+    bool merged;
+  };
+
+  std::vector<FreeRange> freeRanges;
+
+  /// Dead cells that need their finalizer run or their ID untracked. This
+  /// touches state outside the segment, so it is done serially.
+  std::vector<GCCell *> deadCells;
+
+  /// The number of bytes freed, not counting existing freelist cells.
+  int32_t sweptBytes{0};
+
+  /// The number of bytes in all of freeRanges.
+  uint32_t freeBytes{0};
+
+#ifndef NDEBUG
+  /// The number of bytes trimmed from live cells.
+  uint64_t trimmedBytes{0};
+#endif
+};
+
+void HadesGC::OldGen::scanSegmentForSweep(
+    size_t segIdx,
+    bool trim,
+    bool isTracking,
+    SegmentSweep &sweep) {
   char *freeRangeStart = nullptr, *freeRangeEnd = nullptr;
   size_t mergedCells = 0;
-  int32_t segmentSweptBytes = 0;
-  for (GCCell *cell : segments_[sweepIterator_.segNumber].cells()) {
+  for (GCCell *cell : segments_[segIdx].cells()) {
     assert(cell->isValid() && "Invalid cell in sweeping");
     if (HeapSegment::getCellMarkBit(cell)) {
-      // Cannot concurrently trim storage. Technically just checking
-      // backgroundThread would suffice, but the kConcurrentGC lets us compile
-      // away this check in incremental mode.
-      if (kConcurrentGC && backgroundThread)
+      if (!trim)
         continue;
       const uint32_t cellSize = cell->getAllocatedSize();
       const uint32_t trimmedSize =
@@ -1160,7 +1622,7 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
             "Trimmed space cannot be marked");
         HeapSegment::setCellHead(newCell, trimmableBytes);
 #ifndef NDEBUG
-        sweepIterator_.trimmedBytes += trimmableBytes;
+        sweep.trimmedBytes += trimmableBytes;
 #endif
       }
       continue;
@@ -1174,9 +1636,11 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
           freeRangeEnd < cellCharPtr &&
           "Should not overshoot the start of an object");
       // We are starting a new free range, flush the previous one.
-      if (LLVM_LIKELY(freeRangeStart))
-        addCellToFreelistFromSweep(
-            freeRangeStart, freeRangeEnd, segBuckets, mergedCells > 1);
+      if (LLVM_LIKELY(freeRangeStart)) {
+        sweep.freeRanges.push_back(
+            {freeRangeStart, freeRangeEnd, mergedCells > 1});
+        sweep.freeBytes += freeRangeEnd - freeRangeStart;
+      }
 
       mergedCells = 0;
       freeRangeEnd = freeRangeStart = cellCharPtr;
@@ -1188,18 +1652,33 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
     if (vmisa<FreelistCell>(cell))
       continue;
 
-    segmentSweptBytes += sz;
-    // Cell is dead, run its finalizer first if it has one.
-    cell->getVT()->finalizeIfExists(cell, gc_);
-    if (isTracking && !vmisa<FillerCell>(cell)) {
-      gc_.untrackObject(cell, sz);
-    }
+    sweep.sweptBytes += sz;
+    if (cell->getVT()->finalize_ || (isTracking && !vmisa<FillerCell>(cell)))
+      sweep.deadCells.push_back(cell);
   }
 
   // Flush any free range that was left over.
-  if (freeRangeStart)
+  if (freeRangeStart) {
+    sweep.freeRanges.push_back({freeRangeStart, freeRangeEnd, mergedCells > 1});
+    sweep.freeBytes += freeRangeEnd - freeRangeStart;
+  }
+}
+
+void HadesGC::OldGen::finishSegmentSweep(
+    size_t segIdx,
+    const SegmentSweep &sweep,
+    bool isTracking) {
+  // Dead cells must be finalized before the free ranges overwrite them.
+  for (GCCell *cell : sweep.deadCells) {
+    cell->getVT()->finalizeIfExists(cell, gc_);
+    if (isTracking && !vmisa<FillerCell>(cell))
+      gc_.untrackObject(cell, cell->getAllocatedSize());
+  }
+
+  auto &segBuckets = segmentBuckets_[segIdx];
+  for (const auto &range : sweep.freeRanges)
     addCellToFreelistFromSweep(
-        freeRangeStart, freeRangeEnd, segBuckets, mergedCells > 1);
+        range.start, range.end, segBuckets, range.merged);
 
   // Update the segment level freelists for any buckets that this segment has
   // free cells for.
@@ -1207,17 +1686,84 @@ bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
     auto *segBucket = &segBuckets[bucket];
     if (segBucket->head)
       segBucket->addToFreelist(&buckets_[bucket]);
-
-    // In case sweeping has changed the availability of a bucket, update the
-    // overall bit array. Note that this is necessary even if segBucket->head is
-    // null, as the bits were not updated when the freelist for this segment was
-    // erased prior to sweeping.
-    freelistBucketBitArray_.set(bucket, buckets_[bucket].next);
   }
 
+  segmentLiveBytes_[segIdx] = segments_[segIdx].used() - sweep.freeBytes;
+
   // Correct the allocated byte count.
-  incrementAllocatedBytes(-segmentSweptBytes);
-  sweepIterator_.sweptBytes += segmentSweptBytes;
+  incrementAllocatedBytes(-sweep.sweptBytes);
+  sweepIterator_.sweptBytes += sweep.sweptBytes;
+#ifndef NDEBUG
+  sweepIterator_.trimmedBytes += sweep.trimmedBytes;
+#endif
+}
+
+bool HadesGC::OldGen::sweepNext(bool backgroundThread) {
+  // Check if there are any more segments to sweep. Note that in the case where
+  // OG has zero segments, this also skips updating the stats and survival ratio
+  // at the end of this function, since they are not required.
+  if (!sweepIterator_.segNumber)
+    return false;
+  assert(gc_.gcMutex_ && "gcMutex_ must be held while sweeping.");
+  // The sweeper rebuilds the freelists, and would otherwise find the cache
+  // cell and free it a second time.
+  flushAllocCache();
+
+  // Sweep one segment per OG worker, ending at the current segment.
+  const size_t numSegs = std::min<size_t>(
+      sweepIterator_.segNumber,
+      gc_.ogWorkers_ ? gc_.ogWorkers_->numWorkers() : 1);
+  sweepIterator_.segNumber -= numSegs;
+  const size_t firstSeg = sweepIterator_.segNumber;
+
+  const bool isTracking = gc_.isTrackingIDs();
+  // Cannot concurrently trim storage. Technically just checking
+  // backgroundThread would suffice, but the kConcurrentGC lets us compile
+  // away this check in incremental mode.
+  const bool trim = !(kConcurrentGC && backgroundThread);
+  // Re-evaluate this start point each time, as releasing the gcMutex_ allows
+  // allocations into the old gen, which might boost the credited memory.
+  const uint64_t externalBytesBefore = externalBytes();
+
+  // Clear the head pointers and remove these segments from the segment level
+  // freelists, so that we can construct new freelists. The
+  // freelistBucketBitArray_ will be updated after the segments are swept. The
+  // bits will be inconsistent with the actual freelist for the duration of
+  // sweeping, but this is fine because gcMutex_ is held during the entire
+  // period.
+  for (size_t segIdx = firstSeg; segIdx < firstSeg + numSegs; ++segIdx) {
+    for (auto &segBucket : segmentBuckets_[segIdx]) {
+      if (segBucket.head) {
+        segBucket.removeFromFreelist();
+        segBucket.head = nullptr;
+      }
+    }
+  }
+
+  // Finding the free memory in a segment only touches that segment, so it is
+  // split across the workers. Finalizers and the freelists shared between
+  // segments are handled serially afterwards.
+  llvh::SmallVector<SegmentSweep, 1> sweeps(numSegs);
+  if (numSegs > 1) {
+    gc_.ogWorkers_->run([&](unsigned worker) {
+      if (worker < numSegs)
+        scanSegmentForSweep(
+            firstSeg + worker, trim, isTracking, sweeps[worker]);
+    });
+  } else {
+    scanSegmentForSweep(firstSeg, trim, isTracking, sweeps[0]);
+  }
+  for (size_t i = 0; i < numSegs; ++i)
+    finishSegmentSweep(firstSeg + i, sweeps[i], isTracking);
+  gc_.flushDeferredFinalizers();
+
+  // In case sweeping has changed the availability of a bucket, update the
+  // overall bit array. Note that this is necessary even if no segment has free
+  // cells in a bucket, as the bits were not updated when the freelists for the
+  // swept segments were erased prior to sweeping.
+  for (size_t bucket = 0; bucket < kNumFreelistBuckets; ++bucket)
+    freelistBucketBitArray_.set(bucket, buckets_[bucket].next);
+
   sweepIterator_.sweptExternalBytes += externalBytesBefore - externalBytes();
 
   // There are more iterations to go.
@@ -1275,6 +1821,9 @@ size_t HadesGC::OldGen::getMemorySize() const {
 // Assume about 30% of the YG will survive initially.
 constexpr double kYGInitialSurvivalRatio = 0.3;
 
+// Assume YG collections evacuate about 256KB per millisecond initially.
+constexpr double kYGInitialEvacuationRate = 256 * 1024;
+
 HadesGC::OldGen::OldGen(HadesGC &gc) : gc_(gc) {}
 
 HadesGC::HadesGC(
@@ -1298,14 +1847,31 @@ HadesGC::HadesGC(
       oldGen_{*this},
       backgroundExecutor_{
           kConcurrentGC ? std::make_unique<Executor>() : nullptr},
+      ygEvacWorkers_{
+          kConcurrentGC && gcConfig.getYoungGenThreads() > 1
+              ? std::make_unique<EvacWorkers>(gcConfig.getYoungGenThreads())
+              : nullptr},
+      ogWorkers_{
+          kConcurrentGC && gcConfig.getOldGenThreads() > 1
+              ? std::make_unique<WorkerPool>(
+                    gcConfig.getOldGenThreads(), "hades-og")
+              : nullptr},
+      finalizerExecutor_{
+          kConcurrentGC && gcConfig.getConcurrentFinalization()
+              ? std::make_unique<Executor>("hades-finalizer")
+              : nullptr},
       promoteYGToOG_{!gcConfig.getAllocInYoung()},
       revertToYGAtTTI_{gcConfig.getRevertToYGAtTTI()},
       overwriteDeadYGObjects_{gcConfig.getOverwriteDeadYGObjects()},
+      pretenure_{gcConfig.getPretenure()},
+      ygPauseTargetMs_{gcConfig.getYoungGenPauseTargetMs()},
       occupancyTarget_(gcConfig.getOccupancyTarget()),
       ygAverageSurvivalBytes_{
           /*weight*/ 0.5,
           /*init*/ kYGInitialSizeFactor * HeapSegment::maxSize() *
-              kYGInitialSurvivalRatio} {
+              kYGInitialSurvivalRatio},
+      ygEvacuationRate_{/*weight*/ 0.5, /*init*/ kYGInitialEvacuationRate},
+      ygSurvivalRatio_{/*weight*/ 0.5, /*init*/ kYGInitialSurvivalRatio} {
   (void)vmExperimentFlags;
   std::lock_guard<Mutex> lk(gcMutex_);
   crashMgr_->setCustomData("HermesGC", getKindAsStr().c_str());
@@ -1460,6 +2026,31 @@ void HadesGC::printStats(JSONEmitter &json) {
   json.emitKey("stats");
   json.openDict();
   json.emitKeyValue("Num compactions", numCompactions_);
+  json.emitKeyValue(
+      "Num fragmentation compactions", numFragmentationCompactions_);
+  json.emitKeyValue("OG fragmentation", oldGenFragmentation());
+  if (ygEvacWorkers_) {
+    json.emitKeyValue("YG threads", ygEvacWorkers_->numWorkers());
+    // The fraction of the time the workers were available for that was spent
+    // doing work. 1 means the dirty card scans were perfectly balanced.
+    const double efficiency = ygParallelAvailableTime_.count()
+        ? static_cast<double>(ygParallelBusyTime_.count()) /
+            ygParallelAvailableTime_.count()
+        : 0;
+    json.emitKeyValue("YG parallel efficiency", efficiency);
+  }
+  if (ogWorkers_) {
+    json.emitKeyValue("OG mark threads", ogWorkers_->numWorkers());
+    const double efficiency = ogParallelAvailableTime_.count()
+        ? static_cast<double>(ogParallelBusyTime_.count()) /
+            ogParallelAvailableTime_.count()
+        : 0;
+    json.emitKeyValue("OG mark parallel efficiency", efficiency);
+  }
+  if (pretenure_)
+    json.emitKeyValue("Pretenured bytes", pretenuredBytes_);
+  if (finalizerExecutor_)
+    json.emitKeyValue("Num deferred finalizers", numDeferredFinalizers_);
   json.closeDict();
   json.closeDict();
 }
@@ -1737,17 +2328,49 @@ void HadesGC::prepareCompactee(bool forceCompaction) {
       oldGen_.targetSizeBytes() / 20, HeapSegment::maxSize());
   uint64_t threshold = oldGen_.targetSizeBytes() + buffer;
   uint64_t totalBytes = oldGen_.size() + oldGen_.externalBytes();
-  if ((forceCompaction || totalBytes > threshold) &&
-      oldGen_.numSegments() > 1) {
-    compactee_.segment = std::make_shared<HeapSegment>(oldGen_.popSegment());
-    addSegmentExtentToCrashManager(
-        *compactee_.segment, kCompacteeNameForCrashMgr);
-    compactee_.start = compactee_.segment->lowLim();
-    compactee_.startCP = CompressedPointer::encodeNonNull(
-        reinterpret_cast<GCCell *>(compactee_.segment->lowLim()),
-        getPointerBase());
-    compacteeHandleForSweep_ = compactee_.segment;
-  }
+  if (oldGen_.numSegments() <= 1)
+    return;
+  // Compact the segment with the least live data, since it is the cheapest to
+  // evacuate.
+  const size_t segIdx = oldGen_.sparsestSegment();
+  const bool overTarget = forceCompaction || totalBytes > threshold;
+  if (!overTarget && !shouldCompactForFragmentation(segIdx))
+    return;
+  if (!overTarget)
+    numFragmentationCompactions_++;
+  oldGen_.moveSegmentToBack(segIdx);
+  compactee_.segment = std::make_shared<HeapSegment>(oldGen_.popSegment());
+  addSegmentExtentToCrashManager(
+      *compactee_.segment, kCompacteeNameForCrashMgr);
+  compactee_.start = compactee_.segment->lowLim();
+  compactee_.startCP = CompressedPointer::encodeNonNull(
+      reinterpret_cast<GCCell *>(compactee_.segment->lowLim()),
+      getPointerBase());
+  compacteeHandleForSweep_ = compactee_.segment;
+}
+
+double HadesGC::oldGenFragmentation() const {
+  const uint64_t capacity = oldGen_.numSegments() * HeapSegment::maxSize();
+  if (!capacity)
+    return 0;
+  return 1.0 - static_cast<double>(oldGen_.sweptLiveBytes()) / capacity;
+}
+
+bool HadesGC::shouldCompactForFragmentation(size_t segIdx) const {
+  // Only compact when a sizeable fraction of the OG is free, and the
+  // evacuation is cheap enough to fit in a YG pause.
+  constexpr double kFragmentationThreshold = 0.3;
+  constexpr uint64_t kMaxEvacuatedBytes = HeapSegment::maxSize() / 2;
+  const uint64_t liveBytes = oldGen_.segmentLiveBytes(segIdx);
+  if (oldGenFragmentation() < kFragmentationThreshold ||
+      liveBytes > kMaxEvacuatedBytes)
+    return false;
+  // The compaction only saves memory if the live objects fit in the free
+  // space of the other segments, instead of requiring a new segment.
+  const uint64_t capacity = oldGen_.numSegments() * HeapSegment::maxSize();
+  const uint64_t freeBytes = capacity - oldGen_.sweptLiveBytes();
+  const uint64_t compacteeFreeBytes = HeapSegment::maxSize() - liveBytes;
+  return freeBytes >= compacteeFreeBytes + liveBytes;
 }
 
 void HadesGC::finalizeCompactee() {
@@ -1881,6 +2504,14 @@ void HadesGC::finalizeAll() {
   std::lock_guard<Mutex> lk{gcMutex_};
   // Terminate any existing OG collection.
   concurrentPhase_ = Phase::None;
+  // Finish any deferred finalizers, and run the remaining finalizers
+  // synchronously, so that all native resources are released before the heap
+  // is destroyed.
+  if (finalizerExecutor_) {
+    flushDeferredFinalizers();
+    finalizerExecutor_->add([] {}).wait();
+    finalizerExecutor_.reset();
+  }
   if (ogCollectionStats_)
     ogCollectionStats_->markUsed();
   // In case of an OOM, we may be in the middle of a YG collection.
@@ -1908,6 +2539,28 @@ void HadesGC::finalizeAll() {
     seg.forAllObjs(finalizeCallback);
 }
 
+void HadesGC::deferFinalization(DeferredFinalizer fn, void *arg) {
+  if (!finalizerExecutor_) {
+    fn(arg);
+    return;
+  }
+  deferredFinalizers_.emplace_back(fn, arg);
+}
+
+void HadesGC::flushDeferredFinalizers() {
+  if (deferredFinalizers_.empty())
+    return;
+  numDeferredFinalizers_ += deferredFinalizers_.size();
+  // The returned future does not need to be waited on, finalizeAll will drain
+  // the executor before the heap is destroyed.
+  finalizerExecutor_->add(
+      [finalizers = std::move(deferredFinalizers_)]() {
+        for (const auto &[fn, arg] : finalizers)
+          fn(arg);
+      });
+  deferredFinalizers_.clear();
+}
+
 void HadesGC::creditExternalMemory(GCCell *cell, uint32_t sz) {
   assert(canAllocExternalMemory(sz) && "Precondition");
   if (inYoungGen(cell)) {
@@ -2223,6 +2876,17 @@ GCCell *HadesGC::OldGen::alloc(uint32_t sz) {
   if (GCCell *cell = search(sz)) {
     return cell;
   }
+  // If a sweep is in progress, the segments that have not been swept yet may
+  // have dead objects in them. Sweep them on demand before growing the heap.
+  // Promotions during a YG collection skip this, to avoid running finalizers
+  // in the middle of evacuation.
+  if (gc_.concurrentPhase_ == Phase::Sweep && !gc_.inGC()) {
+    while (sweepSegmentsRemaining()) {
+      sweepNext(/* backgroundThread */ false);
+      if (GCCell *cell = search(sz))
+        return cell;
+    }
+  }
   // Before waiting for a collection to finish, check if we're below the max
   // heap size and can simply allocate another segment. This will prevent
   // blocking the YG unnecessarily.
@@ -2293,6 +2957,8 @@ GCCell *HadesGC::OldGen::search(uint32_t sz) {
           "Size bucket should be an exact match");
       return finishAlloc(cell, sz);
     }
+    if (GCCell *cell = allocFromCache(sz))
+      return cell;
     // Make sure we start searching at the smallest possible size that could fit
     bucket = getFreelistBucket(sz + minAllocationSize());
   }
@@ -2365,7 +3031,8 @@ GCCell *HadesGC::OldGen::search(uint32_t sz) {
       segBucket = segBucket->next;
     } while (segBucket);
   }
-  return nullptr;
+  // The only free cell large enough may be the one held by the cache.
+  return carveFromAllocCache(sz);
 }
 
 template <typename Acceptor>
@@ -2510,7 +3177,7 @@ void HadesGC::youngGenCollection(
     // incremental OG collections, since they distort pause times and are
     // unaffected by YG size.
     if (!doCompaction)
-      updateYoungGenSizeFactor();
+      updateYoungGenSizeFactor(heapBytes.before, heapBytes.after);
 
     // The effective end of our YG is no longer accurate for multiple reasons:
     // 1. transferExternalMemoryToOldGen resets the effectiveEnd to be the end.
@@ -2537,6 +3204,8 @@ void HadesGC::youngGenCollection(
       ygAverageSurvivalBytes_.update(
           ygCollectionStats_->afterAllocatedBytes() +
           ygCollectionStats_->afterExternalBytes());
+    updatePretenuring();
+    flushDeferredFinalizers();
   }
 #ifdef HERMES_SLOW_DEBUG
   // Check that the card tables are well-formed after the collection.
@@ -2589,6 +3258,38 @@ void HadesGC::youngGenCollection(
   ygCollectionStats_.reset();
 }
 
+void HadesGC::recordPromotion(const GCCell *cell, uint32_t sz) {
+  const int idx = pretenureIndex(cell->getKind());
+  if (idx >= 0)
+    pretenureFeedback_[idx].promotedBytes += sz;
+}
+
+void HadesGC::updatePretenuring() {
+  if (!pretenure_)
+    return;
+  // Only decide once enough has been allocated for the survival rate to be
+  // meaningful.
+  constexpr uint64_t kMinSampleBytes = 64 * 1024;
+  constexpr double kSurvivalThreshold = 0.9;
+  // Pretenured kinds are periodically allocated in the YG again, in case the
+  // program moved on to a phase where they die young.
+  constexpr uint32_t kCollectionsUntilResample = 32;
+  for (PretenureFeedback &feedback : pretenureFeedback_) {
+    if (feedback.collectionsUntilResample) {
+      --feedback.collectionsUntilResample;
+      continue;
+    }
+    if (feedback.allocatedBytes < kMinSampleBytes)
+      continue;
+    const double survivalRate =
+        static_cast<double>(feedback.promotedBytes) / feedback.allocatedBytes;
+    if (survivalRate >= kSurvivalThreshold)
+      feedback.collectionsUntilResample = kCollectionsUntilResample;
+    feedback.allocatedBytes = 0;
+    feedback.promotedBytes = 0;
+  }
+}
+
 bool HadesGC::promoteYoungGenToOldGen() {
   if (!promoteYGToOG_) {
     return false;
@@ -2661,9 +3362,31 @@ void HadesGC::transferExternalMemoryToOldGen() {
   youngGen_.clearExternalMemoryCharge();
 }
 
-void HadesGC::updateYoungGenSizeFactor() {
+void HadesGC::updateYoungGenSizeFactor(
+    uint64_t ygUsedBytes,
+    uint64_t evacuatedBytes) {
   assert(
       ygSizeFactor_ <= 1.0 && ygSizeFactor_ >= 0.25 && "YG size out of range.");
+  if (ygPauseTargetMs_) {
+    const double ygDurationMs =
+        ygCollectionStats_->getElapsedTimeMicros().count() / 1000.0;
+    // Collections that evacuate nothing say nothing about the rate.
+    if (evacuatedBytes && ygDurationMs > 0)
+      ygEvacuationRate_.update(evacuatedBytes / ygDurationMs);
+    if (ygUsedBytes)
+      ygSurvivalRatio_.update(static_cast<double>(evacuatedBytes) / ygUsedBytes);
+    // The pause is dominated by evacuating the survivors, so pick the YG size
+    // whose expected survivors can be evacuated within the target. Fixed costs
+    // like scanning roots are folded into the measured rate.
+    const double targetBytes = ygPauseTargetMs_ * ygEvacuationRate_ /
+        std::max<double>(ygSurvivalRatio_, 0.01);
+    ygSizeFactor_ =
+        std::clamp(targetBytes / HeapSegment::maxSize(), 0.25, 1.0);
+    // Record the decision in the analytics event for this collection.
+    ygCollectionStats_->addCollectionType(
+        "yg-size:" + std::to_string(std::lround(ygSizeFactor_ * 100)));
+    return;
+  }
   const auto ygDuration = ygCollectionStats_->getElapsedTime().count();
   // If the YG collection has taken less than 20% of our budgeted time, increase
   // the size of the YG by 10%.
@@ -2676,16 +3399,19 @@ void HadesGC::updateYoungGenSizeFactor() {
     ygSizeFactor_ = std::max(ygSizeFactor_ * 0.9, 0.25);
 }
 
-template <bool CompactionEnabled>
+template <bool CompactionEnabled, typename Acceptor>
 void HadesGC::scanDirtyCardsForSegment(
-    SlotVisitor<EvacAcceptor<CompactionEnabled>> &visitor,
-    HeapSegment &seg) {
+    SlotVisitor<Acceptor> &visitor,
+    HeapSegment &seg,
+    size_t fromCard,
+    size_t toCard) {
   const auto &cardTable = seg.cardTable();
   // Use level instead of end in case the OG segment is still in bump alloc
   // mode.
   const char *const origSegLevel = seg.level();
-  size_t from = cardTable.addressToIndex(seg.start());
-  const size_t to = cardTable.addressToIndex(origSegLevel - 1) + 1;
+  size_t from = std::max(cardTable.addressToIndex(seg.start()), fromCard);
+  const size_t to =
+      std::min(cardTable.addressToIndex(origSegLevel - 1) + 1, toCard);
 
   // If a compaction is taking place during sweeping, we may scan cards that
   // contain dead objects which in turn point to dead objects in the compactee.
@@ -2758,6 +3484,10 @@ void HadesGC::scanDirtyCardsForSegment(
 
 template <bool CompactionEnabled>
 void HadesGC::scanDirtyCards(EvacAcceptor<CompactionEnabled> &acceptor) {
+  if (ygEvacWorkers_) {
+    scanDirtyCardsParallel(acceptor);
+    return;
+  }
   SlotVisitor<EvacAcceptor<CompactionEnabled>> visitor{acceptor};
   const bool preparingCompaction =
       CompactionEnabled && !compactee_.evacActive();
@@ -2772,7 +3502,7 @@ void HadesGC::scanDirtyCards(EvacAcceptor<CompactionEnabled> &acceptor) {
     // It is safe to hold this reference across a push_back into
     // oldGen_.segments_ since references into a deque are not invalidated.
     HeapSegment &seg = oldGen_[i];
-    scanDirtyCardsForSegment(visitor, seg);
+    scanDirtyCardsForSegment<CompactionEnabled>(visitor, seg);
     // Do not clear the card table if the OG thread is currently marking to
     // prepare for a compaction. Note that we should clear the card tables if
     // the compaction is currently ongoing.
@@ -2783,7 +3513,75 @@ void HadesGC::scanDirtyCards(EvacAcceptor<CompactionEnabled> &acceptor) {
   // No need to search dirty cards in the compactee segment if it is
   // currently being evacuated, since it will be scanned fully.
   if (preparingCompaction)
-    scanDirtyCardsForSegment(visitor, *compactee_.segment);
+    scanDirtyCardsForSegment<CompactionEnabled>(visitor, *compactee_.segment);
+}
+
+template <bool CompactionEnabled>
+void HadesGC::scanDirtyCardsParallel(
+    EvacAcceptor<CompactionEnabled> &acceptor) {
+  using Recorder = DirtySlotRecorder<CompactionEnabled>;
+  const bool preparingCompaction =
+      CompactionEnabled && !compactee_.evacActive();
+
+  // Split each segment into chunks of cards that the workers claim one at a
+  // time. This keeps the workers busy even when the dirty cards are
+  // concentrated in a few segments.
+  constexpr size_t kCardsPerChunk = 256;
+  struct Chunk {
+    HeapSegment *seg;
+    size_t fromCard;
+    size_t toCard;
+  };
+  std::vector<Chunk> chunks;
+  auto addChunks = [&chunks](HeapSegment &seg) {
+    const auto &cardTable = seg.cardTable();
+    const size_t to = cardTable.addressToIndex(seg.level() - 1) + 1;
+    for (size_t from = cardTable.addressToIndex(seg.start()); from < to;
+         from += kCardsPerChunk)
+      chunks.push_back({&seg, from, std::min(from + kCardsPerChunk, to)});
+  };
+  const auto segEnd = oldGen_.numSegments();
+  for (size_t i = 0; i < segEnd; ++i)
+    addChunks(oldGen_[i]);
+  // No need to search dirty cards in the compactee segment if it is
+  // currently being evacuated, since it will be scanned fully.
+  if (preparingCompaction)
+    addChunks(*compactee_.segment);
+
+  // The workers only read the heap, so they do not need to synchronize with
+  // each other beyond claiming chunks.
+  std::atomic<size_t> nextChunk{0};
+  const auto start = std::chrono::steady_clock::now();
+  const auto busyTime = ygEvacWorkers_->run([&](unsigned worker) {
+    Recorder recorder{*this, ygEvacWorkers_->slots(worker)};
+    SlotVisitor<Recorder> visitor{recorder};
+    for (size_t i = nextChunk.fetch_add(1, std::memory_order_relaxed);
+         i < chunks.size();
+         i = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+      const Chunk &chunk = chunks[i];
+      scanDirtyCardsForSegment<CompactionEnabled>(
+          visitor, *chunk.seg, chunk.fromCard, chunk.toCard);
+    }
+  });
+  ygParallelBusyTime_ += busyTime;
+  ygParallelAvailableTime_ += (std::chrono::steady_clock::now() - start) *
+      ygEvacWorkers_->numWorkers();
+
+  // Do not clear the card table if the OG thread is currently marking to
+  // prepare for a compaction. Note that we should clear the card tables if
+  // the compaction is currently ongoing.
+  if (!preparingCompaction) {
+    for (size_t i = 0; i < segEnd; ++i)
+      oldGen_[i].cardTable().clear();
+  }
+
+  // Evacuating the recorded slots may allocate new OG segments, which is why
+  // it has to happen on this thread, after the workers are done.
+  for (unsigned i = 0; i < ygEvacWorkers_->numWorkers(); ++i) {
+    auto &slots = ygEvacWorkers_->slots(i);
+    Recorder::apply(acceptor, slots);
+    slots.clear();
+  }
 }
 
 void HadesGC::finalizeYoungGenObjects() {
@@ -2974,6 +3772,8 @@ void HadesGC::OldGen::addSegment(HeapSegment seg) {
   segments_.emplace_back(std::move(seg));
   HeapSegment &newSeg = segments_.back();
   incrementAllocatedBytes(newSeg.used());
+  // Until the segment is swept, conservatively treat it as full.
+  segmentLiveBytes_.push_back(newSeg.maxSize());
   // Add a set of freelist buckets for this segment.
   segmentBuckets_.emplace_back();
 
@@ -2994,6 +3794,7 @@ void HadesGC::OldGen::addSegment(HeapSegment seg) {
 }
 
 HadesGC::HeapSegment HadesGC::OldGen::popSegment() {
+  flushAllocCache();
   const auto &segBuckets = segmentBuckets_.back();
   for (size_t bucket = 0; bucket < kNumFreelistBuckets; ++bucket) {
     if (segBuckets[bucket].head) {
@@ -3002,12 +3803,53 @@ HadesGC::HeapSegment HadesGC::OldGen::popSegment() {
     }
   }
   segmentBuckets_.pop_back();
+  segmentLiveBytes_.pop_back();
 
   auto oldSeg = std::move(segments_.back());
   segments_.pop_back();
   return oldSeg;
 }
 
+size_t HadesGC::OldGen::sparsestSegment() const {
+  assert(!segmentLiveBytes_.empty() && "No segments to choose from");
+  return std::min_element(segmentLiveBytes_.begin(), segmentLiveBytes_.end()) -
+      segmentLiveBytes_.begin();
+}
+
+uint64_t HadesGC::OldGen::segmentLiveBytes(size_t segIdx) const {
+  return segmentLiveBytes_[segIdx];
+}
+
+uint64_t HadesGC::OldGen::sweptLiveBytes() const {
+  return std::accumulate(
+      segmentLiveBytes_.begin(), segmentLiveBytes_.end(), uint64_t{0});
+}
+
+void HadesGC::OldGen::moveSegmentToBack(size_t segIdx) {
+  const size_t lastIdx = segments_.size() - 1;
+  if (segIdx == lastIdx)
+    return;
+  flushAllocCache();
+  // The segment level freelists are linked by address, so take both sets of
+  // buckets out of them while they are swapped.
+  for (size_t idx : {segIdx, lastIdx}) {
+    for (auto &segBucket : segmentBuckets_[idx]) {
+      if (segBucket.head)
+        segBucket.removeFromFreelist();
+    }
+  }
+  std::swap(segments_[segIdx], segments_[lastIdx]);
+  std::swap(segmentBuckets_[segIdx], segmentBuckets_[lastIdx]);
+  std::swap(segmentLiveBytes_[segIdx], segmentLiveBytes_[lastIdx]);
+  for (size_t idx : {segIdx, lastIdx}) {
+    for (size_t bucket = 0; bucket < kNumFreelistBuckets; ++bucket) {
+      auto &segBucket = segmentBuckets_[idx][bucket];
+      if (segBucket.head)
+        segBucket.addToFreelist(&buckets_[bucket]);
+    }
+  }
+}
+
 void HadesGC::OldGen::setTargetSizeBytes(size_t targetSizeBytes) {
   assert(gc_.gcMutex_ && "Must hold gcMutex_ when accessing targetSizeBytes_.");
   assert(!targetSizeBytes_ && "Should only initialise targetSizeBytes_ once.");
@@ -190,6 +190,42 @@ enum class GCEventKind {
   /* Whether to use mprotect on GC metadata between GCs. */              \
   F(constexpr, bool, ProtectMetadata, false)                             \
                                                                          \
+  /* Number of threads (including the collecting thread) that search */  \
+  /* for old-to-young pointers during a young gen collection. A value */ \
+  /* of 1 keeps young gen collections single threaded. */                \
+  F(constexpr, unsigned, YoungGenThreads, 1)                             \
+                                                                         \
+  /* Number of threads (including the collecting thread) that mark */    \
+  /* and sweep the old gen during a concurrent collection. A value of */ \
+  /* 1 keeps old gen collections single threaded. */                     \
+  F(constexpr, unsigned, OldGenThreads, 1)                               \
+                                                                         \
+  /* Whether to allocate array backing stores directly in the old gen */ \
+  /* while most of them survive their first young gen collection. */     \
+  F(constexpr, bool, Pretenure, false)                                   \
+                                                                         \
+  /* Whether to reserve the heap up front and back its segments with */  \
+  /* transparent huge pages, where the OS supports them. */              \
+  F(constexpr, bool, HugePages, false)                                   \
+                                                                         \
+  /* Whether to place the memory of each heap segment on the NUMA */     \
+  /* node of the thread that creates it, where the OS supports it. */    \
+  F(constexpr, bool, NUMALocalSegments, false)                           \
+                                                                         \
+  /* Maximum number of free segments kept in a pool shared by all */     \
+  /* runtimes in the process, to make creating runtimes cheaper. A */    \
+  /* value of 0 disables the pool. */                                    \
+  F(constexpr, unsigned, SegmentPoolSize, 0)                             \
+                                                                         \
+  /* If non-zero, size the young gen so that young gen collections */    \
+  /* take about this many milliseconds, based on the measured */         \
+  /* evacuation and survival rates. */                                   \
+  F(constexpr, unsigned, YoungGenPauseTargetMs, 0)                       \
+                                                                         \
+  /* Whether finalizers may defer releasing native resources to a */     \
+  /* background thread, to keep that work out of collection pauses. */   \
+  F(constexpr, bool, ConcurrentFinalization, false)                      \
+                                                                         \
   /* Callout for an analytics event. */                                  \
   F(HERMES_NON_CONSTEXPR,                                                \
     std::function<void(const GCAnalyticsEvent &)>,                       \
@@ -12,6 +12,7 @@
 #include "hermes/Public/CtorConfig.h"
 #include "hermes/Public/GCConfig.h"
 
+#include <cstdint>
 #include <memory>
 
 namespace hermes {
@@ -122,6 +123,11 @@ class PinnedHermesValue;
                                                                        \
   /* The flags passed from a VM experiment */                          \
   F(constexpr, uint32_t, VMExperimentFlags, 0)                         \
+                                                                       \
+  /* Maximum number of frames recorded in the stack trace of an */     \
+  /* Error. Lower values make throwing cheaper in deep stacks; 0 */    \
+  /* skips walking the stack entirely. */                              \
+  F(constexpr, uint32_t, ErrorStackTraceLimit, UINT32_MAX)             \
   /* RUNTIME_FIELDS END */
 
 _HERMES_CTORCONFIG_STRUCT(RuntimeConfig, RUNTIME_FIELDS, {});
@@ -50,8 +50,9 @@ function foo(a) {
 //CHECK-NEXT:{{.*}} Throw 0<Reg8>
 
 //CHECK-LABEL: Exception Handlers:
-//CHECK-NEXT: 0: start = 15, end = 22, target = 24
-//CHECK-NEXT: 1: start = 7, end = 11, target = 13
-//CHECK-NEXT: 2: start = 15, end = 30, target = 43
-//CHECK-NEXT: 3: start = 7, end = 37, target = 51
-//CHECK-NEXT: 4: start = 43, end = 51, target = 51
+//CHECK-NEXT: 0: start = 7, end = 11, target = 13
+//CHECK-NEXT: 1: start = 11, end = 15, target = 51
+//CHECK-NEXT: 2: start = 15, end = 22, target = 24
+//CHECK-NEXT: 3: start = 22, end = 30, target = 43
+//CHECK-NEXT: 4: start = 30, end = 37, target = 51
+//CHECK-NEXT: 5: start = 43, end = 51, target = 51
@@ -117,7 +117,7 @@ var obj4 = {
 // IRGEN-NEXT:function_end
 
 // BCGEN:Bytecode File Information:
-// BCGEN-NEXT:  Bytecode version number: 90
+// BCGEN-NEXT:  Bytecode version number: 93
 // BCGEN-NEXT:  Source hash: 0000000000000000000000000000000000000000
 // BCGEN-NEXT:  Function count: 2
 // BCGEN-NEXT:  String count: 24
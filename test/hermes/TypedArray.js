@@ -1061,6 +1061,41 @@ cons.forEach(function(ta) {
   assert.equal(1 / x[1], +Infinity);
 })();
 
+(function defaultSort() {
+  // Large enough to use the radix sort for integers.
+  cons.forEach(function(ta) {
+    var x = new ta(1000);
+    for (var i = 0; i < x.length; i++) {
+      x[i] = ((i * 7919) % 1000) - 500;
+    }
+    var expected = Array.from(x).sort(function(a, b) {
+      return a - b;
+    });
+    x.sort();
+    assert.arrayEqual(Array.from(x), expected);
+  });
+
+  // NaN goes last, and -0 before +0.
+  [Float32Array, Float64Array].forEach(function(ta) {
+    var x = new ta(300);
+    for (var i = 0; i < x.length; i++) {
+      x[i] = [NaN, -0, 0, i, -i][i % 5];
+    }
+    x.sort();
+    for (var i = 0; i < 60; i++) {
+      assert.equal(x[i], -299 + i * 5);
+      assert.equal(1 / x[60 + i], -Infinity);
+      assert.equal(1 / x[120 + i], +Infinity);
+      assert.equal(x[180 + i], 3 + i * 5);
+      assert.ok(isNaN(x[240 + i]));
+    }
+  });
+
+  var x = new BigInt64Array([3n, -(2n ** 63n), 0n, -1n]);
+  x.sort();
+  assert.arrayEqual(Array.from(x), [-(2n ** 63n), -1n, 0n, 3n]);
+})();
+
 /// @}
 
 /// @name TypedArray.prototype.set
@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('array-sort-timsort');
+//CHECK-LABEL: array-sort-timsort
+
+var seed = 42;
+function random() {
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return seed;
+}
+
+// Sort pairs by value with a counting comparator, and check that the result
+// is ordered and stable.
+function check(values) {
+  var pairs = values.map(function (v, i) {
+    return {v: v, i: i};
+  });
+  var calls = 0;
+  pairs.sort(function (x, y) {
+    ++calls;
+    return x.v - y.v;
+  });
+  for (var i = 1; i < pairs.length; ++i) {
+    var prev = pairs[i - 1], cur = pairs[i];
+    if (prev.v > cur.v || (prev.v === cur.v && prev.i > cur.i))
+      return 'unsorted at ' + i;
+  }
+  return calls;
+}
+
+function make(n, f) {
+  var a = [];
+  for (var i = 0; i < n; ++i) a.push(f(i));
+  return a;
+}
+
+var sizes = [0, 1, 2, 5, 31, 32, 33, 64, 100, 1000, 10000, 100000];
+print(sizes.map(function (n) {
+  return typeof check(make(n, function () {
+    return random() % (n / 4 + 1);
+  }));
+}).join());
+//CHECK-NEXT: number,number,number,number,number,number,number,number,number,number,number,number
+
+// Runs need a single comparison per element.
+print(check(make(100000, function (i) { return i; })));
+//CHECK-NEXT: 99999
+print(check(make(100000, function (i) { return -i; })));
+//CHECK-NEXT: 99999
+print(check(make(100000, function (i) { return i % 2 ? 0 : 1; })) > 0);
+//CHECK-NEXT: true
+print(check(make(100000, function (i) {
+  return i % 1000 === 0 ? random() % 100000 : i;
+})) < 200000);
+//CHECK-NEXT: true
+print(check(make(100000, function (i) { return i % 5000; })) < 600000);
+//CHECK-NEXT: true
+
+// An inconsistent comparator still leaves every element in the array.
+var a = make(50000, function (i) { return i; });
+a.sort(function () {
+  return (random() % 3) - 1;
+});
+print(check(a.slice()) > 0, a.slice().sort(function (x, y) {
+  return x - y;
+}).every(function (v, i) {
+  return v === i;
+}));
+//CHECK-NEXT: true true
+
+// Undefined values and holes go to the end, holes last.
+var h = [3, , undefined, 1, , 2, undefined];
+h.sort();
+print(JSON.stringify(h), h.length, Object.keys(h).join());
+//CHECK-NEXT: [1,2,3,null,null,null,null] 7 0,1,2,3,4
+h = [3, , undefined, 1, , 2];
+h.sort(function (x, y) {
+  return y - x;
+});
+print(Object.keys(h).join(), h.join());
+//CHECK-NEXT: 0,1,2,3 3,2,1,,,
+
+// The default comparison is by string.
+print([10, 9, 1, 100, 'b', 'a', true, null].sort().join());
+//CHECK-NEXT: 1,10,100,9,a,b,,true
+
+// A comparator that throws leaves the array as it was.
+var t = [3, 2, 1];
+try {
+  t.sort(function () {
+    throw new Error('stop');
+  });
+} catch (e) {
+  print(e.message, t.join());
+}
+//CHECK-NEXT: stop 3,2,1
+
+// Array-likes, and values inherited from the prototype.
+var o = {length: 5, 0: 'e', 1: 'd', 3: 'b', 4: undefined};
+Array.prototype.sort.call(o);
+print(JSON.stringify(o));
+//CHECK-NEXT: {"0":"b","1":"d","2":"e","length":5}
+Array.prototype[1] = 'p';
+var p = [5, , 1];
+p.sort();
+print(JSON.stringify(p), p.hasOwnProperty(2));
+//CHECK-NEXT: [1,5,"p"] true
+delete Array.prototype[1];
+
+// Every element is read once before any comparison, and written once after.
+var log = [];
+var proxy = new Proxy([2, , 1, undefined], {
+  has: function (target, key) {
+    log.push('has' + key);
+    return key in target;
+  },
+  get: function (target, key) {
+    if (key !== 'length') log.push('get' + key);
+    return target[key];
+  },
+  set: function (target, key, v) {
+    log.push('set' + key + '=' + v);
+    target[key] = v;
+    return true;
+  },
+  deleteProperty: function (target, key) {
+    log.push('delete' + key);
+    return delete target[key];
+  },
+});
+Array.prototype.sort.call(proxy, function (x, y) {
+  log.push('cmp');
+  return x - y;
+});
+print(log.join());
+//CHECK-NEXT: has0,get0,has1,has2,get2,has3,get3,cmp,set0=1,set1=2,set2=undefined,delete3
+
+// Sparse arrays.
+var big = [];
+big[5] = 1;
+big[100000] = 0;
+big.sort();
+print(big.length, big[0], big[1], 2 in big);
+//CHECK-NEXT: 100001 0 1 false
@@ -0,0 +1,41 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -Xerror-stack-trace-limit=2 %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xerror-stack-trace-limit=0 %s | %FileCheck --match-full-lines --check-prefix=CHKNONE %s
+
+print('error stack trace limit');
+// CHECK-LABEL: error stack trace limit
+// CHKNONE-LABEL: error stack trace limit
+
+function c() {
+  throw new Error('deep');
+}
+function b() {
+  c();
+}
+function a() {
+  b();
+}
+
+try {
+  a();
+} catch (e) {
+  print(e.stack);
+}
+// CHECK-NEXT: Error: deep
+// CHECK-NEXT:     at c ({{.*}})
+// CHECK-NEXT:     at b ({{.*}})
+// CHKNONE-NEXT: Error: deep
+
+try {
+  a();
+} catch (e) {
+  print('caught', e.message);
+}
+// CHECK-NEXT: caught deep
+// CHKNONE-NEXT: caught deep
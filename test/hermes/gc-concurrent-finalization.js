@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -gc-concurrent-finalization %s | %FileCheck --match-full-lines %s
+
+// Create many short lived array buffers and regexps, whose native memory is
+// released by deferred finalizers, while keeping some of them alive.
+var kept = [];
+for (var i = 0; i < 20000; ++i) {
+  var buf = new ArrayBuffer(1024 + (i % 64));
+  new Uint8Array(buf)[0] = i & 0xff;
+  var re = new RegExp('a' + (i % 100) + 'b+');
+  if (i % 1000 === 0)
+    kept.push({buf: buf, re: re});
+}
+gc();
+
+var sum = 0;
+for (var i = 0; i < kept.length; ++i) {
+  var k = kept[i];
+  sum += new Uint8Array(k.buf)[0] + k.buf.byteLength;
+  if (!k.re.test('a' + ((i * 1000) % 100) + 'bbb'))
+    throw new Error('Bad regexp at ' + i);
+}
+print(sum);
+// CHECK: 23648
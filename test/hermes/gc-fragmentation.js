@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -gc-init-heap=32M -gc-max-heap=64M %s | %FileCheck --match-full-lines %s
+
+// Fill several OG segments with objects, then drop most of them, so that the
+// OG is fragmented and the sparsest segments get compacted.
+var objs = [];
+for (var i = 0; i < 200000; ++i) {
+  objs.push({index: i, s: 'o' + i});
+}
+gc();
+
+var kept = [];
+for (var i = 0; i < objs.length; i += 20) {
+  kept.push(objs[i]);
+}
+objs = null;
+
+// Allocate garbage to drive several OG collections while the survivors move.
+for (var round = 0; round < 10; ++round) {
+  for (var j = 0; j < 50000; ++j) {
+    var garbage = {j: j, a: [j]};
+  }
+  gc();
+}
+
+var sum = 0;
+for (var i = 0; i < kept.length; ++i) {
+  var o = kept[i];
+  if (o.index !== i * 20 || o.s !== 'o' + i * 20)
+    throw new Error('Bad object at ' + i);
+  sum += o.index;
+}
+print(sum);
+// CHECK: 999900000
@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -gc-og-threads=4 -gc-init-heap=12M %s | %FileCheck --match-full-lines %s
+
+// Build a large, deep and wide old gen graph, then keep mutating it while
+// old gen collections mark and sweep it, so that several threads share the
+// work.
+function makeTree(depth) {
+  if (depth === 0)
+    return {leaf: true, s: 'leaf'};
+  return {left: makeTree(depth - 1), right: makeTree(depth - 1), depth: depth};
+}
+
+function countLeaves(t) {
+  return t.leaf ? 1 : countLeaves(t.left) + countLeaves(t.right);
+}
+
+var trees = [];
+var list = null;
+for (var round = 0; round < 10; ++round) {
+  trees.push(makeTree(12));
+  for (var i = 0; i < 5000; ++i) {
+    list = {next: list, value: i};
+  }
+  // Replace an old subtree while marking may be in progress.
+  trees[round >> 1].left = makeTree(8);
+  gc();
+}
+
+var leaves = 0;
+for (var i = 0; i < trees.length; ++i) {
+  leaves += countLeaves(trees[i]);
+}
+var len = 0;
+for (var l = list; l; l = l.next) {
+  ++len;
+}
+print(leaves, len);
+// CHECK: 32000 50000
+
+// Objects with finalizers that die in the old gen, so that sweeping several
+// segments at once has to finalize them.
+var buffers = [];
+var total = 0;
+for (var round = 0; round < 10; ++round) {
+  for (var i = 0; i < 2000; ++i) {
+    buffers[i] = new ArrayBuffer(64 + (i % 7));
+    total += buffers[i].byteLength;
+  }
+  gc();
+}
+print(total);
+// CHECK-NEXT: 1339950
@@ -0,0 +1,39 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -gc-pretenure -gc-init-heap=12M %s | %FileCheck --match-full-lines %s
+
+// Arrays whose backing stores all survive, so that they get pretenured, with
+// young objects stored into them afterwards.
+var kept = [];
+for (var i = 0; i < 100000; ++i) {
+  var a = [i, i + 1, i + 2, i + 3];
+  kept.push(a);
+}
+for (var i = 0; i < kept.length; ++i) {
+  kept[i].push({value: i});
+}
+// Allocate garbage so that the young objects have to be found through the
+// old backing stores.
+for (var j = 0; j < 100000; ++j) {
+  var garbage = {j: j};
+}
+var sum = 0;
+for (var i = 0; i < kept.length; ++i) {
+  var a = kept[i];
+  sum += a[0] + a[3] + a[4].value;
+}
+print(sum);
+// CHECK: 15000150000
+
+// Arrays that die young, allocated after the pretenured ones.
+var last;
+for (var i = 0; i < 200000; ++i) {
+  last = [i, i];
+}
+print(last[0] + last[1]);
+// CHECK-NEXT: 399998
@@ -0,0 +1,24 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -gc-yg-pause-target-ms=1 -gc-print-stats %s 2>&1 | %FileCheck %s
+
+// Allocate a mix of short and long lived objects, so that the young gen is
+// resized from the measured evacuation and survival rates.
+var kept = [];
+for (var i = 0; i < 300000; ++i) {
+  var o = {index: i, s: 'x' + i};
+  if (i % 10 === 0)
+    kept.push(o);
+}
+var sum = 0;
+for (var i = 0; i < kept.length; ++i)
+  sum += kept[i].index;
+print(sum);
+// CHECK: 4499850000
+// CHECK: "collectionType": "young"
+// CHECK: "yg-size:{{[0-9]+}}"
@@ -0,0 +1,35 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O -gc-yg-threads=4 -gc-init-heap=12M %s | %FileCheck --match-full-lines %s
+
+// Old objects that are repeatedly pointed at young objects, so that YG
+// collections have to find the young objects through dirty cards.
+var olds = [];
+for (var i = 0; i < 2000; ++i) {
+  olds.push({young: null, index: i});
+}
+gc();
+
+var sum = 0;
+for (var round = 0; round < 20; ++round) {
+  for (var i = 0; i < olds.length; ++i) {
+    olds[i].young = {value: round * i, s: 'x' + i};
+  }
+  // Allocate enough garbage to trigger several YG collections.
+  for (var j = 0; j < 20000; ++j) {
+    var garbage = [j, j + 1, {j: j}];
+  }
+  for (var i = 0; i < olds.length; ++i) {
+    var y = olds[i].young;
+    if (y.value !== round * i || y.s !== 'x' + i)
+      throw new Error('Bad young object at ' + i);
+    sum += y.value;
+  }
+}
+print(sum);
+// CHECK: 379810000
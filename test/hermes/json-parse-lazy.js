@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('json-parse-lazy');
+//CHECK-LABEL: json-parse-lazy
+
+// Objects are only parsed lazily in documents large enough to be kept as
+// external strings, so pad every document.
+var pad = 'x'.repeat(300);
+function parse(text) {
+  return HermesInternal.jsonParseLazy(text);
+}
+
+var src = JSON.stringify({
+  pad: pad,
+  a: 1,
+  b: {c: [1, {d: 'e'}, [], {}], f: null},
+  '5': 'five',
+  s: 'café \u{1F600}',
+});
+var o = parse(src);
+print(o.a, o.b.c[1].d, o.b.c.length, o[5], o.b.f, o.s);
+//CHECK-NEXT: 1 e 4 five null café 😀
+print(JSON.stringify(o) === src);
+//CHECK-NEXT: true
+print(Object.keys(o).join());
+//CHECK-NEXT: 5,pad,a,b,s
+print(Object.keys(o.b.c[3]).length, Array.isArray(o.b.c[2]));
+//CHECK-NEXT: 0 true
+print(Object.prototype.toString.call(parse(src).b));
+//CHECK-NEXT: [object Object]
+
+// for-in must see the properties of an object that hasn't been used yet.
+var keys = [];
+for (var k in parse(src).b) keys.push(k);
+print(keys.join());
+//CHECK-NEXT: c,f
+
+// Operations on an untouched object.
+o = parse(src);
+print('a' in o, o.hasOwnProperty('z'), delete o.a, 'a' in o);
+//CHECK-NEXT: true false true false
+o = parse(src);
+Object.freeze(o.b);
+o.b.g = 1;
+print(Object.isFrozen(o.b), o.b.g, Object.keys(o.b).join());
+//CHECK-NEXT: true undefined c,f
+o = parse(src);
+o.b.f = 2;
+o.b.x = 3;
+print(JSON.stringify(o.b));
+//CHECK-NEXT: {"c":[1,{"d":"e"},[],{}],"f":2,"x":3}
+print(Object.getOwnPropertyNames(parse(src)).length);
+//CHECK-NEXT: 5
+
+// Duplicate keys, escapes and nested objects at the end of the document.
+o = parse('{"p":"' + pad + '","k":1,"k":{"\\u0041":{"z":[{"y":2}]}}}');
+print(JSON.stringify(o.k), o.k.A.z[0].y);
+//CHECK-NEXT: {"A":{"z":[{"y":2}]}} 2
+
+// Non-object roots and small documents.
+print(parse('[{"a":1},"' + pad + '"]')[0].a, parse('{"a":2}').a, parse('3'));
+//CHECK-NEXT: 1 2 3
+
+// The whole document is validated up front.
+try {
+  parse('{"pad":"' + pad + '","a":{"b":}}');
+} catch (e) {
+  print(e.name);
+}
+//CHECK-NEXT: SyntaxError
+try {
+  parse('{"pad":"' + pad + '"} x');
+} catch (e) {
+  print(e.name);
+}
+//CHECK-NEXT: SyntaxError
@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// jsonStringifyToFd writes directly to stdout, ahead of the buffered output
+// of print().
+var n = HermesInternal.jsonStringifyToFd(
+  1, {a: [1, 'é\u{1F600}'], u: undefined});
+print();
+//CHECK: {"a":[1,"é😀"]}
+
+print(n);
+//CHECK-NEXT: 18
+print(HermesInternal.jsonStringifyToFd(1, undefined));
+//CHECK-NEXT: undefined
+
+function utf8ToString(buf) {
+  return decodeURIComponent(
+    escape(String.fromCharCode.apply(null, new Uint8Array(buf))));
+}
+
+var buf = HermesInternal.jsonStringifyToArrayBuffer(
+  {a: [1, 'é'], b: {}}, null, 1);
+print(buf.byteLength, JSON.stringify(utf8ToString(buf)));
+//CHECK-NEXT: 36 "{\n \"a\": [\n  1,\n  \"é\"\n ],\n \"b\": {}\n}"
+print(HermesInternal.jsonStringifyToArrayBuffer(function() {}));
+//CHECK-NEXT: undefined
+
+// Output is flushed in chunks while serializing large values.
+var big = [];
+for (var i = 0; i < 20000; ++i)
+  big.push({i: i, s: 'é\u{1F600}' + i, u: undefined, f: function() {}});
+var expected = JSON.stringify(big);
+var res = utf8ToString(HermesInternal.jsonStringifyToArrayBuffer(big));
+print(res.length === expected.length, res === expected);
+//CHECK-NEXT: true true
+
+try {
+  HermesInternal.jsonStringifyToFd(-1, {});
+} catch (e) {
+  print(e.name);
+}
+//CHECK-NEXT: TypeError
@@ -394,6 +394,36 @@ var o = JSON.parse(add(s, t));
 print(JSON.stringify(o));
 //CHECK-NEXT: {"a":{"c":1},"b":{"d":2}}
 
+// Sibling objects with shared, diverging, duplicate and index-like keys.
+var o = JSON.parse(
+  '[{"x":1,"y":2,"z":3},{"x":4,"y":5,"z":6},{"x":7,"z":8,"y":9},' +
+  '{"x":1,"x":2,"y":3},{"x":1,"0":2,"y":3},{"x":1,"y":2,"z":3,"w":4},{}]');
+for (var i = 0; i < o.length; ++i)
+  print(Object.keys(o[i]).join(), JSON.stringify(o[i]));
+//CHECK-NEXT: x,y,z {"x":1,"y":2,"z":3}
+//CHECK-NEXT: x,y,z {"x":4,"y":5,"z":6}
+//CHECK-NEXT: x,z,y {"x":7,"z":8,"y":9}
+//CHECK-NEXT: x,y {"x":2,"y":3}
+//CHECK-NEXT: 0,x,y {"0":2,"x":1,"y":3}
+//CHECK-NEXT: x,y,z,w {"x":1,"y":2,"z":3,"w":4}
+//CHECK-NEXT: {}
+
+// Quotes, escapes and control characters at every offset of long strings.
+var ok = true;
+for (var i = 0; i < 40; ++i) {
+  var pad = 'abcdefghijklmnopqrstuvwxyz0123456789ABCD'.slice(0, i);
+  var str = pad + '"\\\u0100\n' + pad;
+  if (JSON.parse(JSON.stringify(str)) !== str) ok = false;
+  if (JSON.parse('[' + pad.replace(/./g, ' ') + '"' + pad + '"]')[0] !== pad)
+    ok = false;
+  try {
+    JSON.parse('"' + pad + '\u0001"');
+    ok = false;
+  } catch (e) {}
+}
+print(ok);
+//CHECK-NEXT: true
+
 var obj = { toJSON: function() { return "foo"; } };
 print(JSON.stringify([obj]));
 // CHECK-NEXT: ["foo"]
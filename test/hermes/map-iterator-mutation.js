@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -emit-binary -out %t.hbc %s && %hermes %t.hbc | %FileCheck --match-full-lines %s
+
+print('map-iterator-mutation');
+//CHECK-LABEL: map-iterator-mutation
+
+function range(n) {
+  var a = [];
+  for (var i = 0; i < n; i++) a.push(i);
+  return a;
+}
+
+// Entries added during iteration are visited, even when the table grows.
+var m = new Map([[0, 'a']]);
+var seen = [];
+for (var [k, v] of m) {
+  seen.push(k);
+  if (k < 40) m.set(k + 1, v);
+}
+print(seen.length, seen[0], seen[40], m.size);
+//CHECK-NEXT: 41 0 40 41
+
+// Deleting entries ahead of an iterator skips them; deleting most entries
+// shrinks the table under the iterator.
+var s = new Set(range(100));
+var it = s.values();
+print(it.next().value, it.next().value);
+//CHECK-NEXT: 0 1
+for (var i = 0; i < 95; i++) s.delete(i);
+print(Array.from(it).join());
+//CHECK-NEXT: 95,96,97,98,99
+
+// Deleting behind the iterator and compacting doesn't repeat entries.
+s = new Set(range(8));
+it = s.values();
+for (var i = 0; i < 4; i++) it.next();
+for (var i = 0; i < 4; i++) s.delete(i);
+for (var i = 8; i < 12; i++) s.add(i);
+print(Array.from(it).join(), Array.from(s).join());
+//CHECK-NEXT: 4,5,6,7,8,9,10,11 4,5,6,7,8,9,10,11
+
+// Several iterators at different positions survive the same rebuilds.
+s = new Set(range(20));
+var its = [0, 5, 19, 20].map(function (n) {
+  var it = s.keys();
+  for (var i = 0; i < n; i++) it.next();
+  return it;
+});
+for (var i = 0; i < 20; i += 2) s.delete(i);
+for (var i = 100; i < 200; i++) s.add(i);
+for (var i = 101; i < 200; i++) s.delete(i);
+print(its.map(function (it) { return Array.from(it).join(); }).join(' | '));
+//CHECK-NEXT: 1,3,5,7,9,11,13,15,17,19,100 | 5,7,9,11,13,15,17,19,100 | 19,100 | 100
+
+// Clearing restarts iterators at the entries added afterwards.
+m = new Map([['x', 1], ['y', 2], ['z', 3]]);
+it = m.entries();
+print(it.next().value);
+//CHECK-NEXT: x,1
+m.clear();
+m.set('w', 4);
+print(Array.from(it).join(' '), m.size);
+//CHECK-NEXT: w,4 1
+m.clear();
+print(it.next().done, m.keys().next().done);
+//CHECK-NEXT: true true
+
+// forEach sees the same mutations.
+s = new Set(range(10));
+seen = [];
+s.forEach(function (x) {
+  seen.push(x);
+  if (x === 2) {
+    for (var i = 0; i < 10; i++) s.delete(i);
+    s.add('a');
+  } else if (x === 'a') {
+    s.clear();
+    s.add('b');
+  }
+});
+print(seen.join(), Array.from(s).join());
+//CHECK-NEXT: 0,1,2,a,b b
+
+// Deleted keys can be added again, and go to the end.
+m = new Map();
+for (var i = 0; i < 1000; i++) m.set('k' + i, i);
+for (var i = 0; i < 1000; i += 3) m.delete('k' + i);
+m.set('k0', 'again');
+var keys = Array.from(m.keys());
+print(m.size, keys[0], keys[keys.length - 1], m.get('k0'), m.has('k3'));
+//CHECK-NEXT: 667 k1 k0 again false
+
+// Keys of every type, including ones that are boxed in the table.
+var o = {};
+var big = 2 ** 40;
+m = new Map([[1.5, 'd'], [big, 'b'], [NaN, 'n'], [o, 'o'], [-0, 'z']]);
+for (var i = 0; i < 100; i++) m.set(i + 0.25, i);
+print(m.get(1.5), m.get(big), m.get(NaN), m.get(o), m.get(0), m.size);
+//CHECK-NEXT: d b n o z 105
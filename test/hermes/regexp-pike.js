@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('regexp-pike');
+//CHECK-LABEL: regexp-pike
+
+// Patterns that take exponential time to backtrack.
+var as = 'a'.repeat(5000);
+print(
+  /(a+)+(b|c)/.test(as),
+  /(a|aa)*[cd]/.test(as),
+  /(?:a+a+)+$/.test(as + '!'),
+);
+//CHECK-NEXT: false false false
+print(/^(a|a)*$/.exec(as + 'b'), /(x+x+)+[yz]/.test('x'.repeat(3000)));
+//CHECK-NEXT: null false
+print(/(\w+\s?)+$/.test('word '.repeat(1000) + '!'));
+//CHECK-NEXT: false
+var m = /(a+)+b/.exec(as + 'b');
+print(m.index, m[0].length, m[1].length);
+//CHECK-NEXT: 0 5001 5000
+var re = /(a+)+(b|c)/y;
+re.lastIndex = 1;
+print(re.test('x' + as + 'c'), re.lastIndex, re.test('xx' + as + 'c'));
+//CHECK-NEXT: true 5002 false
+
+// The backtracking executor gives up on the first alternative at the start of
+// the input, so the rest of the regex is run by the Pike VM.
+var pad = '~'.repeat(40);
+function pike(source, flags, input) {
+  var m = new RegExp('(?:~+)+!|' + source, flags).exec(pad + input);
+  return m && m.map(function (s) {
+    return s === undefined ? 'U' : s;
+  });
+}
+
+// Priorities are the same as in backtracking.
+print(pike('(a|ab)(c|bcd)(d*)', '', 'abcd'));
+//CHECK-NEXT: abcd,a,bcd,
+print(pike('(a+?)(a*)', '', 'aaa'), pike('(a*?)b', '', 'aab'));
+//CHECK-NEXT: aaa,a,aa aab,aa
+print(pike('a{2,4}?', '', 'aaaa'), pike('(?:a|b){2,3}c', '', 'ababc'));
+//CHECK-NEXT: aa babc
+print(pike('(?:(a)|b)+', '', 'ab'), pike('(?:(a)|(b))+', '', 'aab'));
+//CHECK-NEXT: ab,U aab,U,b
+print(pike('(z)((a+)?(b+)?(c))*', '', 'zaacbbbcac'));
+//CHECK-NEXT: zaacbbbcac,z,ac,a,U,c
+print(pike('(a|b)*?c', '', 'xxababc'), pike('x(?:y|z)+$', '', 'xyzx xzy'));
+//CHECK-NEXT: ababc,b xzy
+
+// Anchors, word boundaries and flags.
+print(pike('^(?:\\w+\\b\\s*)+$', 'm', '\nab\n!cd ef'));
+//CHECK-NEXT: ab
+print(pike('\\b(?:\\w|-)+\\B', '', 'ab-cd- e'), pike('(?:A|b)+', 'i', 'cAbBa'));
+//CHECK-NEXT: ab-cd- AbBa
+print(JSON.stringify(pike('x(?:.|\\n)+?!', '', 'x\ny!z!')));
+//CHECK-NEXT: ["x\ny!"]
+print(
+  pike('(?:\\u{1F600}|a)+', 'u', 'b😀a😀'),
+  pike('😀(?:.|x)+$', 'u', '😀😀😀'),
+);
+//CHECK-NEXT: 😀a😀 😀😀😀
+print(
+  pike('(?:é|e)+s', 'i', 'ÉEés'),
+  pike('(?:[^~]|a)+', 'u', '\ud83d')[0].length,
+);
+//CHECK-NEXT: ÉEés 1
+print(/(?:a|b)+/y.exec('cab'), 'ab-ba-c-aab'.match(/(?:a|b)+/g));
+//CHECK-NEXT: null ab,ba,aab
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('regexp-prefilter');
+//CHECK-LABEL: regexp-prefilter
+
+var pad = 'xyz '.repeat(100);
+
+// Literal prefixes.
+print(/needle\d/.exec(pad + 'needle needle7' + pad).index);
+//CHECK-NEXT: 407
+print((pad + 'ab1 ab2 ab').match(/ab\d/g).join());
+//CHECK-NEXT: ab1,ab2
+print(/(ab)(c+)d/.exec(pad + 'abccd').slice(1).join());
+//CHECK-NEXT: ab,cc
+print(/needle/.test(pad), /needle/.test(''), /a/.exec('Āa').index);
+//CHECK-NEXT: false false 1
+
+// Sticky regexps only try lastIndex.
+var re = /ab/y;
+re.lastIndex = 1;
+print(re.test('aab'), re.lastIndex, re.test('aab'));
+//CHECK-NEXT: true 3 false
+
+// Sets of first units.
+print(/[qw]\d/.exec(pad + 'q w1').index, /\bfoo|bar/.exec(pad + 'xbar').index);
+//CHECK-NEXT: 402 401
+print(/hello/i.exec(pad + 'HeLLo').index, /(?:cat|dog)s/.exec(pad + 'dogs')[0]);
+//CHECK-NEXT: 400 dogs
+print(/ſx/i.exec(pad + 'Sx ſx').index);
+//CHECK-NEXT: 403
+print(/kx/iu.exec(pad + 'Kx')[0] === 'Kx');
+//CHECK-NEXT: true
+
+// Required substrings.
+print(/\d+px/.exec(pad + '12em 34px')[0], /\d+px/.test(pad + '12em'));
+//CHECK-NEXT: 34px false
+print(/(?:a|b)+end/.exec(pad + 'abaend').index, /\s*end/.test(pad));
+//CHECK-NEXT: 400 false
+
+// Unicode regexps don't match inside surrogate pairs.
+var astral = '😀';
+print(/\ude00/u.exec(astral + '\ude00').index, /\ude00/.exec(astral).index);
+//CHECK-NEXT: 2 1
+print(/x/u.exec(astral.repeat(10) + 'x').index);
+//CHECK-NEXT: 20
+
+// Searches from lastIndex with the global flag.
+re = /o\w/g;
+var s = pad + 'foo boa', all = [];
+for (var m; (m = re.exec(s)); ) all.push(m.index);
+print(all.join());
+//CHECK-NEXT: 401,405
+print((pad + 'a-b-c').replace(/-[bc]/g, '+').slice(400));
+//CHECK-NEXT: a++
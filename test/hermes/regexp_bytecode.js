@@ -13,6 +13,7 @@ print(/a\x01\u017f/i);
 // CHECK: RegExp Bytecodes:
 // CHECK:       0: /a\x01\u017f/i
 // CHECK-NEXT:    Header: marked: 0 loops: 0 flags: 1 constraints: 5
+// CHECK-NEXT:    Prefilter: first of 'Aa'
 // CHECK-NEXT:    0000  MatchCharICase8: 'A'
 // CHECK-NEXT:    0002  MatchCharICase8: 0x01
 // CHECK-NEXT:    0004  MatchCharICase16: 0x17f
@@ -21,6 +22,7 @@ print(/a\x01\u017f/i);
 print(/^a\u017f\x01$/);
 // CHECK:       1: /^a\u017f\x01$/
 // CHECK-NEXT:    Header: marked: 0 loops: 0 flags: 0 constraints: 7
+// CHECK-NEXT:    Prefilter: prefix 'a\u017f\u0001'
 // CHECK-NEXT:    0000  LeftAnchor
 // CHECK-NEXT:    0001  MatchChar8: 'a'
 // CHECK-NEXT:    0003  MatchChar16: 0x17f
@@ -31,6 +33,15 @@ print(/^a\u017f\x01$/);
 print(/^a|b/);
 // CHECK:       2: /^a|b/
 // CHECK-NEXT:    Header: marked: 0 loops: 0 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: first of 'ab'
+// CHECK-NEXT:    0000  Alternation: Target 0x0f, constraints 6,4
+// CHECK-NEXT:    0007  LeftAnchor
+// CHECK-NEXT:    0008  MatchChar8: 'a'
+// CHECK-NEXT:    000a  Jump32: 0x11
+// CHECK-NEXT:    000f  MatchChar8: 'b'
+// CHECK-NEXT:    0011  Goal
+// CHECK-NEXT:    Pike program:
+// CHECK-NEXT:    Header: marked: 0 loops: 0 flags: 0 constraints: 4
 // CHECK-NEXT:    0000  Alternation: Target 0x0f, constraints 6,4
 // CHECK-NEXT:    0007  LeftAnchor
 // CHECK-NEXT:    0008  MatchChar8: 'a'
@@ -50,6 +61,7 @@ print(/[a-z][^A-Z0-9_\d][\s][abc]/);
 print(/a(b(c)(d))e\1\2/);
 // CHECK:       4: /a(b(c)(d))e\1\2/
 // CHECK-NEXT:    Header: marked: 3 loops: 0 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: prefix 'abcde'
 // CHECK-NEXT:    0000  MatchChar8: 'a'
 // CHECK-NEXT:    0002  BeginMarkedSubexpression: 0
 // CHECK-NEXT:    0005  MatchChar8: 'b'
@@ -74,6 +86,7 @@ print(/\b\B/);
 
 print(/abc(?=^)(?!def)/i);
 // CHECK: Header: marked: 0 loops: 0 flags: 1 constraints: 6
+// CHECK-NEXT: Prefilter: first of 'Aa'
 // CHECK-NEXT: 0000  MatchNCharICase8: 'ABC'
 // CHECK-NEXT: 0005  Lookaround: = (constraints: 2, marked expressions=[0,0), continuation 0x13)
 // CHECK-NEXT: 0011  LeftAnchor
@@ -86,6 +99,7 @@ print(/abc(?=^)(?!def)/i);
 print(/ab*c+d{3,5}/);
 // CHECK:        7: /ab*c+d{3,5}/
 // CHECK-NEXT:    Header: marked: 0 loops: 3 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: prefix 'a'
 // CHECK-NEXT:    0000  MatchChar8: 'a'
 // CHECK-NEXT:    0002  Width1Loop: 0 greedy {0, 4294967295}
 // CHECK-NEXT:    0014  MatchChar8: 'b'
@@ -94,10 +108,29 @@ print(/ab*c+d{3,5}/);
 // CHECK-NEXT:    002a  Width1Loop: 2 greedy {3, 5}
 // CHECK-NEXT:    003c  MatchChar8: 'd'
 // CHECK-NEXT:    003e  Goal
+// CHECK-NEXT:    Pike program:
+// CHECK-NEXT:    Header: marked: 0 loops: 0 flags: 0 constraints: 4
+// CHECK-NEXT:    0000  MatchChar8: 'a'
+// CHECK-NEXT:    0002  Alternation: Target 0x10, constraints 0,0
+// CHECK-NEXT:    0009  MatchChar8: 'b'
+// CHECK-NEXT:    000b  Jump32: 0x02
+// CHECK-NEXT:    0010  MatchChar8: 'c'
+// CHECK-NEXT:    0012  Alternation: Target 0x20, constraints 0,0
+// CHECK-NEXT:    0019  MatchChar8: 'c'
+// CHECK-NEXT:    001b  Jump32: 0x12
+// CHECK-NEXT:    0020  MatchChar8: 'd'
+// CHECK-NEXT:    0022  MatchChar8: 'd'
+// CHECK-NEXT:    0024  MatchChar8: 'd'
+// CHECK-NEXT:    0026  Alternation: Target 0x38, constraints 0,0
+// CHECK-NEXT:    002d  MatchChar8: 'd'
+// CHECK-NEXT:    002f  Alternation: Target 0x38, constraints 0,0
+// CHECK-NEXT:    0036  MatchChar8: 'd'
+// CHECK-NEXT:    0038  Goal
 
 print(/a((b+){3})*/);
 // CHECK:        8: /a((b+){3})*/
 // CHECK-NEXT:    Header: marked: 2 loops: 3 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: prefix 'a'
 // CHECK-NEXT:     0000  MatchChar8: 'a'
 // CHECK-NEXT:     0002  BeginLoop: 2 greedy {0, 4294967295} (constraints: 4)
 // CHECK-NEXT:     0019  BeginMarkedSubexpression: 0
@@ -110,10 +143,19 @@ print(/a((b+){3})*/);
 // CHECK-NEXT:     0052  EndMarkedSubexpression: 0
 // CHECK-NEXT:     0055  EndLoop: 0x02
 // CHECK-NEXT:     005a  Goal
+// CHECK-NEXT:    Pike program:
+// CHECK-NEXT:    Header: marked: 2 loops: 0 flags: 0 constraints: 4
+// CHECK-NEXT:    0000  MatchChar8: 'a'
+// CHECK-NEXT:    0002  Alternation: Target 0x6a, constraints 0,0
+// CHECK-NEXT:    0009  ClearCaptures: [0,2)
+// CHECK-NEXT:    000e  BeginMarkedSubexpression: 0
+// CHECK-NEXT:    0011  ClearCaptures: [1,2)
+// CHECK-NEXT:    0016  BeginMarkedSubexpression: 1
 
 print(/(^b)+(c)*?/);
 // CHECK:        9: /(^b)+(c)*?/
 // CHECK-NEXT:    Header: marked: 2 loops: 2 flags: 0 constraints: 6
+// CHECK-NEXT:    Prefilter: prefix 'b'
 // CHECK-NEXT:     0000  BeginLoop: 0 greedy {1, 4294967295} (constraints: 6)
 // CHECK-NEXT:     0017  BeginMarkedSubexpression: 0
 // CHECK-NEXT:     001a  LeftAnchor
@@ -143,6 +185,7 @@ print(/a*/);
 print(/a+/);
 // CHECK:        12: /a+/
 // CHECK-NEXT:    Header: marked: 0 loops: 1 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: prefix 'a'
 // CHECK-NEXT:    0000  Width1Loop: 0 greedy {1, 4294967295}
 // CHECK-NEXT:    0012  MatchChar8: 'a'
 // CHECK-NEXT:    0014  Goal
@@ -189,6 +232,7 @@ print(/a*/i);
 print(/(a)(?=(.))/i);
 // CHECK:        18: /(a)(?=(.))/i
 // CHECK-NEXT:   Header: marked: 2 loops: 0 flags: 1 constraints: 4
+// CHECK-NEXT:   Prefilter: first of 'Aa'
 // CHECK-NEXT:   0000  BeginMarkedSubexpression: 0
 // CHECK-NEXT:   0003  MatchCharICase8: 'A'
 // CHECK-NEXT:   0005  EndMarkedSubexpression: 0
@@ -202,6 +246,7 @@ print(/(a)(?=(.))/i);
 print(/(a)(?<!(.))/i);
 // CHECK:        19: /(a)(?<!(.))/i
 // CHECK-NEXT:   Header: marked: 2 loops: 0 flags: 1 constraints: 4
+// CHECK-NEXT:   Prefilter: first of 'Aa'
 // CHECK-NEXT:   0000  BeginMarkedSubexpression: 0
 // CHECK-NEXT:   0003  MatchCharICase8: 'A'
 // CHECK-NEXT:   0005  EndMarkedSubexpression: 0
@@ -216,6 +261,7 @@ print(/(a)(?<!(.))/i);
 print(/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaoverflow/);
 // CHECK:        20: /{{a{255}overflow}}/
 // CHECK-NEXT:   Header: marked: 0 loops: 0 flags: 0 constraints: 4
+// CHECK-NEXT:   Prefilter: prefix 'aaaaaaaaaaaaaaaa'
 // CHECK-NEXT:   0000  MatchNChar8: {{'a{255}'}}
 // CHECK-NEXT:   0101  MatchNChar8: 'overflow'
 // CHECK-NEXT:   010b  Goal
@@ -223,6 +269,7 @@ print(/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa
 print(/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaoverflow/i);
 // CHECK:        21: /{{a{255}overflow}}/i
 // CHECK-NEXT:   Header: marked: 0 loops: 0 flags: 1 constraints: 4
+// CHECK-NEXT:   Prefilter: first of 'Aa'
 // CHECK-NEXT:   0000  MatchNCharICase8: {{'A{255}'}}
 // CHECK-NEXT:   0101  MatchNCharICase8: 'OVERFLOW'
 // CHECK-NEXT:   010b  Goal
@@ -275,6 +322,7 @@ print(/a|b|c|d|e|f/);
 print(/(abc|def)/);
 // CHECK:       27: /(abc|def)/
 // CHECK-NEXT:    Header: marked: 1 loops: 0 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: first of 'ad'
 // CHECK-NEXT:    0000  BeginMarkedSubexpression: 0
 // CHECK-NEXT:    0003  Alternation: Target 0x14, constraints 4,4
 // CHECK-NEXT:    000a  MatchNChar8: 'abc'
@@ -282,3 +330,42 @@ print(/(abc|def)/);
 // CHECK-NEXT:    0014  MatchNChar8: 'def'
 // CHECK-NEXT:    0019  EndMarkedSubexpression: 0
 // CHECK-NEXT:    001c  Goal
+
+print(/\d+(px|em)?;/);
+// CHECK:       28: /\d+(px|em)?;/
+// CHECK-NEXT:    Header: marked: 1 loops: 2 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: contains ';'
+// CHECK-NEXT:    0000  Width1Loop: 0 greedy {1, 4294967295}
+// CHECK-NEXT:    0012  Bracket: [\d]
+// CHECK-NEXT:    0018  BeginLoop: 1 greedy {0, 1} (constraints: 4)
+// CHECK-NEXT:    002f  BeginMarkedSubexpression: 0
+// CHECK-NEXT:    0032  Alternation: Target 0x42, constraints 4,4
+// CHECK-NEXT:    0039  MatchChar8: 'p'
+// CHECK-NEXT:    003b  MatchChar8: 'x'
+// CHECK-NEXT:    003d  Jump32: 0x46
+// CHECK-NEXT:    0042  MatchChar8: 'e'
+// CHECK-NEXT:    0044  MatchChar8: 'm'
+// CHECK-NEXT:    0046  EndMarkedSubexpression: 0
+// CHECK-NEXT:    0049  EndLoop: 0x18
+// CHECK-NEXT:    004e  MatchChar8: ';'
+// CHECK-NEXT:    0050  Goal
+
+print(/\b[xy]\w*/);
+// CHECK:       29: /\b[xy]\w*/
+// CHECK-NEXT:    Header: marked: 0 loops: 1 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: first of 'xy'
+// CHECK-NEXT:    0000  WordBoundary: \b
+// CHECK-NEXT:    0002  Bracket: [x-y]
+// CHECK-NEXT:    0010  Width1Loop: 0 greedy {0, 4294967295}
+// CHECK-NEXT:    0022  Bracket: [\w]
+// CHECK-NEXT:    0028  Goal
+
+print(/\s*foo\d/);
+// CHECK:       30: /\s*foo\d/
+// CHECK-NEXT:    Header: marked: 0 loops: 1 flags: 0 constraints: 4
+// CHECK-NEXT:    Prefilter: contains 'foo'
+// CHECK-NEXT:    0000  Width1Loop: 0 greedy {0, 4294967295}
+// CHECK-NEXT:    0012  Bracket: [\s]
+// CHECK-NEXT:    0018  MatchNChar8: 'foo'
+// CHECK-NEXT:    001d  Bracket: [\d]
+// CHECK-NEXT:    0023  Goal
@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('string-rope');
+//CHECK-LABEL: string-rope
+
+var chunk = 'abcdefghij'.repeat(10);
+
+// Repeated prepending.
+var s = '';
+for (var i = 0; i < 1000; ++i) s = chunk + s;
+print(s.length, s === chunk.repeat(1000), s.charCodeAt(99999));
+//CHECK-NEXT: 100000 true 106
+
+// Concatenations in a tree shape.
+function tree(depth) {
+  if (depth === 0) return chunk + String(depth);
+  return tree(depth - 1) + tree(depth - 1);
+}
+var t = tree(10);
+print(t.length, t.indexOf('j0a'), t.lastIndexOf('0'), t.slice(100, 103));
+//CHECK-NEXT: 103424 99 103423 0ab
+
+// Deeper than the rope depth limit.
+s = '';
+for (var i = 0; i < 1000; ++i) s = (i & 1 ? chunk : chunk.toUpperCase()) + s;
+print(s.length, s.substring(0, 3), s.substring(99997));
+//CHECK-NEXT: 100000 abc HIJ
+
+// Mixed ASCII and UTF-16 operands.
+var u = 'é世'.repeat(40);
+s = chunk;
+for (var i = 0; i <= 300; ++i) s = (i % 3 ? chunk : u) + s;
+print(s.length, s.charAt(0) === 'é', s.codePointAt(1).toString(16));
+//CHECK-NEXT: 28180 true 4e16
+print(s === s.split('').join(''), s + 'x' > s);
+//CHECK-NEXT: true true
+
+// Ropes can be used as property keys.
+var o = {};
+o[chunk + chunk] = 1;
+print(o[chunk.repeat(2)]);
+//CHECK-NEXT: 1
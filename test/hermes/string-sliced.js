@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('string-sliced');
+//CHECK-LABEL: string-sliced
+
+var text = '';
+for (var i = 0; i < 200; ++i) text += 'token' + i + ' '.repeat(i % 7 + 1);
+text += 'é'.repeat(40) + ' ' + 'end';
+
+// Slices of slices, and slices used as keys.
+var s = text.substring(100, 900);
+var t = s.slice(50, -50).substr(10, 600);
+print(t === text.substr(160, 600), t.length, t.indexOf('token30'));
+//CHECK-NEXT: true 600 155
+var o = {};
+o[t] = 1;
+print(o[text.substr(160, 600)]);
+//CHECK-NEXT: 1
+
+// Split and regexp matches.
+var words = text.split(/ +/);
+print(words.length, words[199], words[200].length, words[201]);
+//CHECK-NEXT: 202 token199 40 end
+var m = /(token1\d\d)( +)(\S+)/.exec(text.slice(500));
+print(m[1], m[2].length, m[3]);
+//CHECK-NEXT: token100 3 token101
+var long = /é+/.exec(text)[0];
+print(long.length, long.charCodeAt(39), long + long === 'é'.repeat(80));
+//CHECK-NEXT: 40 233 true
+
+// Slicing the whole string.
+print(text.slice(0) === text, text.substring(0, text.length).length);
+//CHECK-NEXT: true 2328
@@ -96,12 +96,23 @@ static int executeHBCBytecodeFromCL(
                             .withShouldReleaseUnused(vm::kReleaseUnusedNone)
                             .withAllocInYoung(cl::GCAllocYoung)
                             .withRevertToYGAtTTI(cl::GCRevertToYGAtTTI)
+                            .withYoungGenThreads(cl::GCYoungGenThreads)
+                            .withOldGenThreads(cl::GCOldGenThreads)
+                            .withPretenure(cl::GCPretenure)
+                            .withHugePages(cl::GCHugePages)
+                            .withNUMALocalSegments(cl::GCNUMALocalSegments)
+                            .withSegmentPoolSize(cl::GCSegmentPoolSize)
+                            .withYoungGenPauseTargetMs(
+                                cl::GCYoungGenPauseTargetMs)
+                            .withConcurrentFinalization(
+                                cl::GCConcurrentFinalization)
                             .build())
           .withEnableEval(cl::EnableEval)
           .withVerifyEvalIR(cl::VerifyIR)
           .withOptimizedEval(cl::OptimizedEval)
           .withAsyncBreakCheckInEval(cl::EmitAsyncBreakCheck)
           .withVMExperimentFlags(cl::VMExperimentFlags)
+          .withErrorStackTraceLimit(cl::ErrorStackTraceLimit)
           .withES6Promise(cl::ES6Promise)
           .withES6Proxy(cl::ES6Proxy)
           .withIntl(cl::Intl)
@@ -7,6 +7,7 @@
 
 #include "llvh/Support/raw_ostream.h"
 
+#include "hermes/BCGen/Exceptions.h"
 #include "hermes/BCGen/HBC/BytecodeDataProvider.h"
 #include "hermes/BCGen/HBC/BytecodeDisassembler.h"
 #include "hermes/BCGen/HBC/BytecodeGenerator.h"
@@ -292,7 +293,7 @@ TEST(HBCBytecodeGen, ExceptionTableTest) {
   auto BFG = BytecodeFunctionGenerator::create(BMG, 3);
   BFG->emitMov(1, 2);
   BFG->addExceptionHandler(HBCExceptionHandlerInfo{0, 10, 100});
-  BFG->addExceptionHandler(HBCExceptionHandlerInfo{0, 20, 200});
+  BFG->addExceptionHandler(HBCExceptionHandlerInfo{10, 20, 200});
   BFG->addExceptionHandler(HBCExceptionHandlerInfo{50, 60, 300});
 
   BMG.setEntryPointIndex(BMG.addFunction(F));
@@ -316,6 +317,30 @@ TEST(HBCBytecodeGen, ExceptionTableTest) {
   EXPECT_EQ(bytecode->findCatchTargetOffset(0, 55), 300);
 }
 
+TEST(HBCBytecodeGen, ExceptionTableFlattenTest) {
+  // Two sibling tries nested in an outer try, sorted by decreasing depth.
+  ExceptionEntryList entries;
+  entries.push_back({15, 22, 24, 1});
+  entries.push_back({30, 35, 40, 1});
+  entries.push_back({10, 37, 51, 0});
+  entries.push_back({43, 51, 51, 0});
+
+  auto flat = flattenExceptionHandlers(entries);
+  ASSERT_EQ(flat.size(), 6u);
+  uint32_t expected[][3] = {
+      {10, 15, 51},
+      {15, 22, 24},
+      {22, 30, 51},
+      {30, 35, 40},
+      {35, 37, 51},
+      {43, 51, 51}};
+  for (size_t i = 0; i < flat.size(); ++i) {
+    EXPECT_EQ(flat[i].start, expected[i][0]);
+    EXPECT_EQ(flat[i].end, expected[i][1]);
+    EXPECT_EQ(flat[i].target, expected[i][2]);
+  }
+}
+
 TEST(HBCBytecodeGen, ArrayBufferTest) {
   // Since deserialization of the array buffer now requires a codeblock,
   // the only thing that can be checked at BCGen time is that it uses
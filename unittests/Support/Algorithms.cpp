@@ -10,7 +10,10 @@
 #include "gtest/gtest.h"
 
 #include <array>
+#include <random>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 using namespace hermes;
 
@@ -63,3 +66,38 @@ TEST(Algorithms, Copy) {
   EXPECT_EQ(ptr->x, 18);
   free(ptr);
 }
+
+TEST(Algorithms, PdqSort) {
+  std::mt19937 rng;
+  // Patterns that exercise the insertion sort, the block partitioning, the
+  // partitioning of equal elements and the pattern breaking.
+  for (size_t size : {0, 1, 2, 23, 24, 100, 129, 1000, 10000, 100000}) {
+    std::vector<std::vector<int>> inputs(6, std::vector<int>(size));
+    for (size_t i = 0; i < size; ++i) {
+      inputs[0][i] = rng();
+      inputs[1][i] = rng() % 4;
+      inputs[2][i] = i;
+      inputs[3][i] = size - i;
+      inputs[4][i] = i < size / 2 ? i : size - i;
+      inputs[5][i] = i % 100 ? i : rng();
+    }
+    for (auto &v : inputs) {
+      std::vector<int> expected = v;
+      std::sort(expected.begin(), expected.end());
+      pdqSort(v.begin(), v.end());
+      EXPECT_EQ(expected, v) << "size " << size;
+    }
+  }
+
+  // Non-arithmetic types and custom comparisons.
+  std::vector<std::string> strs;
+  for (int i = 0; i < 1000; ++i)
+    strs.push_back(std::to_string(rng() % 300));
+  std::vector<std::string> expected = strs;
+  auto byLength = [](const std::string &a, const std::string &b) {
+    return a.size() < b.size() || (a.size() == b.size() && a < b);
+  };
+  std::sort(expected.begin(), expected.end(), byLength);
+  pdqSort(strs.begin(), strs.end(), byLength);
+  EXPECT_EQ(expected, strs);
+}
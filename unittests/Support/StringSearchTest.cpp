@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "hermes/Support/StringSearch.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace hermes;
+
+namespace {
+
+char16_t unitValue(char c) {
+  return (unsigned char)c;
+}
+char16_t unitValue(char16_t c) {
+  return c;
+}
+
+/// \return the expected result of findSubstring, computed with std::search.
+template <typename H, typename N>
+OptValue<uint32_t> expectedFirst(const H &hay, const N &needle) {
+  auto it = std::search(
+      hay.begin(), hay.end(), needle.begin(), needle.end(), [](auto a, auto b) {
+        return unitValue(a) == unitValue(b);
+      });
+  if (it == hay.end() && !needle.empty())
+    return llvh::None;
+  return (uint32_t)(it - hay.begin());
+}
+
+/// \return the expected result of findLastSubstring, computed with
+/// std::find_end.
+template <typename H, typename N>
+OptValue<uint32_t> expectedLast(const H &hay, const N &needle) {
+  if (needle.empty())
+    return (uint32_t)hay.size();
+  auto it = std::find_end(
+      hay.begin(), hay.end(), needle.begin(), needle.end(), [](auto a, auto b) {
+        return unitValue(a) == unitValue(b);
+      });
+  if (it == hay.end())
+    return llvh::None;
+  return (uint32_t)(it - hay.begin());
+}
+
+template <typename H, typename N>
+void checkSearch(const H &hay, const N &needle) {
+  llvh::ArrayRef<typename H::value_type> hayRef(hay.data(), hay.size());
+  llvh::ArrayRef<typename N::value_type> needleRef(needle.data(), needle.size());
+  EXPECT_EQ(expectedFirst(hay, needle), findSubstring(hayRef, needleRef));
+  EXPECT_EQ(expectedLast(hay, needle), findLastSubstring(hayRef, needleRef));
+}
+
+TEST(StringSearchTest, Basic) {
+  checkSearch(std::string("hello world"), std::string("o"));
+  checkSearch(std::string("hello world"), std::string("world"));
+  checkSearch(std::string("hello world"), std::string(""));
+  checkSearch(std::string(""), std::string(""));
+  checkSearch(std::string("abc"), std::string("abcd"));
+  checkSearch(std::string("abcabcabd"), std::string("abd"));
+  checkSearch(std::u16string(u"héllo wörld"), std::string("llo"));
+  checkSearch(std::string("hello"), std::u16string(u"lĀ"));
+  checkSearch(std::u16string(u"ĀȀĀ"), std::u16string(u"Ā"));
+}
+
+TEST(StringSearchTest, LongNeedles) {
+  std::string hay(5000, 'a');
+  std::string needle(40, 'a');
+  needle.back() = 'b';
+  checkSearch(hay, needle);
+  hay.replace(3000, needle.size(), needle);
+  checkSearch(hay, needle);
+  hay.replace(4960, needle.size(), needle);
+  checkSearch(hay, needle);
+
+  // Units with the same low byte share a shift table entry.
+  std::u16string hay16(3000, u'š');
+  std::u16string needle16(50, u'ɡ');
+  needle16[10] = u'a';
+  checkSearch(hay16, needle16);
+  hay16.replace(1234, needle16.size(), needle16);
+  checkSearch(hay16, needle16);
+  checkSearch(hay16, std::string(40, 'a'));
+}
+
+TEST(StringSearchTest, Random) {
+  // Small alphabets create many partial matches, which exercise the
+  // verification of the SIMD candidates at every offset.
+  std::mt19937 rng(42);
+  for (int iter = 0; iter < 300; ++iter) {
+    size_t hayLen = rng() % 2000;
+    size_t needleLen = rng() % 70;
+    std::string hay;
+    std::u16string hay16;
+    for (size_t i = 0; i < hayLen; ++i) {
+      char c = 'a' + rng() % 3;
+      hay.push_back(c);
+      hay16.push_back(rng() % 5 ? c : u'š');
+    }
+    std::string needle;
+    std::u16string needle16;
+    size_t at = hayLen > needleLen ? rng() % (hayLen - needleLen + 1) : 0;
+    for (size_t i = 0; i < needleLen; ++i) {
+      char c = at + i < hayLen ? hay[at + i] : 'a';
+      needle.push_back(c);
+      needle16.push_back(at + i < hayLen ? hay16[at + i] : u'a');
+    }
+    checkSearch(hay, needle);
+    checkSearch(hay16, needle16);
+    checkSearch(hay16, needle);
+    checkSearch(hay, needle16);
+  }
+}
+
+TEST(StringSearchTest, FirstOf) {
+  std::mt19937 rng(7);
+  for (int iter = 0; iter < 200; ++iter) {
+    std::string hay;
+    std::u16string hay16;
+    for (size_t i = 0, e = rng() % 300; i < e; ++i) {
+      char c = 'a' + rng() % 8;
+      hay.push_back(c);
+      hay16.push_back(rng() % 5 ? c : u'š');
+    }
+    std::u16string units;
+    for (size_t i = 0, e = rng() % 7; i < e; ++i)
+      units.push_back(rng() % 9 ? 'a' + rng() % 20 : u'š');
+    llvh::ArrayRef<char16_t> unitsRef(units.data(), units.size());
+
+    auto expected = [&](const auto &h) -> OptValue<uint32_t> {
+      auto it = std::find_first_of(
+          h.begin(), h.end(), units.begin(), units.end(), [](auto a, auto b) {
+            return unitValue(a) == unitValue(b);
+          });
+      if (it == h.end())
+        return llvh::None;
+      return (uint32_t)(it - h.begin());
+    };
+    EXPECT_EQ(
+        expected(hay),
+        findFirstOf(llvh::ArrayRef<char>(hay.data(), hay.size()), unitsRef));
+    EXPECT_EQ(
+        expected(hay16),
+        findFirstOf(
+            llvh::ArrayRef<char16_t>(hay16.data(), hay16.size()), unitsRef));
+  }
+}
+
+} // namespace
@@ -144,6 +144,64 @@ TEST(StringTest, IsAllASCIITest) {
   }
 }
 
+TEST(StringTest, IsAllASCIIUTF16Test) {
+  std::u16string str(100, u'a');
+  for (size_t start = 0; start <= str.size(); start += 7) {
+    for (size_t end = start; end <= str.size(); ++end) {
+      EXPECT_TRUE(isAllASCII(str.data() + start, str.data() + end));
+    }
+  }
+  for (char16_t c : {u'\x80', u'\xFF', u'\u0100', u'\u4E16', u'\uFFFF'}) {
+    for (size_t i = 0; i < 40; ++i) {
+      std::u16string notAscii(40, u'\x7F');
+      notAscii[i] = c;
+      EXPECT_FALSE(isAllASCII(notAscii.data(), notAscii.data() + 40));
+      EXPECT_TRUE(isAllASCII(notAscii.data(), notAscii.data() + i));
+    }
+  }
+}
+
+TEST(StringTest, ASCIICaseTest) {
+  std::string str;
+  for (int i = 0; i < 3; ++i)
+    for (int c = 0; c < 128; ++c)
+      str.push_back((char)c);
+  std::string upper, lower;
+  for (char c : str) {
+    upper.push_back('a' <= c && c <= 'z' ? c - 'a' + 'A' : c);
+    lower.push_back('A' <= c && c <= 'Z' ? c - 'A' + 'a' : c);
+  }
+  const char *begin = str.data(), *end = begin + str.size();
+  EXPECT_EQ(begin + 'a', findASCIICaseChange(begin, end, true));
+  EXPECT_EQ(begin + 'A', findASCIICaseChange(begin, end, false));
+  EXPECT_EQ(
+      upper.data() + upper.size(),
+      findASCIICaseChange(upper.data(), upper.data() + upper.size(), true));
+
+  for (size_t start = 0; start < 40; ++start) {
+    std::string out(str.size() - start, '\0');
+    convertASCIICase(begin + start, end, &out[0], true);
+    EXPECT_EQ(upper.substr(start), out);
+    convertASCIICase(begin + start, end, &out[0], false);
+    EXPECT_EQ(lower.substr(start), out);
+  }
+}
+
+TEST(StringTest, ASCIIWhiteSpaceTest) {
+  const std::string space = " \t\n\v\f\r";
+  for (size_t pad = 0; pad < 40; ++pad) {
+    std::string padding;
+    for (size_t i = 0; i < pad; ++i)
+      padding.push_back(space[i % space.size()]);
+    std::string str = padding + "a\x08b\x0E" + padding;
+    const char *begin = str.data(), *end = begin + str.size();
+    EXPECT_EQ(begin + pad, skipASCIIWhiteSpace(begin, end));
+    EXPECT_EQ(end - pad, skipASCIIWhiteSpaceBackward(begin, end));
+    EXPECT_EQ(begin + pad, skipASCIIWhiteSpace(begin, begin + pad));
+    EXPECT_EQ(begin, skipASCIIWhiteSpaceBackward(begin, begin + pad));
+  }
+}
+
 TEST(UTF16StreamTest, EmptyUTF16InputTest) {
   UTF16Stream stream(llvh::ArrayRef<char16_t>{});
   EXPECT_FALSE(stream.hasChar());
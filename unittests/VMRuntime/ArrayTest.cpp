@@ -45,7 +45,7 @@ TEST_F(ArrayTest, CppAPITest) {
 
 // Obtain the value a couple of different ways and check its value.
 #define EXPECT_INDEX_VALUE(value, array, index)                        \
-  EXPECT_EQ(value, array->at(runtime, index).unboxToHV(runtime));      \
+  EXPECT_EQ(value, array->at(runtime, index));                         \
   ASSERT_TRUE(*array->getOwnComputedDescriptor(                        \
       array,                                                           \
       runtime,                                                         \
@@ -178,4 +178,62 @@ TEST_F(ArrayTest, TestLength) {
   EXPECT_CALLRESULT_DOUBLE(
       5.0, JSObject::getNamed_RJS(array, runtime, lengthID));
 }
+
+TEST_F(ArrayTest, TestElementKinds) {
+  using ElementKind = JSArray::ElementKind;
+  auto arrayRes = JSArray::create(runtime, 0, 0);
+  ASSERT_FALSE(isException(arrayRes));
+  auto array = *arrayRes;
+
+  // Arrays created without storage start out packed.
+  ASSERT_EQ(ElementKind::PackedInt32, array->getElementKind(runtime));
+
+  // Appending int32 values keeps the kind.
+  for (int i = 0; i < 10; ++i) {
+    auto value = runtime.makeHandle(HermesValue::encodeDoubleValue(i));
+    JSArray::setElementAt(array, runtime, i, value);
+  }
+  ASSERT_EQ(10u, array->getEndIndex());
+  ASSERT_EQ(ElementKind::PackedInt32, array->getElementKind(runtime));
+  EXPECT_EQ(7.0_hd, array->at(runtime, 7));
+
+  // -0 doesn't fit in an int32, so the elements become doubles.
+  auto negZero = runtime.makeHandle(HermesValue::encodeDoubleValue(-0.0));
+  JSArray::setElementAt(array, runtime, 3, negZero);
+  ASSERT_EQ(ElementKind::PackedDouble, array->getElementKind(runtime));
+  EXPECT_TRUE(std::signbit(array->at(runtime, 3).getNumber()));
+  EXPECT_EQ(7.0_hd, array->at(runtime, 7));
+
+  // The fast path stores numbers in place, but rejects anything else.
+  EXPECT_TRUE(JSArray::trySetPackedElement(*array, runtime, 5, 2.5_hd));
+  EXPECT_EQ(2.5_hd, array->at(runtime, 5));
+  EXPECT_FALSE(JSArray::trySetPackedElement(
+      *array, runtime, 5, HermesValue::encodeUndefinedValue()));
+  EXPECT_FALSE(JSArray::trySetPackedElement(*array, runtime, 10, 1.0_hd));
+
+  // Deleting the last element shrinks the array and keeps it packed.
+  ASSERT_TRUE(*JSObject::deleteComputed(
+      array, runtime, runtime.makeHandle(9.0_hd)));
+  ASSERT_EQ(9u, array->getEndIndex());
+  ASSERT_EQ(ElementKind::PackedDouble, array->getElementKind(runtime));
+
+  // A non-number moves the array to generic storage, keeping the elements.
+  JSArray::setElementAt(
+      array, runtime, 0, runtime.makeHandle(HermesValue::encodeNullValue()));
+  ASSERT_EQ(ElementKind::Generic, array->getElementKind(runtime));
+  EXPECT_TRUE(array->at(runtime, 0).isNull());
+  EXPECT_TRUE(std::signbit(array->at(runtime, 3).getNumber()));
+  EXPECT_EQ(2.5_hd, array->at(runtime, 5));
+  EXPECT_EQ(8.0_hd, array->at(runtime, 8));
+
+  // Leaving a hole also needs generic storage.
+  auto holeyRes = JSArray::create(runtime, 0, 0);
+  ASSERT_FALSE(isException(holeyRes));
+  auto holey = *holeyRes;
+  JSArray::setElementAt(holey, runtime, 0, runtime.makeHandle(1.0_hd));
+  JSArray::setElementAt(holey, runtime, 2, runtime.makeHandle(3.0_hd));
+  ASSERT_EQ(ElementKind::Generic, holey->getElementKind(runtime));
+  EXPECT_TRUE(holey->at(runtime, 1).isEmpty());
+  EXPECT_EQ(3.0_hd, holey->at(runtime, 2));
+}
 } // namespace
@@ -1048,6 +1048,118 @@ TEST_F(JSLibTest, HugeSortTest) {
   ASSERT_EQ(ExecutionStatus::RETURNED, quickSort(&rl, 0, 1000 * 1000));
 }
 
+TEST_F(JSLibTest, TimSortTest) {
+  // Compare numbers by their value divided by 2^20, so the low bits can tag
+  // each value with its original index.
+  struct ByHigh : public SortComparator {
+    uint32_t calls = 0;
+    uint32_t throwAt = UINT32_MAX;
+    Runtime &runtime;
+    ByHigh(Runtime &runtime) : runtime(runtime) {}
+    CallResult<int> compare(Handle<> a, Handle<> b) override {
+      if (++calls == throwAt)
+        return runtime.raiseTypeError("compare failed");
+      return (int)(a->getNumber() / (1 << 20)) -
+          (int)(b->getNumber() / (1 << 20));
+    }
+  };
+
+  auto makeValues = [this](const std::vector<uint32_t> &keys) {
+    auto res = SegmentedArray::create(runtime, keys.size(), keys.size());
+    EXPECT_EQ(ExecutionStatus::RETURNED, res.getStatus());
+    auto values = runtime.makeHandle(std::move(*res));
+    for (uint32_t i = 0; i < keys.size(); ++i)
+      values->setNonPtr(
+          runtime,
+          i,
+          HermesValue::encodeNumberValue((double)keys[i] * (1 << 20) + i));
+    return values;
+  };
+  auto checkSorted = [this](Handle<SegmentedArray> values) {
+    for (uint32_t i = 1; i < values->size(runtime); ++i) {
+      auto prev = (uint64_t)values->at(runtime, i - 1).getNumber();
+      auto cur = (uint64_t)values->at(runtime, i).getNumber();
+      // If equivalent, then lower index should come first.
+      ASSERT_LT(prev, cur);
+    }
+  };
+
+  std::mt19937_64 rng;
+  const uint32_t size = 100 * 1000;
+  std::vector<uint32_t> keys(size);
+
+  // Random keys, each equivalent to 9 others.
+  for (uint32_t i = 0; i < size; ++i)
+    keys[i] = i / 10;
+  std::shuffle(keys.begin(), keys.end(), rng);
+  {
+    GCScopeMarkerRAII marker{runtime};
+    ByHigh cmp{runtime};
+    auto values = makeValues(keys);
+    ASSERT_EQ(ExecutionStatus::RETURNED, timSort(runtime, &cmp, values));
+    checkSorted(values);
+  }
+
+  // Ascending and descending runs need a comparison per value.
+  for (bool descending : {false, true}) {
+    GCScopeMarkerRAII marker{runtime};
+    for (uint32_t i = 0; i < size; ++i)
+      keys[i] = descending ? size - i : i;
+    ByHigh cmp{runtime};
+    auto values = makeValues(keys);
+    ASSERT_EQ(ExecutionStatus::RETURNED, timSort(runtime, &cmp, values));
+    checkSorted(values);
+    EXPECT_EQ(size - 1, cmp.calls);
+  }
+
+  // Sorted blocks, which are merged with galloping.
+  for (uint32_t i = 0; i < size; ++i)
+    keys[i] = (i % 1000) * 1000 + i / 1000;
+  {
+    GCScopeMarkerRAII marker{runtime};
+    ByHigh cmp{runtime};
+    auto values = makeValues(keys);
+    ASSERT_EQ(ExecutionStatus::RETURNED, timSort(runtime, &cmp, values));
+    checkSorted(values);
+    EXPECT_GT(size * 10, cmp.calls);
+  }
+
+  // An exception stops the sort.
+  {
+    GCScopeMarkerRAII marker{runtime};
+    ByHigh cmp{runtime};
+    cmp.throwAt = 1000;
+    auto values = makeValues(keys);
+    ASSERT_EQ(ExecutionStatus::EXCEPTION, timSort(runtime, &cmp, values));
+    EXPECT_EQ(1000u, cmp.calls);
+    runtime.clearThrownValue();
+  }
+
+  // Ensure sorting returns without exception and keeps all the values even
+  // if "compare" is inconsistent.
+  struct RandomCompare : public SortComparator {
+    std::mt19937_64 rng;
+    CallResult<int> compare(Handle<> a, Handle<> b) override {
+      // -1, 0, or 1
+      return ((int)(rng() % 3)) - 1;
+    }
+  };
+  for (uint32_t i = 0; i < size; ++i)
+    keys[i] = i;
+  {
+    GCScopeMarkerRAII marker{runtime};
+    RandomCompare rc;
+    auto values = makeValues(keys);
+    ASSERT_EQ(ExecutionStatus::RETURNED, timSort(runtime, &rc, values));
+    std::vector<double> sorted;
+    for (uint32_t i = 0; i < size; ++i)
+      sorted.push_back(values->at(runtime, i).getNumber());
+    std::sort(sorted.begin(), sorted.end());
+    for (uint32_t i = 0; i < size; ++i)
+      ASSERT_EQ((double)i * (1 << 20) + i, sorted[i]);
+  }
+}
+
 class JSLibMockedEnvironmentTest : public RuntimeTestFixtureBase {
  public:
   JSLibMockedEnvironmentTest()
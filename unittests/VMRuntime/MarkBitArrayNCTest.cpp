@@ -15,8 +15,10 @@
 #include "hermes/VM/StorageProvider.h"
 #include "llvh/Support/MathExtras.h"
 
+#include <atomic>
 #include <ios>
 #include <queue>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -94,6 +96,38 @@ TEST_F(MarkBitArrayNCTest, MarkGet) {
   }
 }
 
+TEST_F(MarkBitArrayNCTest, MarkAtomic) {
+  for (char *addr : addrs) {
+    size_t ind = mba->addressToIndex(addr);
+    EXPECT_TRUE(mba->markAtomic(ind)) << "first mark " << ind;
+    EXPECT_TRUE(mba->at(ind)) << "mark " << ind;
+    EXPECT_FALSE(mba->markAtomic(ind)) << "second mark " << ind;
+  }
+
+  mba->clear();
+}
+
+TEST_F(MarkBitArrayNCTest, MarkAtomicConcurrent) {
+  // Threads marking interleaved bits share every word of the array, so any
+  // lost update would leave a bit unmarked.
+  constexpr unsigned kNumThreads = 4;
+  constexpr size_t kNumBitsToMark = 1 << 12;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> numMarked{0};
+  for (unsigned t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([this, t, &numMarked] {
+      for (size_t i = t; i < kNumBitsToMark; i += kNumThreads)
+        numMarked += mba->markAtomic(i) + mba->markAtomic(i ^ 1);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(kNumBitsToMark, numMarked.load());
+  EXPECT_EQ(kNumBitsToMark, mba->findNextUnmarkedBitFrom(0));
+  mba->clear();
+}
+
 TEST_F(MarkBitArrayNCTest, Initial) {
   for (char *addr : addrs) {
     size_t ind = mba->addressToIndex(addr);
@@ -14,6 +14,8 @@
 
 #include "llvh/ADT/STLExtras.h"
 
+#include <cstring>
+
 using namespace hermes;
 using namespace hermes::vm;
 
@@ -181,6 +183,66 @@ TEST(StorageProviderTest, StorageProviderAllocsCount) {
   EXPECT_EQ(LIM, provider->numDeletedAllocs());
 }
 
+TEST(StorageProviderTest, ContiguousVAProviderWithHints) {
+  constexpr size_t LIM = 3;
+  auto provider = StorageProvider::contiguousVAProvider(
+      AlignedStorage::size() * LIM, /* hugePages */ true, /* numaLocal */ true);
+
+  void *storages[LIM];
+  for (size_t i = 0; i < LIM; ++i) {
+    auto result = provider->newStorage("Hinted");
+    ASSERT_TRUE(result);
+    storages[i] = result.get();
+    // The hints must not affect the usability of the memory.
+    memset(storages[i], 0xab, AlignedStorage::size());
+  }
+  EXPECT_FALSE(provider->newStorage("Hinted"));
+
+  // Storage that is deleted and reused should still be zero-filled.
+  provider->deleteStorage(storages[0]);
+  auto result = provider->newStorage("Hinted");
+  ASSERT_TRUE(result);
+  storages[0] = result.get();
+  EXPECT_EQ(0, static_cast<char *>(storages[0])[0]);
+
+  for (auto s : storages) {
+    provider->deleteStorage(s);
+  }
+  EXPECT_EQ(0, provider->numLiveAllocs());
+}
+
+TEST(StorageProviderTest, PooledProviderSharesStorage) {
+  auto first = StorageProvider::pooledProvider(1);
+  auto second = StorageProvider::pooledProvider(1);
+
+  auto result = first->newStorage("Pooled");
+  ASSERT_TRUE(result);
+  void *storage = result.get();
+  memset(storage, 0xab, AlignedStorage::size());
+  first->deleteStorage(storage);
+
+  // The storage deleted by the first provider is reused by the second.
+  result = second->newStorage("Pooled");
+  ASSERT_TRUE(result);
+  EXPECT_EQ(storage, result.get());
+  // Pooled storage must still be writable.
+  memset(storage, 0xcd, AlignedStorage::size());
+
+  // A provider with no pool capacity frees storage instead of pooling it.
+  auto unpooled = StorageProvider::pooledProvider(0);
+  auto other = unpooled->newStorage("Pooled");
+  ASSERT_TRUE(other);
+  unpooled->deleteStorage(other.get());
+  second->deleteStorage(storage);
+
+  // Drain the pool through the provider that doesn't pool, so that it doesn't
+  // affect other tests.
+  result = unpooled->newStorage("Pooled");
+  ASSERT_TRUE(result);
+  EXPECT_EQ(storage, result.get());
+  unpooled->deleteStorage(result.get());
+}
+
 /// StorageGuard will free storage on scope exit.
 class StorageGuard final {
  public:
@@ -328,4 +328,100 @@ TEST_F(StringPrimTest, FastConcatTest) {
   EXPECT_TRUE(utf16Ref.size() == utfStr3.size());
   EXPECT_TRUE(std::equal(utfStr3.begin(), utfStr3.end(), utf16Ref.begin()));
 }
+
+TEST_F(StringPrimTest, RopeConcatTest) {
+  CallResult<HermesValue> cr{ExecutionStatus::EXCEPTION};
+  std::string bigStrA(300, 'a');
+  std::string bigStrB(100, 'b');
+
+  //=======================================
+  // Prepending a long string creates a rope.
+  auto a = StringPrimitive::createNoThrow(runtime, bigStrA);
+  auto b = StringPrimitive::createNoThrow(runtime, bigStrB);
+  cr = StringPrimitive::concat(runtime, b, a);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope_1 = runtime.makeHandle<RopeASCIIStringPrimitive>(*cr);
+  EXPECT_FALSE(rope_1->isFlat());
+
+  cr = StringPrimitive::concat(runtime, b, rope_1);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope_2 = runtime.makeHandle<RopeASCIIStringPrimitive>(*cr);
+
+  // Reading the characters doesn't flatten the operands.
+  std::string asciiStr = bigStrB + bigStrB + bigStrA;
+  auto asciiRef = rope_2->getStringRef<char>();
+  EXPECT_TRUE(asciiRef.size() == asciiStr.size());
+  EXPECT_TRUE(std::equal(asciiStr.begin(), asciiStr.end(), asciiRef.begin()));
+  EXPECT_TRUE(rope_2->isFlat());
+  EXPECT_FALSE(rope_1->isFlat());
+
+  //=======================================
+  // UTF16 + ASCII rope
+  std::u16string strC(300, u'\u1234');
+  auto c = StringPrimitive::createNoThrow(
+      runtime, UTF16Ref(strC.data(), strC.size()));
+  cr = StringPrimitive::concat(runtime, c, rope_1);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto rope_3 = runtime.makeHandle<RopeUTF16StringPrimitive>(*cr);
+  auto flat = StringPrimitive::ensureFlat(runtime, rope_3);
+  EXPECT_TRUE(flat->isFlat());
+
+  std::u16string utfStr = strC;
+  utfStr.append(bigStrB.begin(), bigStrB.end());
+  utfStr.append(bigStrA.begin(), bigStrA.end());
+  auto utf16Ref = flat->getStringRef<char16_t>();
+  EXPECT_TRUE(utf16Ref.size() == utfStr.size());
+  EXPECT_TRUE(std::equal(utfStr.begin(), utfStr.end(), utf16Ref.begin()));
+
+  //=======================================
+  // Short right operands keep using the concatenation buffer.
+  auto small = StringPrimitive::createNoThrow(runtime, "small");
+  cr = StringPrimitive::concat(runtime, rope_1, small);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_TRUE(vmisa<BufferedASCIIStringPrimitive>(*cr));
+}
+
+TEST_F(StringPrimTest, SliceTest) {
+  CallResult<HermesValue> cr{ExecutionStatus::EXCEPTION};
+  std::string strA;
+  for (int i = 0; i < 100; ++i)
+    strA.push_back('a' + i % 26);
+
+  //=======================================
+  // Long slices share the characters of the original string.
+  auto a = StringPrimitive::createNoThrow(runtime, strA);
+  cr = StringPrimitive::slice(runtime, a, 10, 50);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto slice_1 = runtime.makeHandle<SlicedASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(*a, slice_1->getParent());
+  EXPECT_TRUE(slice_1->getStringRef<char>() == ASCIIRef(strA.data(), strA.size()).slice(10, 50));
+
+  // A slice of a slice refers to the original string.
+  cr = StringPrimitive::slice(runtime, slice_1, 5, 40);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto slice_2 = runtime.makeHandle<SlicedASCIIStringPrimitive>(*cr);
+  EXPECT_EQ(*a, slice_2->getParent());
+  EXPECT_EQ(15u, slice_2->getOffset());
+  EXPECT_TRUE(slice_2->getStringRef<char>() == ASCIIRef(strA.data(), strA.size()).slice(15, 40));
+
+  // Short slices are copied.
+  cr = StringPrimitive::slice(runtime, slice_2, 1, 3);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  EXPECT_TRUE(vmisa<DynamicASCIIStringPrimitive>(*cr));
+  EXPECT_TRUE(vmcast<StringPrimitive>(*cr)->getStringRef<char>() == ASCIIRef("qrs", 3));
+
+  //=======================================
+  // UTF16
+  std::u16string strB(100, u'\u1234');
+  strB[60] = u'x';
+  auto b = StringPrimitive::createNoThrow(
+      runtime, UTF16Ref(strB.data(), strB.size()));
+  cr = StringPrimitive::slice(runtime, b, 30, 40);
+  ASSERT_NE(ExecutionStatus::EXCEPTION, cr);
+  auto slice_3 = runtime.makeHandle<SlicedUTF16StringPrimitive>(*cr);
+  EXPECT_EQ(u'x', slice_3->at(30));
+  EXPECT_TRUE(
+      slice_3->getStringRef<char16_t>() ==
+      UTF16Ref(strB.data(), strB.size()).slice(30, 40));
+}
 } // namespace